@@ -22,12 +22,34 @@ packagesExist(codec2) {
     message("Codec2 support disabled.")
 }
 
+# check if libFLAC is available for FLAC audio recordings
+packagesExist(flac) {
+    message("FLAC recording enabled.")
+    PKGCONFIG += flac
+    DEFINES += ENABLE_FLAC
+} else {
+    message("FLAC recording disabled.")
+}
+
+# optional OpenGL spectrum/waterfall plotter, not built unless asked for
+# with "qmake CONFIG+=opengl_plotter" as it is still experimental
+opengl_plotter:if(contains(QT_CONFIG, opengl) | contains(QT_CONFIG, opengles2)) {
+    message("OpenGL plotter enabled.")
+    DEFINES += ENABLE_OPENGL
+    SOURCES += gui/glplotter.cpp
+    HEADERS += gui/glplotter.h
+} else {
+    message("OpenGL plotter disabled.")
+}
+
 SOURCES += \
     gui/mainwindow.cpp \
     gui/main.cpp \
     gui/ipeditwidget.cpp \
     gui/editnetdlg.cpp \
     gui/sounddlg.cpp \
+    gui/displaydlg.cpp \
+    gui/channelizerdlg.cpp \
     gui/freqctrl.cpp \
     gui/sliderctrl.cpp \
     gui/meter.cpp \
@@ -40,9 +62,21 @@ SOURCES += \
     dsp/G726.cpp \
     dsp/G711.cpp \
     dsp/fir.cpp \
+    dsp/vectorops.cpp \
+    dsp/fft.cpp \
+    dsp/iqdemod.cpp \
+    dsp/channelizer.cpp \
+    dsp/interpolatex6.cpp \
+    dsp/decimateby6.cpp \
     interface/soundout.cpp \
     interface/netio.cpp \
+    interface/ascpframer.cpp \
+    interface/txctrlqueue.cpp \
     interface/sdrinterface.cpp \
+    interface/rxchannel.cpp \
+    interface/iqspectrum.cpp \
+    interface/iqrecorder.cpp \
+    interface/audiorecorder.cpp \
     interface/soundin.cpp
 
 HEADERS  += \
@@ -50,6 +84,8 @@ HEADERS  += \
     gui/editnetdlg.h \
     gui/ipeditwidget.h \
     gui/sounddlg.h \
+    gui/displaydlg.h \
+    gui/channelizerdlg.h \
     gui/freqctrl.h \
     gui/sliderctrl.h \
     gui/meter.h \
@@ -62,11 +98,24 @@ HEADERS  += \
     dsp/G711.h \
     dsp/G726.h \
     dsp/fir.h \
+    dsp/vectorops.h \
+    dsp/fft.h \
+    dsp/iqdemod.h \
+    dsp/channelizer.h \
+    dsp/interpolatex6.h \
+    dsp/decimateby6.h \
     dsp/datatypes.h \
     interface/soundout.h \
     interface/threadwrapper.h \
     interface/netio.h \
+    interface/ascpframer.h \
+    interface/txctrlqueue.h \
+    interface/spscring.h \
     interface/sdrinterface.h \
+    interface/rxchannel.h \
+    interface/iqspectrum.h \
+    interface/iqrecorder.h \
+    interface/audiorecorder.h \
     interface/ascpmsg.h \
     interface/sdrprotocol.h \
     interface/soundin.h
@@ -76,6 +125,8 @@ FORMS += \
     nanoforms/ipeditframe.ui \
     nanoforms/editnetdlg.ui \
     nanoforms/sounddlg.ui \
+    nanoforms/displaydlg.ui \
+    nanoforms/channelizerdlg.ui \
     nanoforms/sdrdiscoverdlg.ui \
     nanoforms/sliderctrl.ui \
     nanoforms/memdialog.ui \
@@ -25,8 +25,14 @@ THE SOFTWARE.
 
 #include "G711.h"
 
+uint8_t G711::m_ALawEncodeTab[1<<12];
+uint8_t G711::m_ULawEncodeTab[1<<14];
+int16_t G711::m_ALawDecodeTab[256];
+int16_t G711::m_ULawDecodeTab[256];
+bool G711::m_TablesBuilt = G711::BuildTables();
 
-inline uint8_t G711::ALawEncode(int16_t pcm16)
+
+uint8_t G711::ALawEncode(int16_t pcm16)
 {
 int p = pcm16;
 unsigned a;  // A-law value we are forming
@@ -71,7 +77,7 @@ unsigned a;  // A-law value we are forming
 }
 
 
-inline int G711::ALawDecode(uint8_t alaw)
+int G711::ALawDecode(uint8_t alaw)
 {
 	alaw ^= 0x55;  // A-law has alternate bits inverted for transmission
 
@@ -96,7 +102,7 @@ inline int G711::ALawDecode(uint8_t alaw)
 }
 
 
-inline uint8_t G711::ULawEncode(int16_t pcm16)
+uint8_t G711::ULawEncode(int16_t pcm16)
 {
 	int p = pcm16;
 	unsigned u;  // u-law value we are forming
@@ -145,7 +151,7 @@ inline uint8_t G711::ULawEncode(int16_t pcm16)
 }
 
 
-inline int G711::ULawDecode(uint8_t ulaw)
+int G711::ULawDecode(uint8_t ulaw)
 {
 	ulaw ^= 0xff;  // u-law has all bits inverted for transmission
 
@@ -166,21 +172,36 @@ inline int G711::ULawDecode(uint8_t ulaw)
 }
 
 
+bool G711::BuildTables()
+{
+	for(int i=0; i<(1<<12); i++)
+		m_ALawEncodeTab[i] = ALawEncode( (int16_t)((i-(1<<11))<<4) );
+	for(int i=0; i<(1<<14); i++)
+		m_ULawEncodeTab[i] = ULawEncode( (int16_t)((i-(1<<13))<<2) );
+	for(int i=0; i<256; i++)
+	{
+		m_ALawDecodeTab[i] = ALawDecode(i);
+		m_ULawDecodeTab[i] = ULawDecode(i);
+	}
+	return true;
+}
+
+
+// The loops below have no dependencies between samples so the compiler can
+// unroll them or use gather instructions on the small tables.
 unsigned int G711::ALawEncode(uint8_t* dst, int16_t* src, int srcSize)
 {
 	srcSize >>= 1;
-	uint8_t* end = dst+srcSize;
-	while(dst<end)
-		*dst++ = ALawEncode(*src++);
+	for(int i=0; i<srcSize; i++)
+		dst[i] = m_ALawEncodeTab[(src[i]>>4) + (1<<11)];
 	return srcSize;
 }
 
 
 unsigned int G711::ALawDecode(int16_t* dst, const uint8_t* src, int srcSize)
 {
-	int16_t* end = dst+srcSize;
-	while(dst<end)
-		*dst++ = ALawDecode(*src++);
+	for(int i=0; i<srcSize; i++)
+		dst[i] = m_ALawDecodeTab[src[i]];
 	return srcSize<<1;
 }
 
@@ -188,17 +209,15 @@ unsigned int G711::ALawDecode(int16_t* dst, const uint8_t* src, int srcSize)
 unsigned int G711::ULawEncode(uint8_t* dst, int16_t* src, int srcSize)
 {
 	srcSize >>= 1;
-	uint8_t* end = dst+srcSize;
-	while(dst<end)
-		*dst++ = ULawEncode(*src++);
+	for(int i=0; i<srcSize; i++)
+		dst[i] = m_ULawEncodeTab[(src[i]>>2) + (1<<13)];
 	return srcSize;
 }
 
 
 unsigned int G711::ULawDecode(int16_t* dst, const uint8_t* src, int srcSize)
 {
-	int16_t* end = dst+srcSize;
-	while(dst<end)
-		*dst++ = ULawDecode(*src++);
+	for(int i=0; i<srcSize; i++)
+		dst[i] = m_ULawDecodeTab[src[i]];
 	return srcSize<<1;
 }
@@ -29,6 +29,8 @@ THE SOFTWARE.
 //Note, the methods in this class use uniform PCM values which are of 16 bits precision,
 //these are 'left justified' values corresponding to the 13 and 14 bit values described
 //in G711.
+//The buffer functions use lookup tables built once at startup from the single value
+//functions, which are kept public as the reference implementation.
 
 #ifndef G711_H
 #define G711_H
@@ -66,26 +68,38 @@ public:
 	//return 	   The number of bytes which were stored at \a dst (equal to srcSize<<1)
 	unsigned int ULawDecode(int16_t* dst, const uint8_t* src, int srcSize);
 
-private:
 	//Encode a single 16 bit uniform PCM value into an A-Law value
 	//pcm16 A 16 bit uniform PCM value
 	//returns The A-Law encoded value corresponding to pcm16
-	uint8_t ALawEncode(int16_t pcm16);
+	static uint8_t ALawEncode(int16_t pcm16);
 
 	//	Decode a single A-Law value into a 16 bit uniform PCM value
 	// alaw An A-Law encoded value
 	//return 	The 16 bit uniform PCM value corresponding to alaw
-	int ALawDecode(uint8_t alaw);
+	static int ALawDecode(uint8_t alaw);
 
 	//Encode single 16 bit uniform PCM value into an u-Law value
 	//pcm16 A 16 bit uniform PCM value
 	//return 	 The u-Law encoded value corresponding to pcm16
-	uint8_t ULawEncode(int16_t pcm16);
+	static uint8_t ULawEncode(int16_t pcm16);
 
 	//Decode a single u-Law value into a 16 bit uniform PCM value
 	//param ulaw An u-Law encoded value
 	//return 	The 16 bit uniform PCM value corresponding to ulaw
-	int ULawDecode(uint8_t ulaw);
+	static int ULawDecode(uint8_t ulaw);
+
+private:
+	//Fills the lookup tables, called once during static initialization
+	static bool BuildTables();
+
+	//A-Law only uses the upper 12 bits of pcm16 so its encode table is indexed by pcm16>>4.
+	//u-Law adds a bias of 0x84 before dropping 3 bits, which never carries out of the
+	//lower 2 bits, so its encode table is indexed by pcm16>>2.
+	static uint8_t m_ALawEncodeTab[1<<12];
+	static uint8_t m_ULawEncodeTab[1<<14];
+	static int16_t m_ALawDecodeTab[256];
+	static int16_t m_ULawDecodeTab[256];
+	static bool m_TablesBuilt;
 };
 
 #endif
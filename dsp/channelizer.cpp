@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////
+// channelizer.cpp: implementation of the CChannelizer class.
+//
+//  Critically sampled analysis filter bank.  The Blackman windowed
+// sinc prototype lowpass has NumChannels*CHANNELIZER_TAPS taps and
+// its cutoff at half a channel width, so neighbouring channels cross
+// at about -6dB.  Input samples are dealt to the branches in reverse
+// order and after every NumChannels samples each branch FIR output
+// goes into the FFT.  Bin k of the forward FFT is the channel at
+// -k*SampleRate/NumChannels.
+//  Outputs are in the same scale as the raw I/Q bytes.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "dsp/channelizer.h"
+#include "dsp/vectorops.h"
+#include <math.h>
+
+/////////////////////////////////////////////////////////////////////
+// Constructor
+/////////////////////////////////////////////////////////////////////
+CChannelizer::CChannelizer()
+{
+	Setup(16, 16000);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Builds the branch filters for NumChannels channels
+// returns false if NumChannels is not a power of 2 up to MAX_CHANNELIZER_SIZE
+/////////////////////////////////////////////////////////////////////
+bool CChannelizer::Setup(int NumChannels, int SampleRate)
+{
+int i;
+int len = NumChannels*CHANNELIZER_TAPS;
+double x;
+double h;
+double w;
+	if( (NumChannels < 2) || (NumChannels > MAX_CHANNELIZER_SIZE) || (NumChannels & (NumChannels-1)) )
+		return false;
+	m_NumChannels = NumChannels;
+	m_SampleRate = SampleRate;
+	m_Fft.SetSize(NumChannels);
+	for(i=0; i<len; i++)
+	{
+		x = (double)i - (len - 1)/2.0;
+		h = 1.0/NumChannels;
+		if(0.0 != x)
+			h = sin(K_PI*x/NumChannels)/(K_PI*x);
+		w = 0.42 - 0.5*cos(K_2PI*(i+0.5)/len) + 0.08*cos(2.0*K_2PI*(i+0.5)/len);
+		//branch p gets taps p, p+N, p+2N...
+		m_Coef[i%NumChannels][i/NumChannels] = (float)(h*w);
+		m_Coef[i%NumChannels][i/NumChannels + CHANNELIZER_TAPS] = (float)(h*w);
+	}
+	for(i=0; i<NumChannels; i++)
+		m_OutIndex[i] = (NumChannels/2 - i) & (NumChannels - 1);
+	Reset();
+	return true;
+}
+
+void CChannelizer::Reset()
+{
+	for(int i=0; i<m_NumChannels; i++)
+	{
+		for(int j=0; j<CHANNELIZER_TAPS; j++)
+		{
+			m_ZRe[i][j] = 0.0;
+			m_ZIm[i][j] = 0.0;
+		}
+	}
+	m_Branch = m_NumChannels - 1;
+	m_State = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Process Length interleaved I/Q bytes into frames of m_NumChannels
+// TYPECPX samples in pOutBuf[].  pOutBuf must hold Length/2 plus
+// m_NumChannels samples.
+/////////////////////////////////////////////////////////////////////
+int CChannelizer::ProcessData(const qint8* pInBuf, int Length, TYPECPX* pOutBuf)
+{
+int i;
+int p;
+int len;
+int pos;
+int frames = 0;
+int numiq = Length/2;
+const float* pCoef;
+	for(pos=0; pos<numiq; pos+=len)
+	{
+		len = numiq - pos;
+		if(len > CHANNELIZER_BLOCK)
+			len = CHANNELIZER_BLOCK;
+		VecS8ToFloat(&pInBuf[2*pos], m_InBuf, 2*len);
+		for(i=0; i<len; i++)
+		{
+			m_ZRe[m_Branch][m_State] = m_InBuf[2*i];
+			m_ZIm[m_Branch][m_State] = m_InBuf[2*i+1];
+			if(--m_Branch >= 0)
+				continue;
+			//branch 0 got its sample so run all branch filters and the FFT
+			for(p=0; p<m_NumChannels; p++)
+			{
+				pCoef = &m_Coef[p][CHANNELIZER_TAPS - m_State];
+				m_FftBuf[p].re = VecDot(pCoef, m_ZRe[p], CHANNELIZER_TAPS);
+				m_FftBuf[p].im = VecDot(pCoef, m_ZIm[p], CHANNELIZER_TAPS);
+			}
+			m_Fft.Forward(m_FftBuf);
+			for(p=0; p<m_NumChannels; p++)
+				pOutBuf[p] = m_FftBuf[m_OutIndex[p]];
+			pOutBuf += m_NumChannels;
+			frames++;
+			m_Branch = m_NumChannels - 1;
+			if(--m_State < 0)
+				m_State += CHANNELIZER_TAPS;
+		}
+	}
+	return frames;
+}
@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////
+// channelizer.h: interface for the CChannelizer class.
+//
+//  Polyphase filter bank that splits a raw I/Q stream into N equal
+// width sub-channels decimated by N.  Each block of N input samples
+// costs one short FIR per branch plus one N point FFT.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#ifndef CHANNELIZER_H
+#define CHANNELIZER_H
+
+#include "dsp/datatypes.h"
+#include "dsp/fft.h"
+
+#define MAX_CHANNELIZER_SIZE 256
+#define CHANNELIZER_TAPS 8			//prototype filter taps per branch
+#define CHANNELIZER_BLOCK 256		//I/Q samples converted to float at a time
+
+class CChannelizer
+{
+public:
+	CChannelizer();
+
+	bool Setup(int NumChannels, int SampleRate);	//NumChannels is a power of 2
+	int GetNumChannels(){return m_NumChannels;}
+	int GetChannelRate(){return m_SampleRate/m_NumChannels;}
+	int GetChannelOffset(int Channel){return (Channel - m_NumChannels/2)*m_SampleRate/m_NumChannels;}	//Hz from center
+	void Reset();
+	//Length interleaved I/Q bytes in, NumChannels samples per output frame out
+	//with channels in frequency order.  Returns number of frames.
+	int ProcessData(const qint8* pInBuf, int Length, TYPECPX* pOutBuf);
+
+private:
+	int m_NumChannels;
+	int m_SampleRate;
+	int m_Branch;			//branch the next input sample goes to
+	int m_State;
+	CFft m_Fft;
+	float m_Coef[MAX_CHANNELIZER_SIZE][CHANNELIZER_TAPS*2];	//doubled to avoid buffer wrap tests
+	float m_ZRe[MAX_CHANNELIZER_SIZE][CHANNELIZER_TAPS];
+	float m_ZIm[MAX_CHANNELIZER_SIZE][CHANNELIZER_TAPS];
+	int m_OutIndex[MAX_CHANNELIZER_SIZE];	//FFT bin of each channel
+	TYPECPX m_FftBuf[MAX_CHANNELIZER_SIZE];
+	float m_InBuf[CHANNELIZER_BLOCK*2];
+};
+
+#endif // CHANNELIZER_H
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////
+// decimateby6.cpp: implementation of the CDecimateBy6 class.
+//
+//  The half band and decimate by 3 filters are convolved once into a
+// single 147 tap filter padded to 152 and kept as float.  Each block
+// of input is converted into a linear float history buffer and every
+// 6th output is calculated with 8 partial sums so the MAC loop
+// vectorizes.  Outputs are clamped to 16 bits.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "dsp/decimateby6.h"
+
+/////////////////////////////////////////////////////////////////////
+// Constructor
+/////////////////////////////////////////////////////////////////////
+CDecimateBy6::CDecimateBy6()
+{
+	//Build decimate by 6 coefficients once from the x3 filter upsampled by 2
+	//convolved with the half band filter. Output n is
+	//  sum over k of x[n-k]*h[k]
+	float h[DEC6_TAP_LENGTH];
+	for(int i=0; i<DEC6_TAP_LENGTH; i++)
+		h[i] = 0.0;
+	for(int i=0; i<DEC3TAP_LENGTH; i++)
+		for(int j=0; j<DEC2TAP_LENGTH; j++)
+			h[i*2 + j] += DEC3_H[i]*DEC2_H[j];
+	for(int k=0; k<DEC6_TAP_LENGTH; k++)
+		m_Coef[DEC6_TAP_LENGTH-1-k] = h[k];
+	Reset();
+}
+
+void CDecimateBy6::Reset()
+{
+	m_Phase = 0;
+	for(int i=0; i<DEC6_TAP_LENGTH-1 ;i++)
+		m_Buf[i] = 0.0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Decimate by 6 function.
+// Runs the combined filter on whole blocks and only calculates the
+// outputs that are kept.
+//////////////////////////////////////////////////////////////////////
+int CDecimateBy6::ProcessData(int InLength, const qint16* pInData, qint16* pOutData)
+{
+int i;
+int k;
+int p;
+int len;
+float acc[DEC6_LANES];
+float y;
+const float* x;
+int numoutsamples = 0;
+	while(InLength > 0)
+	{
+		len = InLength;
+		if(len > DEC6_BLOCK)
+			len = DEC6_BLOCK;
+		for(i=0; i<len; i++)
+			m_Buf[DEC6_TAP_LENGTH-1+i] = (float)pInData[i];
+		for(i=m_Phase; i<len; i+=DEC6_VALUE)
+		{
+			x = &m_Buf[i];
+			for(p=0; p<DEC6_LANES; p++)
+				acc[p] = 0.0;
+			for(k=0; k<DEC6_TAP_LENGTH; k+=DEC6_LANES)
+			{
+				for(p=0; p<DEC6_LANES; p++)
+					acc[p] += x[k+p]*m_Coef[k+p];
+			}
+			y = 0.0;
+			for(p=0; p<DEC6_LANES; p++)
+				y += acc[p];
+			if(y > 32767.0)
+				y = 32767.0;
+			else if(y < -32768.0)
+				y = -32768.0;
+			pOutData[numoutsamples++] = (qint16)y;
+		}
+		m_Phase = i - len;
+		//keep last inputs as history for next block
+		for(i=0; i<DEC6_TAP_LENGTH-1; i++)
+			m_Buf[i] = m_Buf[len+i];
+		pInData += len;
+		InLength -= len;
+	}
+	return numoutsamples;
+}
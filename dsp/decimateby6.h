@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////
+// decimateby6.h: interface for the CDecimateBy6 class.
+//
+//  Decimates 48Ksps soundcard input by 6 to 8Ksps with one filter made
+// from the half band and decimate by 3 filters CSoundIn used to run in
+// cascade.  Only the outputs that are kept are calculated.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#ifndef DECIMATEBY6_H
+#define DECIMATEBY6_H
+
+#include <QtGlobal>
+
+#define DEC2TAP_LENGTH 23
+const double DEC2_H[DEC2TAP_LENGTH] =
+{
+	-0.00014987651418332164, 0.0,
+	0.0014748633283609852, 0.0,
+	-0.0074416944990005314, 0.0,
+	0.026163522731980929, 0.0,
+	-0.077593699116544707, 0.0,
+	0.30754683719791986, 0.5,
+	0.30754683719791986, 0.0,
+	-0.077593699116544707, 0.0,
+	0.026163522731980929, 0.0,
+	-0.0074416944990005314, 0.0,
+	0.0014748633283609852, 0.0,
+	-0.00014987651418332164
+};
+
+//3.5kHz PBand, .5dB ripple,  70dB StopBand at 4.5kHz at 24KHz samplerate
+#define DEC3TAP_LENGTH 63
+const double DEC3_H[DEC3TAP_LENGTH] =
+{
+	-0.000122089672, 0.000756870819, 0.002723170921, 0.005253908351, 0.006498627630,
+	 0.004642639462,-0.000127922266,-0.004816317633,-0.005459270973,-0.000749873754,
+	 0.005791180122, 0.007947782646, 0.002401758772,-0.007062842708,-0.011594604118,
+	 -0.005173923318, 0.008331932993, 0.016607547268, 0.009560094412,-0.009513394530,
+	-0.023769125601,-0.016708360339, 0.010511004278, 0.035111757024, 0.029654555288,
+	-0.011273660216,-0.057805247862,-0.060635313789, 0.011753658267, 0.142509501597,
+	 0.269092683398, 0.321418881518, 0.269092683398, 0.142509501597, 0.011753658267,
+	 -0.060635313789,-0.057805247862,-0.011273660216, 0.029654555288, 0.035111757024,
+	 0.010511004278,-0.016708360339,-0.023769125601,-0.009513394530, 0.009560094412,
+	  0.016607547268, 0.008331932993,-0.005173923318,-0.011594604118,-0.007062842708,
+	 0.002401758772, 0.007947782646, 0.005791180122,-0.000749873754,-0.005459270973,
+	 -0.004816317633,-0.000127922266, 0.004642639462, 0.006498627630, 0.005253908351,
+	 0.002723170921, 0.000756870819,-0.000122089672
+};
+
+//DEC2_H and DEC3_H are combined into one decimate by 6 filter at 48KHz
+#define DEC6_VALUE 6
+#define DEC6_FIR_SIZE ((DEC3TAP_LENGTH-1)*2 + DEC2TAP_LENGTH)	//147 taps
+#define DEC6_LANES 8		//taps padded to 8 so MAC loop fits SIMD registers
+#define DEC6_TAP_LENGTH (((DEC6_FIR_SIZE+DEC6_LANES-1)/DEC6_LANES)*DEC6_LANES)	//152 taps
+#define DEC6_BLOCK 1200		//input samples processed per block
+
+class CDecimateBy6
+{
+public:
+	CDecimateBy6();
+
+	void Reset();
+	//InLength samples of any length in, pOutData may be the same buffer
+	//as pInData.  Returns the number of output samples.
+	int ProcessData(int InLength, const qint16* pInData, qint16* pOutData);
+
+private:
+	int m_Phase;	//position in next block of next output sample
+	float m_Coef[DEC6_TAP_LENGTH];	//oldest input tap first
+	float m_Buf[DEC6_TAP_LENGTH-1+DEC6_BLOCK];	//input history followed by new block
+};
+
+#endif // DECIMATEBY6_H
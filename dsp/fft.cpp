@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////
+// fft.cpp: implementation of the CFft class.
+//
+//  Decimation in time radix 2 FFT.  The input is put in bit reversed
+//order first, then each pass combines butterflies using a stride into
+//the single full size twiddle table.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "dsp/fft.h"
+
+CFft::CFft()
+{
+	m_Size = 0;
+	SetSize(1024);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Builds bit reverse and twiddle tables for a new FFT size
+/////////////////////////////////////////////////////////////////////
+bool CFft::SetSize(int Size)
+{
+int i;
+int j;
+int bits = 0;
+	if( (Size < 2) || (Size > MAX_FFT_SIZE) || (Size & (Size-1)) )
+		return false;
+	if(Size == m_Size)
+		return true;
+	while( (1<<bits) < Size)
+		bits++;
+	for(i=0; i<Size; i++)
+	{
+		m_BitRev[i] = 0;
+		for(j=0; j<bits; j++)
+		{
+			if( i & (1<<j) )
+				m_BitRev[i] |= 1<<(bits-1-j);
+		}
+	}
+	for(i=0; i<Size/2; i++)
+	{
+		m_Twiddle[i].re = (TYPEREAL)cos(K_2PI*(double)i/(double)Size);
+		m_Twiddle[i].im = (TYPEREAL)-sin(K_2PI*(double)i/(double)Size);
+	}
+	m_Size = Size;
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// In place forward FFT of m_Size complex samples in pBuf
+/////////////////////////////////////////////////////////////////////
+void CFft::Forward(TYPECPX* pBuf)
+{
+int i;
+int j;
+int k;
+int half;
+int stride;
+TYPECPX t;
+TYPECPX w;
+TYPECPX* pA;
+TYPECPX* pB;
+	for(i=0; i<m_Size; i++)
+	{
+		j = m_BitRev[i];
+		if(j > i)
+		{
+			t = pBuf[i];
+			pBuf[i] = pBuf[j];
+			pBuf[j] = t;
+		}
+	}
+	//first pass needs no multiplies
+	for(i=0; i<m_Size; i+=2)
+	{
+		t = pBuf[i+1];
+		pBuf[i+1].re = pBuf[i].re - t.re;
+		pBuf[i+1].im = pBuf[i].im - t.im;
+		pBuf[i].re += t.re;
+		pBuf[i].im += t.im;
+	}
+	for(half=2, stride=m_Size/4; half<m_Size; half*=2, stride/=2)
+	{
+		for(i=0; i<m_Size; i+=2*half)
+		{
+			pA = &pBuf[i];
+			pB = &pBuf[i+half];
+			for(k=0; k<half; k++)
+			{
+				w = m_Twiddle[k*stride];
+				t.re = pB[k].re*w.re - pB[k].im*w.im;
+				t.im = pB[k].re*w.im + pB[k].im*w.re;
+				pB[k].re = pA[k].re - t.re;
+				pB[k].im = pA[k].im - t.im;
+				pA[k].re += t.re;
+				pA[k].im += t.im;
+			}
+		}
+	}
+}
@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////
+// fft.h: interface for the CFft class.
+//
+//  In place radix 2 complex FFT with precomputed twiddle factors and
+//bit reverse table.  Size must be a power of 2.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#ifndef FFT_H
+#define FFT_H
+
+#include "dsp/datatypes.h"
+
+#define MAX_FFT_SIZE 16384
+
+class CFft
+{
+public:
+	CFft();
+
+	bool SetSize(int Size);		//returns false if not a power of 2 up to MAX_FFT_SIZE
+	int GetSize(){return m_Size;}
+	void Forward(TYPECPX* pBuf);	//output bin k is frequency k*Fs/Size, upper half negative
+
+private:
+	int m_Size;
+	int m_BitRev[MAX_FFT_SIZE];
+	TYPECPX m_Twiddle[MAX_FFT_SIZE/2];	//exp(-j*2*pi*k/Size)
+};
+
+#endif // FFT_H
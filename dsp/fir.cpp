@@ -41,6 +41,7 @@
 //or implied, of Moe Wheatley.
 //==========================================================================================
 #include "fir.h"
+#include "vectorops.h"
 #include <QFile>
 #include <QDir>
 #include <QDebug>
@@ -49,6 +50,8 @@
 //////////////////////////////////////////////////////////////////////
 // Local Defines
 //////////////////////////////////////////////////////////////////////
+#define FIR_BLOCKSIZE 256	//samples converted to float at a time by integer version
+#define FIR_VECDOT_MINTAPS 24	//shorter filters are quicker inline than through VecDot()
 
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +64,20 @@ CFir::CFir()
 }
 
 
+/////////////////////////////////////////////////////////////////////////////////
+//	Called with m_Mutex locked to do the MACs for the newest sample
+/////////////////////////////////////////////////////////////////////////////////
+inline TYPEREAL CFir::DoMacs()
+{
+const TYPEREAL* Hptr = &m_Coef[m_NumTaps - m_State];
+TYPEREAL acc = 0.0;
+	if(m_NumTaps >= FIR_VECDOT_MINTAPS)
+		return VecDot(Hptr, m_rZBuf, m_NumTaps);
+	for(int j=0; j<m_NumTaps; j++)
+		acc += Hptr[j]*m_rZBuf[j];
+	return acc;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 //	Process InLength InBuf[] samples and place in OutBuf[]
 //  Note the Coefficient array is twice the length and has a duplicated set
@@ -71,21 +88,13 @@ CFir::CFir()
 /////////////////////////////////////////////////////////////////////////////////
 void CFir::ProcessFilter(int InLength, TYPEREAL* InBuf, TYPEREAL* OutBuf)
 {
-TYPEREAL acc;
-TYPEREAL* Zptr;
-const TYPEREAL* Hptr;
 	m_Mutex.lock();
 	for(int i=0; i<InLength; i++)
 	{
 		m_rZBuf[m_State] = InBuf[i];
-		Hptr = &m_Coef[m_NumTaps - m_State];
-		Zptr = m_rZBuf;
-		acc = 0.0;
-		for(int j=0; j<m_NumTaps; j++)
-			acc += (*Hptr++ * *Zptr++);	//do the MACs
+		OutBuf[i] = DoMacs();
 		if(--m_State < 0)
 			m_State += m_NumTaps;
-		OutBuf[i] = acc;
 	}
 	m_Mutex.unlock();
 }
@@ -97,24 +106,31 @@ const TYPEREAL* Hptr;
 //  ex: if 3 tap FIR with coefficients{21,-43,15} is made into a array of 6 entries
 //   {21, -43, 15, 21, -43, 15 }
 //INTEGER version
+// Samples are converted to float a block at a time and the results are
+//rounded and saturated back to 16 bits a block at a time.
 /////////////////////////////////////////////////////////////////////////////////
 void CFir::ProcessFilter(int InLength, qint16* InBuf, qint16* OutBuf)
 {
-TYPEREAL acc;
-TYPEREAL* Zptr;
-const TYPEREAL* Hptr;
+TYPEREAL Buf[FIR_BLOCKSIZE];
+int len;
 	m_Mutex.lock();
-	for(int i=0; i<InLength; i++)
+	while(InLength > 0)
 	{
-		m_rZBuf[m_State] = (TYPEREAL)InBuf[i];
-		Hptr = &m_Coef[m_NumTaps - m_State];
-		Zptr = m_rZBuf;
-		acc = 0.0;
-		for(int j=0; j<m_NumTaps; j++)
-			acc += (*Hptr++ * *Zptr++);	//do the MACs
-		if(--m_State < 0)
-			m_State += m_NumTaps;
-		OutBuf[i] = (qint16)acc;
+		len = InLength;
+		if(len > FIR_BLOCKSIZE)
+			len = FIR_BLOCKSIZE;
+		VecS16ToFloat(InBuf, Buf, len);
+		for(int i=0; i<len; i++)
+		{
+			m_rZBuf[m_State] = Buf[i];
+			Buf[i] = DoMacs();
+			if(--m_State < 0)
+				m_State += m_NumTaps;
+		}
+		VecFloatToS16(Buf, OutBuf, len);
+		InBuf += len;
+		OutBuf += len;
+		InLength -= len;
 	}
 	m_Mutex.unlock();
 }
@@ -32,6 +32,7 @@ public:
 
 private:
 	TYPEREAL Izero(TYPEREAL x);
+	TYPEREAL DoMacs();
 
 	int m_NumTaps;
 	int m_State;
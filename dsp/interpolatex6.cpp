@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////
+// interpolatex6.cpp: implementation of the CInterpolateX6 class.
+//
+//  The 135 tap x6 filter is the x2 filter upsampled by 3 convolved
+// with the x3 filter.  Coefficients are laid out [tap][phase].  Input
+// is processed in blocks over a linear history buffer so there is no
+// modulo indexing.  Within a block each phase is computed for
+// INTP6_LANES input samples at a time so the sums are independent
+// and stay in SIMD registers.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "dsp/interpolatex6.h"
+#include <string.h>
+
+/////////////////////////////////////////////////////////////////////
+// Constructor
+/////////////////////////////////////////////////////////////////////
+CInterpolateX6::CInterpolateX6()
+{
+	//Build x6 polyphase coefficients once from the x2 filter upsampled by 3
+	//convolved with the x3 filter. Output phase p of input sample n is
+	//  sum over k of x[n-k]*h[6k+p]
+	float h[INTP6_QUE_SIZE*INTP6_VALUE];
+	for(int i=0; i<INTP6_QUE_SIZE*INTP6_VALUE; i++)
+		h[i] = 0.0;
+	for(int i=0; i<INTP2_FIR_SIZE; i++)
+		for(int j=0; j<INTP3_FIR_SIZE; j++)
+			h[i*INTP3_VALUE + j] += X2IntrpFIRCoef[i]*X3IntrpFIRCoef[j];
+	for(int k=0; k<INTP6_QUE_SIZE; k++)
+		for(int p=0; p<INTP6_VALUE; p++)
+			m_Coef[INTP6_QUE_SIZE-1-k][p] = h[k*INTP6_VALUE + p];
+	Reset();
+}
+
+void CInterpolateX6::Reset()
+{
+	for(int i=0; i<INTP6_QUE_SIZE-1+INTP6_BLOCK+INTP6_LANES; i++)
+		m_Buf[i] = 0.0;
+}
+
+void CInterpolateX6::CopyHistory(const CInterpolateX6& Src)
+{
+	memcpy(m_Buf, Src.m_Buf, (INTP6_QUE_SIZE-1)*sizeof(float));
+}
+
+////////////////////////////////////////////////////////////////
+// Interpolates n samples in pIn by 6 to pOut.
+// Returns the number of output samples.
+////////////////////////////////////////////////////////////////
+int CInterpolateX6::ProcessData(const float* pIn, float* pOut, int n)
+{
+int i;
+int j;
+int k;
+int p;
+int m;
+int len;
+float acc[INTP6_LANES];
+float c;
+const float* x;
+int numout = 0;
+	while(n > 0)
+	{
+		len = n;
+		if(len > INTP6_BLOCK)
+			len = INTP6_BLOCK;
+		for(i=0; i<len; i++)
+			m_Buf[INTP6_QUE_SIZE-1+i] = pIn[i];
+		for(i=0; i<len; i+=INTP6_LANES)
+		{	//lanes past the end of the block read padding and are not output
+			x = &m_Buf[i];
+			m = len - i;
+			if(m > INTP6_LANES)
+				m = INTP6_LANES;
+			for(p=0; p<INTP6_VALUE; p++)
+			{
+				for(j=0; j<INTP6_LANES; j++)
+					acc[j] = 0.0;
+				for(k=0; k<INTP6_QUE_SIZE; k++)
+				{
+					c = m_Coef[k][p];
+					for(j=0; j<INTP6_LANES; j++)
+						acc[j] += c*x[k+j];
+				}
+				for(j=0; j<m; j++)
+					pOut[numout + j*INTP6_VALUE + p] = acc[j];
+			}
+			numout += m*INTP6_VALUE;
+		}
+		//keep last inputs as history for next block
+		for(i=0; i<INTP6_QUE_SIZE-1; i++)
+			m_Buf[i] = m_Buf[len+i];
+		pIn += len;
+		n -= len;
+	}
+	return numout;
+}
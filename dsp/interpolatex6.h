@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////
+// interpolatex6.h: interface for the CInterpolateX6 class.
+//
+//  Interpolates 8Ksps audio by 6 to 48Ksps with one polyphase filter
+// made from the x2 and x3 interpolation filters CSoundOut used to run
+// in cascade.  Each phase is computed for eight input samples together
+// in a fixed length loop the compiler vectorizes.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#ifndef INTERPOLATEX6_H
+#define INTERPOLATEX6_H
+
+#define INTP2_FIR_SIZE 38
+#define INTP2_VALUE 2
+#define INTP2_QUE_SIZE (INTP2_FIR_SIZE/INTP2_VALUE)
+
+const float X2IntrpFIRCoef[INTP2_FIR_SIZE] = {
+	0.004595199062f,	 0.003263078569f,	-0.012307513857f,	-0.023605770514f,	-0.004776493194f,
+	 0.020455597889f,	 0.003416955875f,	-0.032096849071f,	-0.010936520267f,	 0.043997619201f,
+	 0.021109718259f,	-0.061591694157f,	-0.038850736238f,	 0.088428267617f,	 0.071893731289f,
+	-0.140300185169f,	-0.155068799286f,	 0.316698335862f,	 0.879226589556f,	 0.879226589556f,
+	 0.316698335862f,	-0.155068799286f,	-0.140300185169f,	 0.071893731289f,	 0.088428267617f,
+	-0.038850736238f,	-0.061591694157f,	 0.021109718259f,	 0.043997619201f,	-0.010936520267f,
+	-0.032096849071f,	 0.003416955875f,	 0.020455597889f,	-0.004776493194f,	-0.023605770514f,
+	-0.012307513857f,	 0.003263078569f,	 0.004595199062f
+};
+
+#define INTP3_FIR_SIZE 24
+#define INTP3_VALUE 3
+#define INTP3_QUE_SIZE (INTP3_FIR_SIZE/INTP3_VALUE)
+const float X3IntrpFIRCoef[INTP3_FIR_SIZE] = {
+	0.011573982735f,	0.014334218226f,	0.006363947118f,   -0.021096865220f,   -0.062826223097f,
+   -0.096581775049f,   -0.088551387570f,   -0.009298026286f,	0.146903362727f,	0.350809254265f,
+	0.544080700435f,	0.661916011265f,	0.661916011265f,	0.544080700435f,	0.350809254265f,
+	0.146903362727f,   -0.009298026286f,   -0.088551387570f,   -0.096581775049f,   -0.062826223097f,
+   -0.021096865220f,	0.006363947118f,	0.014334218226f,	0.011573982735f
+};
+
+
+//combined x6 polyphase interpolator built from the x2 and x3 filters above
+#define INTP6_VALUE (INTP2_VALUE*INTP3_VALUE)
+#define INTP6_FIR_SIZE ((INTP2_FIR_SIZE-1)*INTP3_VALUE + INTP3_FIR_SIZE)	//135 taps
+#define INTP6_QUE_SIZE ((INTP6_FIR_SIZE+INTP6_VALUE-1)/INTP6_VALUE)	//23 taps per phase
+#define INTP6_LANES 8		//input samples filtered together, fits SIMD registers
+#define INTP6_BLOCK 256		//input samples processed per block
+
+class CInterpolateX6
+{
+public:
+	CInterpolateX6();
+
+	void Reset();
+	//n input samples at any rate of calls, pOut must hold 6*n samples.
+	//Returns the number of output samples.
+	int ProcessData(const float* pIn, float* pOut, int n);
+	//continue from the input history of another interpolator
+	void CopyHistory(const CInterpolateX6& Src);
+
+private:
+	float m_Coef[INTP6_QUE_SIZE][INTP6_VALUE];	//[tap][phase], oldest input tap first
+	float m_Buf[INTP6_QUE_SIZE-1+INTP6_BLOCK+INTP6_LANES];	//input history, new block and padding for the last lanes
+};
+
+#endif // INTERPOLATEX6_H
@@ -0,0 +1,380 @@
+//////////////////////////////////////////////////////////////////////
+// iqdemod.cpp: implementation of the CIqDemod class.
+//
+//  The raw I/Q is run through a complex bandpass channel filter made
+// by shifting a Blackman windowed sinc lowpass to the center of the
+// demod filter.  At 16Ksps the filter also decimates by 2.  The
+// filtered signal is demodulated and AGC'd at the demod rate then
+// interpolated up to 8Ksps with a polyphase lowpass.  All filter MACs
+// go through the vector dot product.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "dsp/iqdemod.h"
+#include "dsp/vectorops.h"
+#include "interface/sdrprotocol.h"
+#include <math.h>
+
+//////////////////////////////////////////////////////////////////////
+// Local Defines
+//////////////////////////////////////////////////////////////////////
+#define FILTER_TRANSITION 200.0	//channel filter transition width in Hz
+#define AGC_OUT_LEVEL 0.3		//AGC output level, 1.0 is full scale
+#define AGC_ATTACK_TIME 0.002	//seconds
+#define PLL_BW 50.0				//SAM carrier loop bandwidth in Hz
+#define PLL_ZETA 0.707
+#define PLL_MAX_FREQ 200.0		//SAM carrier pull in range in Hz
+#define DC_ALPHA 0.995f			//AM/SAM DC blocker pole
+
+/////////////////////////////////////////////////////////////////////
+// Constructor
+/////////////////////////////////////////////////////////////////////
+CIqDemod::CIqDemod()
+{
+	m_InRate = 16000;
+	m_Mode = DEMOD_MODE_AM;
+	m_LowCut = -5000;
+	m_HighCut = 5000;
+	m_Offset = 0;
+	m_AgcSlope = 0;
+	m_AgcThresh = -100;
+	m_AgcDecay = 200;
+	m_SetupChanged = true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Settings.  The filters are rebuilt by the thread processing data
+// with the next block.
+/////////////////////////////////////////////////////////////////////
+void CIqDemod::SetSampleRate(int SampleRate)
+{
+	m_Mutex.lock();
+	if(SampleRate != m_InRate)
+	{
+		m_InRate = SampleRate;
+		m_SetupChanged = true;
+	}
+	m_Mutex.unlock();
+}
+
+void CIqDemod::SetDemodMode(int Mode)
+{
+	m_Mutex.lock();
+	m_Mode = Mode;
+	m_SetupChanged = true;
+	m_Mutex.unlock();
+}
+
+void CIqDemod::SetDemodFilter(int LowCut, int HighCut, int Offset)
+{
+	m_Mutex.lock();
+	m_LowCut = LowCut;
+	m_HighCut = HighCut;
+	m_Offset = Offset;
+	m_SetupChanged = true;
+	m_Mutex.unlock();
+}
+
+//Thresh is the AGC knee in dB below full scale, Slope is the output
+//increase in dB per 10dB above the knee and Decay is in mSec.
+void CIqDemod::SetAgc(int Slope, int Thresh, int Decay)
+{
+	m_Mutex.lock();
+	m_AgcSlope = Slope;
+	m_AgcThresh = Thresh;
+	m_AgcDecay = Decay;
+	m_SetupChanged = true;
+	m_Mutex.unlock();
+}
+
+void CIqDemod::Reset()
+{
+	m_Mutex.lock();
+	m_SetupChanged = true;
+	m_Mutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Returns the number of raw I/Q bytes that can be passed to
+// ProcessData() without making more than MaxOutput samples.
+/////////////////////////////////////////////////////////////////////
+int CIqDemod::GetMaxInputLength(int MaxOutput)
+{
+int n;
+	m_Mutex.lock();
+	if(m_SetupChanged)
+		Setup();
+	n = 2*(MaxOutput/m_Interp)*m_Decimate;
+	m_Mutex.unlock();
+	return n;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called with m_Mutex locked to build the filters for the current
+// settings and clear all the demodulator state.
+/////////////////////////////////////////////////////////////////////
+void CIqDemod::Setup()
+{
+int i;
+int k;
+int N;
+int L;
+double lo = m_LowCut;
+double hi = m_HighCut;
+double limit;
+double fc;
+double bw;
+double x;
+double h;
+double w;
+	m_Decimate = (m_InRate > IQDEMOD_OUTRATE) ? m_InRate/IQDEMOD_OUTRATE : 1;
+	m_DemodRate = m_InRate/m_Decimate;
+	m_Interp = IQDEMOD_OUTRATE/m_DemodRate;
+	if(m_Interp < 1)
+		m_Interp = 1;
+	if(m_Interp > IQDEMOD_MAX_INTP)
+		m_Interp = IQDEMOD_MAX_INTP;
+
+	//channel filter must fit in the demod bandwidth
+	limit = 0.45*m_DemodRate;
+	if( (DEMOD_MODE_CWU == m_Mode) || (DEMOD_MODE_CWL == m_Mode) )
+		limit -= fabs((double)m_Offset);	//CW filter is around the carrier
+	if(limit < 50.0)
+		limit = 50.0;
+	lo = (lo < -limit) ? -limit : ( (lo > limit) ? limit : lo);
+	hi = (hi < -limit) ? -limit : ( (hi > limit) ? limit : hi);
+	if( (hi - lo) < 50.0)
+	{
+		lo = -25.0;
+		hi = 25.0;
+	}
+	fc = (hi + lo)/2.0;
+	bw = (hi - lo)/2.0;
+	N = ( (int)(5.5*m_InRate/FILTER_TRANSITION) ) | 1;
+	if(N > IQDEMOD_MAX_TAPS)
+		N = IQDEMOD_MAX_TAPS;
+	for(i=0; i<N; i++)
+	{
+		x = (double)(i - (N-1)/2);
+		if(0.0 == x)
+			h = 2.0*bw/m_InRate;
+		else
+			h = sin(K_2PI*bw*x/m_InRate)/(K_PI*x);
+		w = 0.42 - 0.5*cos(K_2PI*i/(N-1)) + 0.08*cos(2.0*K_2PI*i/(N-1));
+		h *= w/127.0;		//raw bytes are full scale at 127
+		m_CoefRe[i] = m_CoefRe[i+N] = (float)(h*cos(K_2PI*fc*x/m_InRate));
+		m_CoefIm[i] = m_CoefIm[i+N] = (float)(h*sin(K_2PI*fc*x/m_InRate));
+		m_ZRe[i] = 0.0;
+		m_ZIm[i] = 0.0;
+	}
+	m_NumTaps = N;
+	m_State = 0;
+	m_DecCount = 0;
+
+	//polyphase interpolator, prototype lowpass runs at 8Ksps
+	L = m_Interp;
+	for(i=0; i<L*IQDEMOD_INTP_TAPS; i++)
+	{
+		x = (double)i - (L*IQDEMOD_INTP_TAPS - 1)/2.0;
+		h = 0.45*m_DemodRate*2.0/IQDEMOD_OUTRATE;	//cutoff below the demod rate Nyquist
+		if(0.0 != x)
+			h = sin(K_PI*h*x)/(K_PI*x);
+		w = 0.42 - 0.5*cos(K_2PI*(i+0.5)/(L*IQDEMOD_INTP_TAPS))
+				+ 0.08*cos(2.0*K_2PI*(i+0.5)/(L*IQDEMOD_INTP_TAPS));
+		k = i/L;
+		m_IntpCoef[i%L][k] = m_IntpCoef[i%L][k+IQDEMOD_INTP_TAPS] = (float)(L*h*w);
+	}
+	for(k=0; k<IQDEMOD_INTP_TAPS; k++)
+		m_IntpZ[k] = 0.0;
+	m_IntpState = 0;
+
+	m_RealOnly = ( (DEMOD_MODE_LSB == m_Mode) || (DEMOD_MODE_USB == m_Mode) ||
+				(DEMOD_MODE_DSB == m_Mode) || (DEMOD_MODE_DIG == m_Mode) );
+	m_Prev.re = 0.0;
+	m_Prev.im = 0.0;
+	m_NcoPhase = 0.0;
+	m_NcoInc = K_2PI*m_Offset/m_DemodRate;
+	m_PllPhase = 0.0;
+	m_PllFreq = 0.0;
+	x = K_2PI*PLL_BW/m_DemodRate;
+	m_PllAlpha = 2.0*PLL_ZETA*x;
+	m_PllBeta = x*x;
+	m_DcIn = 0.0;
+	m_DcOut = 0.0;
+	bw = (fabs(lo) > fabs(hi)) ? fabs(lo) : fabs(hi);	//peak FM deviation
+	m_FmGain = 0.5*m_DemodRate/(K_2PI*bw);
+	m_AgcKnee = pow(10.0, m_AgcThresh/20.0);
+	m_AgcMaxGain = AGC_OUT_LEVEL/m_AgcKnee;
+	m_AgcEnv = m_AgcKnee;
+	m_AgcAttack = 1.0 - exp(-1.0/(AGC_ATTACK_TIME*m_DemodRate));
+	m_AgcRelease = exp(-1.0/( (m_AgcDecay < 1 ? 1 : m_AgcDecay)*0.001*m_DemodRate));
+	m_SetupChanged = false;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Process Length interleaved I/Q bytes into pOutBuf[] audio samples.
+// Returns number of 8Ksps samples.
+/////////////////////////////////////////////////////////////////////
+int CIqDemod::ProcessData(const qint8* pInBuf, int Length, qint16* pOutBuf)
+{
+int i;
+int len;
+int pos;
+int n = 0;
+int numiq = Length/2;
+	m_Mutex.lock();
+	if(m_SetupChanged)
+		Setup();
+	for(pos=0; pos<numiq; pos+=len)
+	{
+		len = numiq - pos;
+		if(len > IQDEMOD_BLOCK)
+			len = IQDEMOD_BLOCK;
+		VecS8ToFloat(&pInBuf[2*pos], m_InBuf, 2*len);
+		for(i=0; i<len; i++)
+			n += ProcessSample(m_InBuf[2*i], m_InBuf[2*i+1], &pOutBuf[n]);
+	}
+	m_Mutex.unlock();
+	return n;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Process Length complex samples such as a channelizer output.
+// Returns number of 8Ksps samples.
+/////////////////////////////////////////////////////////////////////
+int CIqDemod::ProcessData(const TYPECPX* pInBuf, int Length, qint16* pOutBuf)
+{
+int n = 0;
+	m_Mutex.lock();
+	if(m_SetupChanged)
+		Setup();
+	for(int i=0; i<Length; i++)
+		n += ProcessSample(pInBuf[i].re, pInBuf[i].im, &pOutBuf[n]);
+	m_Mutex.unlock();
+	return n;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Runs one I/Q sample through the channel filter and, when it is time
+// for a decimated output, the demod and interpolator.
+// Returns number of samples put in pOutBuf[].
+/////////////////////////////////////////////////////////////////////
+int CIqDemod::ProcessSample(float re, float im, qint16* pOutBuf)
+{
+int p;
+int s;
+int n = 0;
+int N = m_NumTaps;
+float a;
+TYPECPX y;
+	m_ZRe[m_State] = re;
+	m_ZIm[m_State] = im;
+	if(++m_DecCount >= m_Decimate)
+	{
+		m_DecCount = 0;
+		y.re = VecDot(&m_CoefRe[N - m_State], m_ZRe, N) - VecDot(&m_CoefIm[N - m_State], m_ZIm, N);
+		if(m_RealOnly)
+			y.im = 0.0;
+		else
+			y.im = VecDot(&m_CoefRe[N - m_State], m_ZIm, N) + VecDot(&m_CoefIm[N - m_State], m_ZRe, N);
+		a = Demod(y);
+		if(1 == m_Interp)
+		{
+			s = (int)lrintf(a*32767.0f);
+			pOutBuf[n++] = (qint16)( (s > 32767) ? 32767 : ( (s < -32767) ? -32767 : s) );
+		}
+		else
+		{
+			m_IntpZ[m_IntpState] = a;
+			for(p=0; p<m_Interp; p++)
+			{
+				a = VecDot(&m_IntpCoef[p][IQDEMOD_INTP_TAPS - m_IntpState], m_IntpZ, IQDEMOD_INTP_TAPS);
+				s = (int)lrintf(a*32767.0f);
+				pOutBuf[n++] = (qint16)( (s > 32767) ? 32767 : ( (s < -32767) ? -32767 : s) );
+			}
+			if(--m_IntpState < 0)
+				m_IntpState += IQDEMOD_INTP_TAPS;
+		}
+	}
+	if(--m_State < 0)
+		m_State += N;
+	return n;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Demodulates one channel filtered sample, returns audio at about
+// AGC_OUT_LEVEL
+/////////////////////////////////////////////////////////////////////
+float CIqDemod::Demod(TYPECPX x)
+{
+float a;
+float c;
+float s;
+double err;
+TYPECPX d;
+	switch(m_Mode)
+	{
+		case DEMOD_MODE_AM:
+		case DEMOD_MODE_WAM:
+			a = sqrtf(x.re*x.re + x.im*x.im);
+			break;
+		case DEMOD_MODE_SAM:
+			//rotate carrier to DC and track its phase
+			c = cosf(m_PllPhase);
+			s = sinf(m_PllPhase);
+			d.re = x.re*c + x.im*s;
+			d.im = x.im*c - x.re*s;
+			err = atan2(d.im, d.re);
+			m_PllFreq += m_PllBeta*err;
+			if(m_PllFreq > K_2PI*PLL_MAX_FREQ/m_DemodRate)
+				m_PllFreq = K_2PI*PLL_MAX_FREQ/m_DemodRate;
+			if(m_PllFreq < -K_2PI*PLL_MAX_FREQ/m_DemodRate)
+				m_PllFreq = -K_2PI*PLL_MAX_FREQ/m_DemodRate;
+			m_PllPhase += m_PllFreq + m_PllAlpha*err;
+			m_PllPhase = fmod(m_PllPhase, K_2PI);
+			a = d.re;
+			break;
+		case DEMOD_MODE_FM:
+		case DEMOD_MODE_WFM:
+			//phase change between samples is the frequency, no AGC
+			d.re = x.re*m_Prev.re + x.im*m_Prev.im;
+			d.im = x.im*m_Prev.re - x.re*m_Prev.im;
+			m_Prev = x;
+			return atan2f(d.im, d.re)*m_FmGain;
+		case DEMOD_MODE_CWU:
+		case DEMOD_MODE_CWL:
+			//beat carrier up to the signed offset pitch
+			a = x.re*cosf(m_NcoPhase) - x.im*sinf(m_NcoPhase);
+			m_NcoPhase = fmod(m_NcoPhase + m_NcoInc, K_2PI);
+			return Agc(a);
+		case DEMOD_MODE_RAW:
+			return 0.0;
+		default:	//sidebands are picked by the channel filter
+			return Agc(x.re);
+	}
+	//AM and SAM carrier level is removed before the AGC
+	m_DcOut = a - m_DcIn + DC_ALPHA*m_DcOut;
+	m_DcIn = a;
+	return Agc(m_DcOut);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Peak envelope AGC with fast attack and Decay mSec release.
+// Below the knee the gain is fixed at m_AgcMaxGain.
+/////////////////////////////////////////////////////////////////////
+float CIqDemod::Agc(float x)
+{
+float ax = fabsf(x);
+float g;
+	if(ax > m_AgcEnv)
+		m_AgcEnv += m_AgcAttack*(ax - m_AgcEnv);
+	else
+		m_AgcEnv *= m_AgcRelease;
+	if(m_AgcEnv <= m_AgcKnee)
+		return x*m_AgcMaxGain;
+	g = AGC_OUT_LEVEL/m_AgcEnv;
+	if(m_AgcSlope)
+		g *= powf(m_AgcEnv/m_AgcKnee, m_AgcSlope/10.0f);
+	return x*g;
+}
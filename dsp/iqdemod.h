@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////
+// iqdemod.h: interface for the CIqDemod class.
+//
+//  Demodulates the raw 8 bit I/Q stream of a receiver channel into
+// 8Ksps audio so a raw stream can be listened to without the server
+// doing the demodulation.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#ifndef IQDEMOD_H
+#define IQDEMOD_H
+
+#include "dsp/datatypes.h"
+#include <QMutex>
+
+#define IQDEMOD_OUTRATE 8000		//audio output rate
+#define IQDEMOD_MAX_TAPS 255		//channel filter taps
+#define IQDEMOD_INTP_TAPS 8			//interpolator taps per phase
+#define IQDEMOD_MAX_INTP 16			//500sps to 8Ksps
+#define IQDEMOD_BLOCK 256			//I/Q samples converted to float at a time
+
+class CIqDemod
+{
+public:
+	CIqDemod();
+
+	void SetSampleRate(int SampleRate);	//raw I/Q rate, 500 to 16000
+	void SetDemodMode(int Mode);
+	void SetDemodFilter(int LowCut, int HighCut, int Offset);
+	void SetAgc(int Slope, int Thresh, int Decay);
+	void Reset();
+	int GetMaxInputLength(int MaxOutput);		//bytes that make at most MaxOutput samples
+	int ProcessData(const qint8* pInBuf, int Length, qint16* pOutBuf);	//returns # 8Ksps samples
+	int ProcessData(const TYPECPX* pInBuf, int Length, qint16* pOutBuf);	//I/Q in raw byte scale
+
+private:
+	void Setup();
+	int ProcessSample(float re, float im, qint16* pOutBuf);
+	float Demod(TYPECPX x);
+	float Agc(float x);
+
+	bool m_SetupChanged;
+	int m_InRate;
+	int m_Decimate;			//channel filter decimation, 2 at 16Ksps else 1
+	int m_DemodRate;
+	int m_Interp;			//audio interpolation up to 8Ksps
+	int m_DecCount;
+	int m_Mode;
+	int m_LowCut;
+	int m_HighCut;
+	int m_Offset;			//CW pitch
+	int m_AgcSlope;
+	int m_AgcThresh;
+	int m_AgcDecay;
+	bool m_RealOnly;		//modes that only need the real part of the channel filter
+	int m_NumTaps;
+	int m_State;
+	int m_IntpState;
+	float m_CoefRe[IQDEMOD_MAX_TAPS*2];	//doubled to avoid buffer wrap tests
+	float m_CoefIm[IQDEMOD_MAX_TAPS*2];
+	float m_ZRe[IQDEMOD_MAX_TAPS];
+	float m_ZIm[IQDEMOD_MAX_TAPS];
+	float m_IntpCoef[IQDEMOD_MAX_INTP][IQDEMOD_INTP_TAPS*2];
+	float m_IntpZ[IQDEMOD_INTP_TAPS];
+	float m_InBuf[IQDEMOD_BLOCK*2];
+	TYPECPX m_Prev;			//FM discriminator
+	double m_NcoPhase;		//CW beat oscillator
+	double m_NcoInc;
+	double m_PllPhase;		//SAM carrier tracking
+	double m_PllFreq;
+	double m_PllAlpha;
+	double m_PllBeta;
+	float m_DcIn;			//AM/SAM DC blocker
+	float m_DcOut;
+	float m_FmGain;
+	float m_AgcEnv;
+	float m_AgcAttack;
+	float m_AgcRelease;
+	float m_AgcKnee;
+	float m_AgcMaxGain;		//gain below the threshold
+	QMutex m_Mutex;		//settings come from GUI thread
+};
+
+#endif // IQDEMOD_H
@@ -0,0 +1,286 @@
+//////////////////////////////////////////////////////////////////////
+// vectorops.cpp: implementation of the block vector math functions.
+//
+// The x86 SSE and AVX versions are compiled with per function target
+// attributes so the rest of the program does not need any special
+// compiler flags. AVX has no 256 bit integer instructions so the AVX
+// set uses the SSE sample format conversions.
+// Float to 16 bit conversion rounds halfway values to even in every
+// set, that is what the SSE and NEON convert instructions do.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "vectorops.h"
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOROPS_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define VECTOROPS_NEON 1
+#include <arm_neon.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+// Plain C versions, always available
+/////////////////////////////////////////////////////////////////////
+static float DotC(const float* pA, const float* pB, int Length)
+{
+float acc = 0.0;
+	for(int i=0; i<Length; i++)
+		acc += pA[i]*pB[i];
+	return acc;
+}
+
+static void S16ToFloatC(const qint16* pIn, float* pOut, int Length)
+{
+	for(int i=0; i<Length; i++)
+		pOut[i] = (float)pIn[i];
+}
+
+static void FloatToS16C(const float* pIn, qint16* pOut, int Length)
+{
+float x;
+	for(int i=0; i<Length; i++)
+	{
+		x = pIn[i];
+		if(x > 32767.0)
+			x = 32767.0;
+		else if(x < -32768.0)
+			x = -32768.0;
+		pOut[i] = (qint16)lrintf(x);	//nearest, halfway to even
+	}
+}
+
+static void S8ToFloatC(const qint8* pIn, float* pOut, int Length)
+{
+	for(int i=0; i<Length; i++)
+		pOut[i] = (float)pIn[i];
+}
+
+static const tVectorOps VECTOROPS_C = {"C", DotC, S16ToFloatC, FloatToS16C, S8ToFloatC};
+
+#ifdef VECTOROPS_X86
+/////////////////////////////////////////////////////////////////////
+// x86 SSE and AVX versions
+/////////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+static float DotSse(const float* pA, const float* pB, int Length)
+{
+int i;
+__m128 acc0 = _mm_setzero_ps();
+__m128 acc1 = _mm_setzero_ps();
+float sum[4];
+	for(i=0; i<=Length-8; i+=8)
+	{
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&pA[i]), _mm_loadu_ps(&pB[i])) );
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&pA[i+4]), _mm_loadu_ps(&pB[i+4])) );
+	}
+	_mm_storeu_ps(sum, _mm_add_ps(acc0, acc1));
+	sum[0] += sum[1] + sum[2] + sum[3];
+	for(; i<Length; i++)
+		sum[0] += pA[i]*pB[i];
+	return sum[0];
+}
+
+__attribute__((target("sse2")))
+static void S16ToFloatSse(const qint16* pIn, float* pOut, int Length)
+{
+int i;
+__m128i x;
+	for(i=0; i<=Length-8; i+=8)
+	{
+		x = _mm_loadu_si128((const __m128i*)&pIn[i]);
+		//sign extend by placing each sample in the top half of a 32 bit word
+		_mm_storeu_ps(&pOut[i], _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)) );
+		_mm_storeu_ps(&pOut[i+4], _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)) );
+	}
+	for(; i<Length; i++)
+		pOut[i] = (float)pIn[i];
+}
+
+__attribute__((target("sse2")))
+static void FloatToS16Sse(const float* pIn, qint16* pOut, int Length)
+{
+int i;
+const __m128 max = _mm_set1_ps(32767.0);
+const __m128 min = _mm_set1_ps(-32768.0);
+__m128i lo;
+__m128i hi;
+	for(i=0; i<=Length-8; i+=8)
+	{
+		//clamp first since out of range floats convert to 0x80000000
+		lo = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(&pIn[i]), max), min));
+		hi = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(&pIn[i+4]), max), min));
+		_mm_storeu_si128((__m128i*)&pOut[i], _mm_packs_epi32(lo, hi));
+	}
+	FloatToS16C(&pIn[i], &pOut[i], Length-i);
+}
+
+__attribute__((target("sse2")))
+static void S8ToFloatSse(const qint8* pIn, float* pOut, int Length)
+{
+int i;
+__m128i x;
+__m128i lo;
+__m128i hi;
+	for(i=0; i<=Length-16; i+=16)
+	{
+		x = _mm_loadu_si128((const __m128i*)&pIn[i]);
+		//sign extend bytes to 16 bits the same way, then 16 to 32 bits
+		lo = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+		hi = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+		_mm_storeu_ps(&pOut[i], _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16)) );
+		_mm_storeu_ps(&pOut[i+4], _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16)) );
+		_mm_storeu_ps(&pOut[i+8], _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16)) );
+		_mm_storeu_ps(&pOut[i+12], _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16)) );
+	}
+	S8ToFloatC(&pIn[i], &pOut[i], Length-i);
+}
+
+__attribute__((target("avx")))
+static float DotAvx(const float* pA, const float* pB, int Length)
+{
+int i;
+__m256 acc0 = _mm256_setzero_ps();
+__m256 acc1 = _mm256_setzero_ps();
+__m128 acc;
+float sum[4];
+	for(i=0; i<=Length-16; i+=16)
+	{
+		acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(&pA[i]), _mm256_loadu_ps(&pB[i])) );
+		acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(&pA[i+8]), _mm256_loadu_ps(&pB[i+8])) );
+	}
+	acc0 = _mm256_add_ps(acc0, acc1);
+	acc = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+	if(i <= Length-8)
+	{
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&pA[i]), _mm_loadu_ps(&pB[i])) );
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&pA[i+4]), _mm_loadu_ps(&pB[i+4])) );
+		i += 8;
+	}
+	_mm_storeu_ps(sum, acc);
+	sum[0] += sum[1] + sum[2] + sum[3];
+	for(; i<Length; i++)
+		sum[0] += pA[i]*pB[i];
+	return sum[0];
+}
+
+static const tVectorOps VECTOROPS_SSE = {"SSE2", DotSse, S16ToFloatSse, FloatToS16Sse, S8ToFloatSse};
+static const tVectorOps VECTOROPS_AVX = {"AVX", DotAvx, S16ToFloatSse, FloatToS16Sse, S8ToFloatSse};
+#endif
+
+#ifdef VECTOROPS_NEON
+/////////////////////////////////////////////////////////////////////
+// ARM NEON versions
+/////////////////////////////////////////////////////////////////////
+static float DotNeon(const float* pA, const float* pB, int Length)
+{
+int i;
+float32x4_t acc0 = vdupq_n_f32(0.0);
+float32x4_t acc1 = vdupq_n_f32(0.0);
+float sum;
+	for(i=0; i<=Length-8; i+=8)
+	{
+		acc0 = vmlaq_f32(acc0, vld1q_f32(&pA[i]), vld1q_f32(&pB[i]));
+		acc1 = vmlaq_f32(acc1, vld1q_f32(&pA[i+4]), vld1q_f32(&pB[i+4]));
+	}
+	sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+	for(; i<Length; i++)
+		sum += pA[i]*pB[i];
+	return sum;
+}
+
+static void S16ToFloatNeon(const qint16* pIn, float* pOut, int Length)
+{
+int i;
+int16x8_t x;
+	for(i=0; i<=Length-8; i+=8)
+	{
+		x = vld1q_s16(&pIn[i]);
+		vst1q_f32(&pOut[i], vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))) );
+		vst1q_f32(&pOut[i+4], vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))) );
+	}
+	for(; i<Length; i++)
+		pOut[i] = (float)pIn[i];
+}
+
+static void FloatToS16Neon(const float* pIn, qint16* pOut, int Length)
+{
+int i;
+int32x4_t lo;
+int32x4_t hi;
+	for(i=0; i<=Length-8; i+=8)
+	{
+		//float to int conversion and narrowing both saturate
+		lo = vcvtnq_s32_f32(vld1q_f32(&pIn[i]));
+		hi = vcvtnq_s32_f32(vld1q_f32(&pIn[i+4]));
+		vst1q_s16(&pOut[i], vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)) );
+	}
+	FloatToS16C(&pIn[i], &pOut[i], Length-i);
+}
+
+static void S8ToFloatNeon(const qint8* pIn, float* pOut, int Length)
+{
+int i;
+int8x16_t x;
+int16x8_t lo;
+int16x8_t hi;
+	for(i=0; i<=Length-16; i+=16)
+	{
+		x = vld1q_s8(&pIn[i]);
+		lo = vmovl_s8(vget_low_s8(x));
+		hi = vmovl_s8(vget_high_s8(x));
+		vst1q_f32(&pOut[i], vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo))) );
+		vst1q_f32(&pOut[i+4], vcvtq_f32_s32(vmovl_s16(vget_high_s16(lo))) );
+		vst1q_f32(&pOut[i+8], vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi))) );
+		vst1q_f32(&pOut[i+12], vcvtq_f32_s32(vmovl_s16(vget_high_s16(hi))) );
+	}
+	S8ToFloatC(&pIn[i], &pOut[i], Length-i);
+}
+
+static const tVectorOps VECTOROPS_NEON = {"NEON", DotNeon, S16ToFloatNeon, FloatToS16Neon, S8ToFloatNeon};
+#endif
+
+/////////////////////////////////////////////////////////////////////
+// Pick the best function set for this CPU.
+// g_pVectorOps starts out pointing at the C versions so it is usable
+// even by code that runs before this file's static initialization.
+/////////////////////////////////////////////////////////////////////
+static bool SelectVectorOps();
+
+const tVectorOps* g_pVectorOps = &VECTOROPS_C;
+static bool g_VectorOpsSelected = SelectVectorOps();
+
+static bool SelectVectorOps()
+{
+#if defined(VECTOROPS_X86)
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports("avx") )
+		g_pVectorOps = &VECTOROPS_AVX;
+	else if( __builtin_cpu_supports("sse2") )
+		g_pVectorOps = &VECTOROPS_SSE;
+#elif defined(VECTOROPS_NEON)
+	g_pVectorOps = &VECTOROPS_NEON;
+#endif
+	return true;
+}
+
+int GetVectorOpsSets(const tVectorOps** pSets, int MaxSets)
+{
+int n = 0;
+	if(n < MaxSets)
+		pSets[n++] = &VECTOROPS_C;
+#if defined(VECTOROPS_X86)
+	__builtin_cpu_init();
+	if( (n < MaxSets) && __builtin_cpu_supports("sse2") )
+		pSets[n++] = &VECTOROPS_SSE;
+	if( (n < MaxSets) && __builtin_cpu_supports("avx") )
+		pSets[n++] = &VECTOROPS_AVX;
+#elif defined(VECTOROPS_NEON)
+	if(n < MaxSets)
+		pSets[n++] = &VECTOROPS_NEON;
+#endif
+	return n;
+}
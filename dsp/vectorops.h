@@ -0,0 +1,50 @@
+//////////////////////////////////////////////////////////////////////
+// vectorops.h: interface for the block vector math functions.
+//
+// Each operation has a plain C version plus SSE, AVX and NEON versions.
+// The fastest set the CPU supports is picked once at startup and
+// called through the g_pVectorOps table.
+//
+// History:
+//	2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#ifndef VECTOROPS_H
+#define VECTOROPS_H
+#include <QtGlobal>
+
+typedef struct
+{
+	const char* Name;
+	float (*Dot)(const float* pA, const float* pB, int Length);
+	void (*S16ToFloat)(const qint16* pIn, float* pOut, int Length);
+	void (*FloatToS16)(const float* pIn, qint16* pOut, int Length);	//rounds half to even and saturates
+	void (*S8ToFloat)(const qint8* pIn, float* pOut, int Length);	//raw I/Q bytes
+}tVectorOps;
+
+extern const tVectorOps* g_pVectorOps;
+
+//Fills pSets with every function set this CPU can run, plain C first and
+//the one g_pVectorOps picked last.  Returns the number of sets.
+int GetVectorOpsSets(const tVectorOps** pSets, int MaxSets);
+
+inline float VecDot(const float* pA, const float* pB, int Length)
+{
+	return g_pVectorOps->Dot(pA, pB, Length);
+}
+
+inline void VecS16ToFloat(const qint16* pIn, float* pOut, int Length)
+{
+	g_pVectorOps->S16ToFloat(pIn, pOut, Length);
+}
+
+inline void VecFloatToS16(const float* pIn, qint16* pOut, int Length)
+{
+	g_pVectorOps->FloatToS16(pIn, pOut, Length);
+}
+
+inline void VecS8ToFloat(const qint8* pIn, float* pOut, int Length)
+{
+	g_pVectorOps->S8ToFloat(pIn, pOut, Length);
+}
+
+#endif // VECTOROPS_H
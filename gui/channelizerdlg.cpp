@@ -0,0 +1,110 @@
+/////////////////////////////////////////////////////////////////////
+// channelizerdlg.cpp: implementation of the CChannelizerDlg class.
+//
+//	This class implements a dialog to set the number of raw I/Q
+// sub-channels and the one to listen to.  Changes take effect at once
+// and the level of every sub-channel is shown as a bar while it is
+// open.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "gui/channelizerdlg.h"
+#include <QPainter>
+
+/////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+/////////////////////////////////////////////////////////////////////
+CChannelizerDlg::CChannelizerDlg(QWidget *parent, CSdrInterface* pSdrInterface) :
+	QDialog(parent), m_pSdrInterface(pSdrInterface)
+{
+	ui.setupUi(this);	//setup the dialog form
+	m_NumChannels = 0;
+	m_NumLevels = 0;
+	connect(ui.comboBoxSize, SIGNAL(activated(int)), this, SLOT(OnSizeChanged(int)));
+	connect(ui.spinBoxMonitor, SIGNAL(valueChanged(int)), this, SLOT(OnMonitorChanged(int)));
+	connect(&m_Timer, SIGNAL(timeout()), this, SLOT(OnTimer()));
+	m_Timer.start(CHANDLG_UPDATE_MSEC);
+}
+
+CChannelizerDlg::~CChannelizerDlg()
+{
+	m_Timer.stop();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Shows the current settings, NumChannels is 0 or a power of 2 and
+// Monitor is -1 for the whole stream.
+/////////////////////////////////////////////////////////////////////
+void CChannelizerDlg::SetChannelizer(int NumChannels, int Monitor)
+{
+int i = 0;
+	while( (i < ui.comboBoxSize->count()-1) && ((2 << i) <= NumChannels) )
+		i++;
+	ui.comboBoxSize->setCurrentIndex(i);
+	m_NumChannels = i ? (1 << i) : 0;
+	ui.spinBoxMonitor->blockSignals(true);
+	ui.spinBoxMonitor->setMaximum(m_NumChannels - 1);
+	ui.spinBoxMonitor->setValue(Monitor);
+	ui.spinBoxMonitor->blockSignals(false);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called when the number of sub-channels is picked, index 0 is off
+// and index i is 2^i sub-channels.
+/////////////////////////////////////////////////////////////////////
+void CChannelizerDlg::OnSizeChanged(int index)
+{
+	m_NumChannels = index ? (1 << index) : 0;
+	if(m_pSdrInterface)
+		m_pSdrInterface->SetChannelizer(m_NumChannels);
+	ui.spinBoxMonitor->setMaximum(m_NumChannels - 1);	//also limits the current value
+	m_NumLevels = 0;
+	update();
+}
+
+void CChannelizerDlg::OnMonitorChanged(int value)
+{
+	if(m_pSdrInterface)
+		m_pSdrInterface->SetChannelizerMonitor(value);
+	update();
+}
+
+void CChannelizerDlg::OnTimer()
+{
+	if(!m_pSdrInterface)
+		return;
+	m_NumLevels = m_pSdrInterface->GetChannelizerLevels(m_Levels, MAX_CHANNELIZER_SIZE);
+	update(ui.frameLevels->geometry());
+}
+
+/////////////////////////////////////////////////////////////////////
+// Draws one bar per sub-channel inside frameLevels, the monitored
+// sub-channel in a different color.
+/////////////////////////////////////////////////////////////////////
+void CChannelizerDlg::paintEvent(QPaintEvent *event)
+{
+QRect r = ui.frameLevels->geometry().adjusted(2, 2, -2, -2);
+int x0;
+int x1;
+int h;
+	QDialog::paintEvent(event);
+	if(m_NumLevels <= 0)
+		return;
+	QPainter painter(this);
+	painter.fillRect(r, Qt::black);
+	for(int i=0; i<m_NumLevels; i++)
+	{
+		h = (int)( (m_Levels[i] - CHANDLG_MIN_DB)*r.height()/(CHANDLG_MAX_DB - CHANDLG_MIN_DB) );
+		if(h < 0)
+			h = 0;
+		if(h > r.height())
+			h = r.height();
+		x0 = r.left() + i*r.width()/m_NumLevels;
+		x1 = r.left() + (i+1)*r.width()/m_NumLevels;
+		if(x1 - x0 > 2)
+			x1--;		//gap between wide bars
+		painter.fillRect(QRect(x0, r.bottom() - h + 1, x1 - x0, h),
+						(i == ui.spinBoxMonitor->value()) ? Qt::yellow : Qt::green);
+	}
+}
@@ -0,0 +1,46 @@
+//////////////////////////////////////////////////////////////////////
+// channelizerdlg.h: interface for the CChannelizerDlg class.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef CHANNELIZERDLG_H
+#define CHANNELIZERDLG_H
+
+#include <QDialog>
+#include <QTimer>
+#include "interface/sdrinterface.h"
+#include "ui_channelizerdlg.h"
+
+#define CHANDLG_UPDATE_MSEC 200		//levels view refresh period
+#define CHANDLG_MAX_DB 0			//top of the levels view in dBFS
+#define CHANDLG_MIN_DB -120			//bottom of the levels view in dBFS
+
+class CChannelizerDlg : public QDialog
+{
+	Q_OBJECT
+public:
+	CChannelizerDlg(QWidget *parent=0, CSdrInterface* pSdrInterface=0);
+	~CChannelizerDlg();
+	void SetChannelizer(int NumChannels, int Monitor);
+	int GetNumChannels(){return m_NumChannels;}
+	int GetMonitor(){return ui.spinBoxMonitor->value();}
+
+protected:
+	void paintEvent(QPaintEvent *event);
+
+private slots:
+	void OnSizeChanged(int index);
+	void OnMonitorChanged(int value);
+	void OnTimer();
+
+private:
+	Ui::DialogChannelizer ui;
+	CSdrInterface* m_pSdrInterface;
+	QTimer m_Timer;
+	int m_NumChannels;		//0 is off
+	int m_NumLevels;		//valid entries in m_Levels
+	float m_Levels[MAX_CHANNELIZER_SIZE];
+};
+
+#endif // CHANNELIZERDLG_H
@@ -0,0 +1,35 @@
+/////////////////////////////////////////////////////////////////////
+// displaydlg.cpp: implementation of the CDisplayDlg class.
+//
+//	This class implements a dialog to set up the local spectrum FFT
+// used in raw I/Q modes.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "gui/displaydlg.h"
+
+/////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+/////////////////////////////////////////////////////////////////////
+CDisplayDlg::CDisplayDlg(QWidget *parent) :	QDialog(parent)
+{
+	ui.setupUi(this);	//setup the dialog form
+}
+
+CDisplayDlg::~CDisplayDlg()
+{
+
+}
+
+/////////////////////////////////////////////////////////////////////
+// Selects the combo box entry for the FFT size, sizes between entries
+// select the next smaller one.
+/////////////////////////////////////////////////////////////////////
+void CDisplayDlg::SetFftSize(int Size)
+{
+int i = 0;
+	while( (i < ui.comboBoxFftSize->count()-1) && ((DISPDLG_MIN_FFTSIZE << (i+1)) <= Size) )
+		i++;
+	ui.comboBoxFftSize->setCurrentIndex(i);
+}
@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////
+// displaydlg.h: interface for the CDisplayDlg class.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef DISPLAYDLG_H
+#define DISPLAYDLG_H
+
+#include <QDialog>
+#include "ui_displaydlg.h"
+
+#define DISPDLG_MIN_FFTSIZE 256		//size of comboBoxFftSize index 0, doubles with each index
+
+class CDisplayDlg : public QDialog
+{
+	Q_OBJECT
+public:
+	CDisplayDlg(QWidget *parent=0);
+	~CDisplayDlg();
+	void SetFftSize(int Size);
+	int GetFftSize(){return DISPDLG_MIN_FFTSIZE << ui.comboBoxFftSize->currentIndex(); }
+	void SetWindow(int x){ui.comboBoxWindow->setCurrentIndex(x); }
+	int GetWindow(){return ui.comboBoxWindow->currentIndex(); }
+	void SetOverlap(int x){ui.spinBoxOverlap->setValue(x); }
+	int GetOverlap(){return ui.spinBoxOverlap->value(); }
+
+private:
+	Ui::DialogDisplay ui;
+};
+
+#endif // DISPLAYDLG_H
@@ -53,6 +53,15 @@ public:
 		path = ui->lineEditListServerActionPath->text();
 	}
 
+	void SetTxCoalesceTime(int mSec)
+	{
+		ui->spinBoxCoalesce->setValue(mSec);
+	}
+	int GetTxCoalesceTime()
+	{
+		return ui->spinBoxCoalesce->value();
+	}
+
 	void SetPasswords(QString rxpw, QString txpw)
 	{
 		ui->lineEditRxPw->setText(rxpw);
@@ -0,0 +1,253 @@
+//////////////////////////////////////////////////////////////////////
+// glplotter.cpp: implementation of the CGlPlotter class.
+//
+//  OpenGL surface that draws the CPlotter 2D overlay, spectrum trace
+// and waterfall.  Each new waterfall line is one glTexSubImage2D of
+// width bytes into a circular luminance texture.  The fragment shader
+// wraps the rows at the newest line and maps values through a 256x1
+// palette texture so nothing is scrolled or colored on the CPU.
+//
+// History:
+//  2026-10-17  Initial creation
+//////////////////////////////////////////////////////////////////////
+#include "gui/glplotter.h"
+#include <QPainter>
+#include <QOpenGLContext>
+#include <QDebug>
+#include <string.h>
+
+static const char* WF_VERTEX_SHADER =
+    "attribute highp vec2 a_Pos;\n"
+    "varying highp vec2 v_Tex;\n"
+    "void main()\n"
+    "{\n"
+    "    v_Tex = vec2(a_Pos.x*0.5 + 0.5, 0.5 - a_Pos.y*0.5);\n"   // y is 0 at top line
+    "    gl_Position = vec4(a_Pos, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* WF_FRAGMENT_SHADER =
+    "#ifdef GL_ES\n"
+    "precision mediump float;\n"
+    "#endif\n"
+    "uniform sampler2D u_Lines;\n"
+    "uniform sampler2D u_Palette;\n"
+    "uniform float u_Top;\n"            // newest row / number of rows
+    "varying vec2 v_Tex;\n"
+    "void main()\n"
+    "{\n"
+    "    float v = texture2D(u_Lines, vec2(v_Tex.x, fract(u_Top + v_Tex.y))).r;\n"
+    "    gl_FragColor = texture2D(u_Palette, vec2((v*255.0 + 0.5)/256.0, 0.5));\n"
+    "}\n";
+
+static const GLfloat QUAD_VERTICES[8] = { -1.0f, -1.0f,  1.0f, -1.0f,  -1.0f, 1.0f,  1.0f, 1.0f };
+
+CGlPlotter::CGlPlotter(QWidget *parent) : QOpenGLWidget(parent)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);     // CPlotter gets all mouse events
+    m_Initialized = false;
+    m_TexturesValid = false;
+    m_PaletteChanged = true;
+    m_WfWidth = 0;
+    m_WfHeight = 0;
+    m_WfTop = 0;
+    m_LineTexture = 0;
+    m_PaletteTexture = 0;
+    m_TraceColor = QColor(48, 48, 255, 255);
+    for (int i = 0; i < 256; i++)
+        m_Palette[i] = qRgb(i, i, i);
+}
+
+CGlPlotter::~CGlPlotter()
+{
+    if (m_Initialized)
+    {
+        makeCurrent();
+        glDeleteTextures(1, &m_LineTexture);
+        glDeleteTextures(1, &m_PaletteTexture);
+        doneCurrent();
+    }
+}
+
+void CGlPlotter::SetPalette(const QRgb* pColorTbl)
+{
+    memcpy(m_Palette, pColorTbl, sizeof(m_Palette));
+    m_PaletteChanged = true;
+    update();
+}
+
+// Called when the plot size changes, clears the waterfall
+void CGlPlotter::SetWaterfallSize(int Width, int Height)
+{
+    m_WfWidth = Width;
+    m_WfHeight = Height;
+    m_WfTop = 0;
+    m_PendingRows.clear();
+    m_PendingData.clear();
+    m_TexturesValid = false;
+    update();
+}
+
+// Called when the grid and text overlay of the 2D area is redrawn.
+// QPainter caches the pixmap as a texture until it changes.
+void CGlPlotter::SetOverlay(const QPixmap& Overlay)
+{
+    m_Overlay = Overlay;
+    update();
+}
+
+void CGlPlotter::SetTrace(const QPoint* pPoints, int Length, const QColor& Color)
+{
+    m_Trace.resize(Length);
+    memcpy(m_Trace.data(), pPoints, Length*sizeof(QPoint));
+    m_TraceColor = Color;
+    update();
+}
+
+void CGlPlotter::ClearTrace()
+{
+    m_Trace.clear();
+    update();
+}
+
+// Called with each new waterfall line.  It is held until the next
+// paintGL() when the GL context is current.
+void CGlPlotter::AddLine(const quint8* pData, int Length)
+{
+    if ((m_WfWidth <= 0) || (m_WfHeight <= 0))
+        return;
+    if (Length > m_WfWidth)
+        Length = m_WfWidth;
+    // new line goes in the ring just above the current top line
+    if (--m_WfTop < 0)
+        m_WfTop = m_WfHeight - 1;
+    if (m_PendingRows.size() >= m_WfHeight)
+    {   // oldest pending row is overwritten anyway
+        m_PendingRows.removeFirst();
+        m_PendingData.remove(0, m_WfWidth);
+    }
+    m_PendingRows.append(m_WfTop);
+    m_PendingData.append((const char*)pData, Length);
+    if (Length < m_WfWidth)
+        m_PendingData.append(QByteArray(m_WfWidth - Length, 0));
+    update();
+}
+
+void CGlPlotter::initializeGL()
+{
+    if (!context() || !context()->isValid())
+    {
+        qDebug() << "GL plotter has no valid context";
+        emit InitFailed();
+        return;
+    }
+    initializeOpenGLFunctions();
+    m_Program.addShaderFromSourceCode(QOpenGLShader::Vertex, WF_VERTEX_SHADER);
+    m_Program.addShaderFromSourceCode(QOpenGLShader::Fragment, WF_FRAGMENT_SHADER);
+    m_Program.bindAttributeLocation("a_Pos", 0);
+    if (!m_Program.link())
+    {
+        qDebug() << "GL plotter shader error" << m_Program.log();
+        emit InitFailed();
+        return;
+    }
+    glGenTextures(1, &m_LineTexture);
+    glGenTextures(1, &m_PaletteTexture);
+    m_Initialized = true;
+    m_TexturesValid = false;
+    m_PaletteChanged = true;
+}
+
+// Called with the context current to size the line texture to the
+// waterfall and clear it.  Non power of 2 sizes need CLAMP and NEAREST
+// on ES 2.0, the shader does the row wrap so REPEAT is not needed.
+void CGlPlotter::CreateTextures()
+{
+    QByteArray zero(m_WfWidth*m_WfHeight, 0);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, m_LineTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, m_WfWidth, m_WfHeight, 0,
+                 GL_LUMINANCE, GL_UNSIGNED_BYTE, zero.constData());
+    m_TexturesValid = true;
+}
+
+// Called with the context current to upload the pending waterfall rows
+// and the palette if it changed.
+void CGlPlotter::UploadLines()
+{
+    quint8 rgba[256*4];
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (m_PaletteChanged)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            rgba[i*4] = qRed(m_Palette[i]);
+            rgba[i*4+1] = qGreen(m_Palette[i]);
+            rgba[i*4+2] = qBlue(m_Palette[i]);
+            rgba[i*4+3] = 255;
+        }
+        glBindTexture(GL_TEXTURE_2D, m_PaletteTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+        m_PaletteChanged = false;
+    }
+    glBindTexture(GL_TEXTURE_2D, m_LineTexture);
+    for (int i = 0; i < m_PendingRows.size(); i++)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_PendingRows[i], m_WfWidth, 1,
+                        GL_LUMINANCE, GL_UNSIGNED_BYTE, m_PendingData.constData() + i*m_WfWidth);
+    m_PendingRows.clear();
+    m_PendingData.clear();
+}
+
+void CGlPlotter::paintGL()
+{
+    int dpr = devicePixelRatio();
+
+    if (!m_Initialized)
+        return;
+    QPainter painter(this);
+    painter.beginNativePainting();
+    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    if ((m_WfWidth > 0) && (m_WfHeight > 0))
+    {
+        if (!m_TexturesValid)
+            CreateTextures();
+        UploadLines();
+        // waterfall is the bottom m_WfHeight lines of the widget
+        glViewport(0, 0, m_WfWidth*dpr, m_WfHeight*dpr);
+        m_Program.bind();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_LineTexture);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_PaletteTexture);
+        m_Program.setUniformValue("u_Lines", 0);
+        m_Program.setUniformValue("u_Palette", 1);
+        m_Program.setUniformValue("u_Top", (GLfloat)m_WfTop/(GLfloat)m_WfHeight);
+        m_Program.enableAttributeArray(0);
+        m_Program.setAttributeArray(0, GL_FLOAT, QUAD_VERTICES, 2);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_Program.disableAttributeArray(0);
+        m_Program.release();
+        glActiveTexture(GL_TEXTURE0);
+        glViewport(0, 0, width()*dpr, height()*dpr);
+    }
+    painter.endNativePainting();
+
+    // 2D area is the overlay with the trace drawn on top
+    painter.drawPixmap(0, 0, m_Overlay);
+    if (!m_Trace.isEmpty())
+    {
+        painter.translate(0.5, 0.5);
+        painter.setPen(m_TraceColor);
+        painter.drawPolyline(m_Trace.constData(), m_Trace.size());
+    }
+}
@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////
+// glplotter.h: interface for the CGlPlotter class.
+//
+//  OpenGL render surface for CPlotter.  It covers the plotter and is
+// transparent for mouse events so CPlotter keeps all mouse/wheel
+// handling and signals.  Waterfall lines go into a circular 8 bit
+// texture and the palette lookup and scrolling are done in a shader.
+//  Only needs OpenGL 2.0/ES 2.0 so runs on Mesa llvmpipe.
+//
+// History:
+//  2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef GLPLOTTER_H
+#define GLPLOTTER_H
+
+#include <QOpenGLWidget>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QPixmap>
+#include <QVector>
+#include <QList>
+#include <QByteArray>
+
+class CGlPlotter : public QOpenGLWidget, protected QOpenGLFunctions
+{
+    Q_OBJECT
+public:
+    explicit CGlPlotter(QWidget *parent = 0);
+    ~CGlPlotter();
+
+    void SetPalette(const QRgb* pColorTbl);
+    void SetWaterfallSize(int Width, int Height);   // waterfall is at the bottom of the widget
+    void SetOverlay(const QPixmap& Overlay);
+    void SetTrace(const QPoint* pPoints, int Length, const QColor& Color);
+    void ClearTrace();
+    void AddLine(const quint8* pData, int Length);
+
+signals:
+    void InitFailed();      // no usable context or shaders, CPlotter falls back to QPainter
+
+protected:
+    void initializeGL();
+    void paintGL();
+
+private:
+    void CreateTextures();
+    void UploadLines();
+
+    bool m_Initialized;
+    bool m_TexturesValid;       // false when textures must be (re)created
+    bool m_PaletteChanged;
+    int m_WfWidth;
+    int m_WfHeight;
+    int m_WfTop;                // texture row of newest waterfall line
+    GLuint m_LineTexture;
+    GLuint m_PaletteTexture;
+    QRgb m_Palette[256];
+    QList<int> m_PendingRows;   // rows added since last paint
+    QByteArray m_PendingData;   // m_WfWidth bytes per pending row
+    QPixmap m_Overlay;
+    QVector<QPoint> m_Trace;
+    QColor m_TraceColor;
+    QOpenGLShaderProgram m_Program;
+};
+
+#endif // GLPLOTTER_H
@@ -68,9 +68,13 @@
 #include "ui_mainwindow.h"
 #include "editnetdlg.h"
 #include "sounddlg.h"
+#include "displaydlg.h"
+#include "channelizerdlg.h"
 #include "transmitdlg.h"
 #include "interface/sdrprotocol.h"
 #include <QDebug>
+#include <QActionGroup>
+#include <QFileDialog>
 #include <QList>
 #include <QMessageBox>
 #include <QSpinBox>
@@ -83,6 +87,26 @@
 
 #define DEFAULT_UNITS   UNITS_NONE
 
+//modes in the Local Demod menu, Off is mode -1
+static const struct
+{
+	const char* Name;
+	int Mode;
+} LOCAL_DEMOD_MODES[] =
+{
+	{"Off", -1},
+	{"AM", DEMOD_MODE_AM},
+	{"SAM", DEMOD_MODE_SAM},
+	{"WAM", DEMOD_MODE_WAM},
+	{"FM", DEMOD_MODE_FM},
+	{"WFM", DEMOD_MODE_WFM},
+	{"USB", DEMOD_MODE_USB},
+	{"LSB", DEMOD_MODE_LSB},
+	{"DSB", DEMOD_MODE_DSB},
+	{"CWL", DEMOD_MODE_CWL},
+	{"CWU", DEMOD_MODE_CWU}
+};
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -117,6 +141,9 @@ MainWindow::MainWindow(QWidget *parent) :
 	m_pMemDialog->Init(m_MemoryFilePath);
 
     m_TxActive = false;
+	m_LastFramesRendered = 0;
+	m_LastFramesMerged = 0;
+	m_AudioRecordChannel = 0;
 	//create CSdrInterface and connect its signals
 	m_pSdrInterface = new CSdrInterface(this);
 	//give GUI plotter access to the sdr interface object pointer
@@ -127,6 +154,10 @@ MainWindow::MainWindow(QWidget *parent) :
 	connect(m_pSdrInterface, SIGNAL(NewSMeterValue(qint16)), this, SLOT(NewSMeterValue(qint16)));
 	connect(m_pSdrInterface, SIGNAL(NewVideoData()), this, SLOT(OnNewVideoData()));
 	connect(m_pSdrInterface, SIGNAL(NewFftAvePwr(qint16)), this, SLOT(OnNewFftAvePwr(qint16)));
+	connect(m_pSdrInterface, SIGNAL(NewRxChannelCount(int)), this, SLOT(OnNewRxChannelCount(int)));
+	connect(m_pSdrInterface->GetIqRecorder(), SIGNAL(RecordingFailed(QString)), this, SLOT(OnIqRecordFailed(QString)));
+	for(int i=0; i<MAX_RX_CHANNELS; i++)
+		connect(m_pSdrInterface->GetAudioRecorder(i), SIGNAL(RecordingFailed(QString)), this, SLOT(OnAudioRecordFailed(QString)));
 
 #ifndef ENABLE_CODEC2
     ui->fdvModeSel->setEnabled(false);
@@ -143,8 +174,16 @@ MainWindow::MainWindow(QWidget *parent) :
 	connect(ui->actionExit, SIGNAL(triggered()), this, SLOT(OnExit()));
 	connect(ui->actionNetwork, SIGNAL(triggered()), this, SLOT(OnNetworkDlg()));
 	connect(ui->actionSoundCard, SIGNAL(triggered()), this, SLOT(OnSoundCardDlg()));
+	connect(ui->actionDisplay, SIGNAL(triggered()), this, SLOT(OnDisplayDlg()));
+	connect(ui->actionChannelizer, SIGNAL(triggered()), this, SLOT(OnChannelizerDlg()));
 	connect(ui->actionTransmit, SIGNAL(triggered()), this, SLOT(OnTransmitDlg()));
 	connect(ui->actionStayOnTop, SIGNAL(triggered()), this, SLOT(StayOnTop()));
+	connect(ui->actionOpenGlPlot, SIGNAL(triggered()), this, SLOT(OnOpenGlPlot()));
+	connect(ui->actionLocalFft, SIGNAL(triggered()), this, SLOT(OnLocalFft()));
+	CreateLocalDemodMenu();
+	connect(ui->framePlot, SIGNAL(OpenGlFailed()), this, SLOT(OnOpenGlFailed()));
+	connect(ui->actionRecordIq, SIGNAL(triggered()), this, SLOT(OnRecordIq()));
+	connect(ui->actionRecordAudio, SIGNAL(triggered()), this, SLOT(OnRecordAudio()));
     connect(ui->actionNcoNull, SIGNAL(triggered()), this, SLOT(OnNullNco()));
 	connect(ui->actionAbout, SIGNAL(triggered()), this, SLOT(OnAbout()));
 	connect(ui->frameThresh, SIGNAL(sliderValChanged(int)), this, SLOT(OnAgcThresh(int)));
@@ -272,6 +311,8 @@ MainWindow::MainWindow(QWidget *parent) :
 	ui->frameMeter->SetSquelchPos( m_DemodSettings[m_DemodMode].SquelchValue );
     ui->frameMeter->SetdBmLevel( -120.0, false );
 	m_pSdrInterface->SetVolume(m_Volume);
+	m_pSdrInterface->SetAudioLatencyProfile(m_LatencyProfile);
+	m_pSdrInterface->SetTxCoalesceTime(m_TxCoalesceTime);
 
     SetDemodSelector(m_DemodMode);
 
@@ -286,7 +327,19 @@ MainWindow::MainWindow(QWidget *parent) :
 	m_pTimer->start(1000);		//start up status timer
 
 	ui->actionStayOnTop->setChecked(m_StayOnTop);
+	ui->actionRecordGated->setChecked(m_AudioRecordGated);
 	StayOnTop();
+	ui->actionOpenGlPlot->setChecked(m_OpenGlPlot);
+#ifndef ENABLE_OPENGL
+	ui->actionOpenGlPlot->setEnabled(false);
+#endif
+	ui->framePlot->SetOpenGl(m_OpenGlPlot);
+	m_pSdrInterface->SetupLocalFft(m_LocalFftSize, m_LocalFftWindow, m_LocalFftOverlap);
+	ui->actionLocalFft->setChecked(m_LocalFft);
+	m_pSdrInterface->SetLocalFft(m_LocalFft);
+	UpdateLocalDemod();
+	m_pSdrInterface->SetChannelizer(m_ChannelizerSize);
+	m_pSdrInterface->SetChannelizerMonitor(m_ChannelizerMonitor);
 
 	if(DEMOD_MODE_DIG == m_DemodMode)
 		SetChatDialogState(true);
@@ -360,6 +413,191 @@ void MainWindow::StayOnTop()
 #endif
 }
 
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//OpenGL Spectrum Plot menu, switches the plotter drawing method
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnOpenGlPlot()
+{
+	m_OpenGlPlot = ui->actionOpenGlPlot->isChecked();
+	ui->framePlot->SetOpenGl(m_OpenGlPlot);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by the plotter when OpenGL cannot be used and it has gone
+// back to QPainter drawing
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnOpenGlFailed()
+{
+	m_OpenGlPlot = false;
+	ui->actionOpenGlPlot->setChecked(false);
+	QMessageBox::warning(this, "OpenGL Spectrum Plot",
+						"OpenGL could not be used, the spectrum plot is drawn without it.");
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called after connecting when the server reports how many receiver
+// channels it has.  The RxAudioChannel setting picks the channel sent to
+// the sound card, each RxMonitorChannels entry "channel:pan:frequency"
+// mixes in another channel, pan is -100(left) to 100(right).  Channels
+// given a frequency are tuned with the current demod settings.
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnNewRxChannelCount(int Count)
+{
+int chan;
+int pan;
+tDemodInfo* pDemod = &m_DemodSettings[m_DemodMode];
+	for(int i=0; i<m_RxMonitorChannels.size(); i++)
+	{
+		QStringList parms = m_RxMonitorChannels[i].split(':');
+		chan = parms[0].toInt();
+		if( (chan <= 0) || (chan >= Count) )
+			continue;
+		pan = (parms.size() > 1) ? parms[1].toInt() : 0;
+		if(parms.size() > 2)
+		{
+			m_pSdrInterface->SetDemodMode(m_DemodMode, chan);
+			if(DEMOD_MODE_RAW == m_DemodMode)
+				m_pSdrInterface->SetAudioCompressionMode(m_RawRateIndex + COMP_MODE_RAW_16000, chan);
+			else
+				m_pSdrInterface->SetAudioCompressionMode(m_AudioCompressionIndex, chan);
+			m_pSdrInterface->SetAgc(0, pDemod->AgcThresh, pDemod->AgcDecay, chan);
+			m_pSdrInterface->SetSquelchThreshold(pDemod->SquelchValue, chan);
+			m_pSdrInterface->SetDemodFilter(pDemod->LowCut, pDemod->HiCut, pDemod->Offset, chan);
+			m_pSdrInterface->SetVolume(m_Volume, chan);
+			m_pSdrInterface->SetRxFrequency(parms[2].toLongLong(), chan);
+		}
+		m_pSdrInterface->SetRxChannelMonitor(chan, true, pan);
+	}
+	if( (m_RxAudioChannel > 0) && (m_RxAudioChannel < Count) )
+		m_pSdrInterface->SetRxAudioChannel(m_RxAudioChannel);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//Local Spectrum menu, FFT size, window and overlap are set with
+//the Setup/Local Spectrum dialog
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnLocalFft()
+{
+	m_LocalFft = ui->actionLocalFft->isChecked();
+	m_pSdrInterface->SetLocalFft(m_LocalFft);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Builds the File/Local Demod submenu with one checkable entry per
+// mode, the checked one is m_LocalDemodMode.
+/////////////////////////////////////////////////////////////////////
+void MainWindow::CreateLocalDemodMenu()
+{
+QMenu* pMenu = new QMenu("Local Demod In Raw I/Q Modes", this);
+QActionGroup* pGroup = new QActionGroup(this);
+QAction* pAction;
+	pMenu->setToolTip("Demodulate raw I/Q here so it can be listened to");
+	for(int i=0; i<(int)(sizeof(LOCAL_DEMOD_MODES)/sizeof(LOCAL_DEMOD_MODES[0])); i++)
+	{
+		pAction = pMenu->addAction(LOCAL_DEMOD_MODES[i].Name);
+		pAction->setCheckable(true);
+		pAction->setData(LOCAL_DEMOD_MODES[i].Mode);
+		pAction->setChecked(LOCAL_DEMOD_MODES[i].Mode == m_LocalDemodMode);
+		pGroup->addAction(pAction);
+	}
+	ui->menuFile->insertMenu(ui->actionRecordIq, pMenu);
+	connect(pGroup, SIGNAL(triggered(QAction*)), this, SLOT(OnLocalDemod(QAction*)));
+}
+
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//Local Demod menu, the local demod uses the filter and AGC settings
+//of its mode
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnLocalDemod(QAction* pAction)
+{
+	m_LocalDemodMode = pAction->data().toInt();
+	UpdateLocalDemod();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//Record Raw I/Q menu, asks for the recording name when checked
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnRecordIq()
+{
+	if( !ui->actionRecordIq->isChecked() )
+	{
+		m_pSdrInterface->StopIqRecording();
+		return;
+	}
+	QString name = QFileDialog::getSaveFileName(this, "Record Raw I/Q", m_IqRecordPath,
+									"SigMF recordings (*.sigmf-data)");
+	if( name.isEmpty() )
+	{
+		ui->actionRecordIq->setChecked(false);
+		return;
+	}
+	if( name.endsWith(".sigmf-data") )
+		name.chop(11);
+	m_IqRecordPath = name;
+	m_pSdrInterface->StartIqRecording(name);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by the I/Q recorder thread when a file cannot be opened or
+// written and the recording has stopped
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnIqRecordFailed(QString Reason)
+{
+	ui->actionRecordIq->setChecked(false);
+	QMessageBox::warning(this, "Record Raw I/Q", "I/Q recording stopped.\n" + Reason);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by an audio recorder thread when a file cannot be opened or
+// written and the recording has stopped
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnAudioRecordFailed(QString Reason)
+{
+	ui->actionRecordAudio->setChecked(false);
+	QMessageBox::warning(this, "Record Audio", "Audio recording stopped.\n" + Reason);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//Record Audio menu, asks for the file name when checked.  Records the
+//channel being listened to when recording starts.
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnRecordAudio()
+{
+int format = AUDIOREC_FORMAT_WAV;
+QString filter = "WAV files (*.wav)";
+	if( !ui->actionRecordAudio->isChecked() )
+	{
+		m_pSdrInterface->StopAudioRecording(m_AudioRecordChannel);
+		return;
+	}
+	if( CAudioRecorder::IsFlacSupported() )
+		filter += ";;FLAC files (*.flac)";
+	QString name = QFileDialog::getSaveFileName(this, "Record Audio", m_AudioRecordPath, filter);
+	if( name.isEmpty() )
+	{
+		ui->actionRecordAudio->setChecked(false);
+		return;
+	}
+	if( name.endsWith(".flac") )
+	{
+		format = AUDIOREC_FORMAT_FLAC;
+		name.chop(5);
+	}
+	else if( name.endsWith(".wav") )
+	{
+		name.chop(4);
+	}
+	m_AudioRecordPath = name;
+	m_AudioRecordGated = ui->actionRecordGated->isChecked();
+	m_AudioRecordChannel = m_pSdrInterface->GetRxAudioChannel();
+	m_pSdrInterface->StartAudioRecording(m_AudioRecordChannel, name, format, m_AudioRecordGated);
+}
+
 /////////////////////////////////////////////////////////////////////
 // Menu Bar action item handler.
 //Exit menu
@@ -380,6 +618,16 @@ void MainWindow::writeSettings()
 	settings.setValue("geometry", saveGeometry());
 	settings.setValue("minstate",isMinimized());
 	settings.setValue("StayOnTop",m_StayOnTop);
+	settings.setValue("OpenGlPlot",m_OpenGlPlot);
+	settings.setValue("LocalFft",m_LocalFft);
+	settings.setValue("LocalFftSize",m_LocalFftSize);
+	settings.setValue("LocalFftWindow",m_LocalFftWindow);
+	settings.setValue("LocalFftOverlap",m_LocalFftOverlap);
+	settings.setValue("LocalDemodMode",m_LocalDemodMode);
+	settings.setValue("ChannelizerSize",m_ChannelizerSize);
+	settings.setValue("ChannelizerMonitor",m_ChannelizerMonitor);
+	settings.setValue("RxAudioChannel",m_RxAudioChannel);
+	settings.setValue("RxMonitorChannels",m_RxMonitorChannels);
 
 	if( m_pMemDialog->isVisible() )
 		m_MemDialogRect = m_pMemDialog->geometry();
@@ -398,13 +646,19 @@ void MainWindow::writeSettings()
 	settings.setValue("Port",m_Port);
 	settings.setValue("sndin",m_SoundInIndex);
 	settings.setValue("sndout",m_SoundOutIndex);
+	settings.setValue("LatencyProfile",m_LatencyProfile);
 	settings.setValue("RxPassword", m_RxPassword);
 	settings.setValue("TxPassword", m_TxPassword);
 	settings.setValue("DomainName", m_DomainName);
 	settings.setValue("ClientDesc",m_ClientDesc);
+	settings.setValue("TxCoalesceTime",m_TxCoalesceTime);
 	settings.setValue("ListServer", m_ListServer);
 	settings.setValue("ListServerActionPath", m_ListServerActionPath);
 	settings.setValue("MemoryFilePath", m_MemoryFilePath);
+	settings.setValue("IqRecordPath", m_IqRecordPath);
+	settings.setValue("AudioRecordPath", m_AudioRecordPath);
+	m_AudioRecordGated = ui->actionRecordGated->isChecked();
+	settings.setValue("AudioRecordGated", m_AudioRecordGated);
 	settings.setValue("CenterFrequency",m_RxCenterFrequency);
 	settings.setValue("TxCenterFrequency",m_TxCenterFrequency);
 
@@ -478,6 +732,16 @@ void MainWindow::readSettings()
 	restoreGeometry(geometry);
     bool ismin = settings.value("minstate", false).toBool();
     m_StayOnTop = settings.value("StayOnTop", false).toBool();
+	m_OpenGlPlot = settings.value("OpenGlPlot", false).toBool();
+	m_LocalFft = settings.value("LocalFft", false).toBool();
+	m_LocalFftSize = settings.value("LocalFftSize", IQSPEC_DEFAULT_FFTSIZE).toInt();
+	m_LocalFftWindow = settings.value("LocalFftWindow", IQSPEC_WINDOW_HANN).toInt();
+	m_LocalFftOverlap = settings.value("LocalFftOverlap", 50).toInt();
+	m_LocalDemodMode = settings.value("LocalDemodMode", -1).toInt();
+	m_ChannelizerSize = settings.value("ChannelizerSize", 0).toInt();
+	m_ChannelizerMonitor = settings.value("ChannelizerMonitor", -1).toInt();
+	m_RxAudioChannel = settings.value("RxAudioChannel", 0).toInt();
+	m_RxMonitorChannels = settings.value("RxMonitorChannels").toStringList();
 
 	m_MemDialogRect = settings.value(tr("MemDialogRect"), QRect(10,10,500,200)).toRect();
 	if( (m_MemDialogRect.x()<=0) ||  (m_MemDialogRect.y()<=0) )
@@ -496,13 +760,18 @@ void MainWindow::readSettings()
 	m_Port = settings.value("Port", 50000).toUInt();
 	m_SoundInIndex = settings.value("sndin", 0).toInt();
 	m_SoundOutIndex = settings.value("sndout", 0).toInt();
+	m_LatencyProfile = settings.value("LatencyProfile", DEFAULT_LATENCY_PROFILE).toInt();
 	m_RxPassword = settings.value("RxPassword","").toString();
 	m_TxPassword = settings.value("TxPassword","password").toString();
 	m_DomainName = settings.value("DomainName","").toString();
 	m_ClientDesc = settings.value("ClientDesc","").toString();
+	m_TxCoalesceTime = settings.value("TxCoalesceTime", TX_COALESCE_TIME).toInt();
     m_ListServer = settings.value("ListServer","sdranywhere.com").toString();
     m_ListServerActionPath = settings.value("ListServerActionPath","/cloud/get.py").toString();
 	m_MemoryFilePath =  settings.value("MemoryFilePath","").toString();
+	m_IqRecordPath = settings.value("IqRecordPath","").toString();
+	m_AudioRecordPath = settings.value("AudioRecordPath","").toString();
+	m_AudioRecordGated = settings.value("AudioRecordGated", false).toBool();
 	m_TxCenterFrequency = settings.value("TxCenterFrequency", 10000000).toLongLong();
 	m_TxSpanFreq = settings.value("TxSpanFreq",15000).toInt();
 	m_CtcssFreq = settings.value("CtcssFreq",0).toInt();
@@ -601,6 +870,8 @@ void MainWindow::OnAbout()
 void MainWindow::OnTimer()
 {
 int count;
+quint32 rendered = ui->framePlot->GetFramesRendered();
+quint32 merged = ui->framePlot->GetFramesMerged();
 	switch(m_pSdrInterface->m_SdrStatus)
 	{
 		case SDR_RECEIVING:
@@ -608,7 +879,22 @@ int count;
 			count = m_pSdrInterface->GetDataLatency();
 			m_Str = "Connected to " + m_pSdrInterface->m_ServerName +
 					" SN=" + m_pSdrInterface->m_SerialNumStr +
-					" (" + QString::number(count) + "mSec)";
+					" (" + QString::number(count) + "mSec)" +
+					" Audio Delay " + QString::number(m_pSdrInterface->GetAudioOutputDelay()) + "mSec" +
+					" Plot " + QString::number(rendered - m_LastFramesRendered) + "fps (" +
+					QString::number(merged - m_LastFramesMerged) + " merged " +
+					QString::number(ui->framePlot->GetFramesDropped()) + " dropped " +
+					QString::number(ui->framePlot->GetRenderTime()) + "/" +
+					QString::number(ui->framePlot->GetPaintTime()) + "uSec)" +
+					" Net Rx " + QString::number(m_pSdrInterface->GetRxTotalBytes()/1000000) + "MB " +
+					QString::number(m_pSdrInterface->GetRxReadsPerSec()) + " reads/s " +
+					QString::number(m_pSdrInterface->GetRxAveReadSize()) + " B/read" +
+					" Tx " + QString::number(m_pSdrInterface->GetTxMsgsPerWrite(), 'f', 1) + " msgs/write " +
+					QString::number(m_pSdrInterface->GetTxCollapsedCount()) + " collapsed " +
+					QString::number(m_pSdrInterface->GetTxDropCount()) + " dropped";
+			if( m_pSdrInterface->GetIqRecorder()->IsRecording() )
+				m_Str += " IQ Rec " + QString::number(m_pSdrInterface->GetIqRecorder()->GetBytesWritten()/1000000) + "MB " +
+						QString::number(m_pSdrInterface->GetIqRecorder()->GetBlocksDropped()) + " blocks dropped";
 			m_pSdrInterface->SendKeepalive();
 			break;
 		case SDR_CONNECTING:
@@ -633,6 +919,8 @@ int count;
 			break;
 	}
 	statusBar()->showMessage(m_Str,0);
+	m_LastFramesRendered = rendered;
+	m_LastFramesMerged = merged;
 
 #ifdef ENABLE_CODEC2
     QString     snr_str;
@@ -702,6 +990,7 @@ qDebug()<<"Sdr Idle";
 			m_pSdrInterface->SetDemodFilter(m_DemodSettings[m_DemodMode].LowCut,
 											m_DemodSettings[m_DemodMode].HiCut,
 											m_DemodSettings[m_DemodMode].Offset);
+			UpdateLocalDemod();
 
 			if(m_DemodSettings[m_DemodMode].AudioFilter)
 				m_pSdrInterface->SetAudioFilter(RX_AUDIOFILTER_CTCSS);
@@ -795,6 +1084,7 @@ CEditNetDlg dlg(this);
 	dlg.SetListServer(m_ListServer);
 	dlg.SetListServerActionPath(m_ListServerActionPath);
 	dlg.SetClientDesc(m_ClientDesc);
+	dlg.SetTxCoalesceTime(m_TxCoalesceTime);
 	dlg.InitDlg();
 	if( dlg.exec() )
 	{
@@ -805,6 +1095,8 @@ CEditNetDlg dlg(this);
 		dlg.GetListServer(m_ListServer);
 		dlg.GetListServerActionPath(m_ListServerActionPath);
 		dlg.GetClientDesc(m_ClientDesc);
+		m_TxCoalesceTime = dlg.GetTxCoalesceTime();
+		m_pSdrInterface->SetTxCoalesceTime(m_TxCoalesceTime);
 	}
 }
 
@@ -817,13 +1109,48 @@ void MainWindow::OnSoundCardDlg()
 CSoundDlg dlg(this);
 	dlg.SetInputIndex(m_SoundInIndex);
 	dlg.SetOutputIndex(m_SoundOutIndex);
+	dlg.SetLatencyProfile(m_LatencyProfile);
 	if(QDialog::Accepted == dlg.exec() )
 	{
 		m_SoundInIndex = dlg.GetInputIndex();
 		m_SoundOutIndex = dlg.GetOutputIndex();
+		m_LatencyProfile = dlg.GetLatencyProfile();
+		m_pSdrInterface->SetAudioLatencyProfile(m_LatencyProfile);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//Local Spectrum Setup Menu
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnDisplayDlg()
+{
+CDisplayDlg dlg(this);
+	dlg.SetFftSize(m_LocalFftSize);
+	dlg.SetWindow(m_LocalFftWindow);
+	dlg.SetOverlap(m_LocalFftOverlap);
+	if(QDialog::Accepted == dlg.exec() )
+	{
+		m_LocalFftSize = dlg.GetFftSize();
+		m_LocalFftWindow = dlg.GetWindow();
+		m_LocalFftOverlap = dlg.GetOverlap();
+		m_pSdrInterface->SetupLocalFft(m_LocalFftSize, m_LocalFftWindow, m_LocalFftOverlap);
 	}
 }
 
+/////////////////////////////////////////////////////////////////////
+// Menu Bar action item handler.
+//Raw I/Q Sub-channels Menu, the dialog sets the channelizer directly
+/////////////////////////////////////////////////////////////////////
+void MainWindow::OnChannelizerDlg()
+{
+CChannelizerDlg dlg(this, m_pSdrInterface);
+	dlg.SetChannelizer(m_ChannelizerSize, m_ChannelizerMonitor);
+	dlg.exec();
+	m_ChannelizerSize = dlg.GetNumChannels();
+	m_ChannelizerMonitor = dlg.GetMonitor();
+}
+
 /////////////////////////////////////////////////////////////////////
 // Menu Bar action item handler.
 //Transmit Setup Menu
@@ -853,7 +1180,7 @@ CTransmitDlg dlg(this,m_pSdrInterface );
 /////////////////////////////////////////////////////////////////////
 void MainWindow::OnNewVideoData()
 {
-	ui->framePlot->Draw(true);		//slot called when new data avail
+	ui->framePlot->NewDataAvailable();	//slot called when new data avail
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -1053,6 +1380,7 @@ void MainWindow::OnNewLowCutFreq(int f)
 	m_pSdrInterface->SetDemodFilter(m_DemodSettings[m_DemodMode].LowCut,
 									m_DemodSettings[m_DemodMode].HiCut,
 									m_DemodSettings[m_DemodMode].Offset);
+	UpdateLocalDemod();
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -1064,6 +1392,7 @@ void MainWindow::OnNewHighCutFreq(int f)
 	m_pSdrInterface->SetDemodFilter(m_DemodSettings[m_DemodMode].LowCut,
 									m_DemodSettings[m_DemodMode].HiCut,
 									m_DemodSettings[m_DemodMode].Offset);
+	UpdateLocalDemod();
 }
 
 
@@ -1129,6 +1458,20 @@ bool ovr = false;
 	}
 }
 
+/////////////////////////////////////////////////////////////////////
+// Called whenever demod settings change to pass the settings of the
+// local demod mode used on raw I/Q to the sdr interface.
+/////////////////////////////////////////////////////////////////////
+void MainWindow::UpdateLocalDemod()
+{
+	if( (m_LocalDemodMode >= 0) && (m_LocalDemodMode < DEMOD_MODE_RAW) )
+		m_pSdrInterface->SetLocalDemod(m_LocalDemodMode, m_DemodSettings[m_LocalDemodMode].LowCut,
+									m_DemodSettings[m_LocalDemodMode].HiCut, m_DemodSettings[m_LocalDemodMode].Offset,
+									m_DemodSettings[m_LocalDemodMode].AgcThresh, m_DemodSettings[m_LocalDemodMode].AgcDecay);
+	else
+		m_pSdrInterface->SetLocalDemod(-1, 0, 0, 0, 0, 0);
+}
+
 /////////////////////////////////////////////////////////////////////
 // Called when chat dialog needs to change state
 /////////////////////////////////////////////////////////////////////
@@ -1285,6 +1628,7 @@ void MainWindow::OnDemodChanged(int index)
     m_pSdrInterface->SetDemodFilter(m_DemodSettings[m_DemodMode].LowCut,
                                     m_DemodSettings[m_DemodMode].HiCut,
                                     m_DemodSettings[m_DemodMode].Offset);
+    UpdateLocalDemod();
     ui->framePlot->SetSquelchThreshold(m_DemodSettings[m_DemodMode].SquelchValue);
     ui->frameMeter->SetSquelchPos( m_DemodSettings[m_DemodMode].SquelchValue );
 
@@ -1310,6 +1654,7 @@ void MainWindow::OnAgcThresh(int val)
 		return;
 	m_DemodSettings[m_DemodMode].AgcThresh = val;
 	m_pSdrInterface->SetAgc(0, m_DemodSettings[m_DemodMode].AgcThresh, m_DemodSettings[m_DemodMode].AgcDecay);
+	UpdateLocalDemod();
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -1321,6 +1666,7 @@ void MainWindow::OnAgcDecay(int val)
 		return;
 	m_DemodSettings[m_DemodMode].AgcDecay = val;
 	m_pSdrInterface->SetAgc(0, m_DemodSettings[m_DemodMode].AgcThresh, m_DemodSettings[m_DemodMode].AgcDecay);
+	UpdateLocalDemod();
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -1334,6 +1680,7 @@ void MainWindow::OnOffsetChanged(int Offset)
 	m_pSdrInterface->SetDemodFilter(m_DemodSettings[m_DemodMode].LowCut,
 									m_DemodSettings[m_DemodMode].HiCut,
 									m_DemodSettings[m_DemodMode].Offset);
+	UpdateLocalDemod();
 }
 
 /////////////////////////////////////////////////////////////////////
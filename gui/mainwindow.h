@@ -69,11 +69,21 @@ private slots:
 	void keyPressEvent( QKeyEvent * event );
 	void keyReleaseEvent( QKeyEvent * event );
 	void StayOnTop();
+	void OnOpenGlPlot();
+	void OnOpenGlFailed();
+	void OnLocalFft();
+	void OnLocalDemod(QAction* pAction);
+	void OnIqRecordFailed(QString Reason);
+	void OnAudioRecordFailed(QString Reason);
+	void OnRecordIq();
+	void OnRecordAudio();
 	void OnExit();
 	void OnAbout();
 	void OnTimer();
 	void OnNetworkDlg();
 	void OnSoundCardDlg();
+	void OnDisplayDlg();
+	void OnChannelizerDlg();
 	void OnTransmitDlg();
 	void OnNewCenterFrequency(qint64 freq);	//called when center frequency has changed
 	void OnNewPlotCenterFrequency(qint64 freq);
@@ -106,6 +116,7 @@ private slots:
     void OnAntennaSelected(int);
 
 	void NewSMeterValue(qint16 Val);
+	void OnNewRxChannelCount(int Count);
 	void OnNewVideoData();
 	void OnNewFftAvePwr(qint16 Val);
 
@@ -117,9 +128,21 @@ private:
     void SetDemodSelector(int DemodMode);
     void SetChatDialogState(int state);
 	void SetRawIQWidgetState(int state);
+	void UpdateLocalDemod();
+	void CreateLocalDemodMenu();
 
 	//Persistant Variables saved with Settings
 	bool m_StayOnTop;
+	bool m_OpenGlPlot;		//draw spectrum and waterfall with OpenGL
+	bool m_LocalFft;		//compute spectrum from raw I/Q in raw modes
+	int m_LocalFftSize;
+	int m_LocalFftWindow;
+	int m_LocalFftOverlap;	//percent
+	int m_LocalDemodMode;	//demod mode used on raw I/Q, -1 is off
+	int m_ChannelizerSize;	//raw I/Q sub-channels, 0 is off
+	int m_ChannelizerMonitor;	//sub-channel to listen to, -1 is whole stream
+	int m_RxAudioChannel;		//receiver channel sent to the sound card
+	QStringList m_RxMonitorChannels;	//"channel:pan:frequency" receiver channels mixed in
 	QHostAddress m_IPAdr;
 	quint16 m_Port;
 	QString m_RxPassword;
@@ -128,6 +151,9 @@ private:
 	QString m_ListServer;
 	QString m_ListServerActionPath;
 	QString m_MemoryFilePath;
+	QString m_IqRecordPath;
+	QString m_AudioRecordPath;
+	bool m_AudioRecordGated;	//new audio file each time squelch opens
 	QString m_ClientDesc;
 	qint64 m_RxCenterFrequency;
 	qint64 m_TxCenterFrequency;
@@ -135,6 +161,8 @@ private:
 	int m_DemodMode;
 	int m_SoundInIndex;
 	int m_SoundOutIndex;
+	int m_LatencyProfile;
+	int m_TxCoalesceTime;	//mSec to collect Tx msgs into one network write
 	int m_RfGain;
 	int m_AudioCompressionIndex;
 	int m_RawRateIndex;
@@ -165,6 +193,9 @@ private:
 	int m_PlotWidth;
 	int m_ViewdB;
 	int m_SpanFreq;
+	quint32 m_LastFramesRendered;	//plotter counts at the last status update
+	quint32 m_LastFramesMerged;
+	int m_AudioRecordChannel;	//receiver channel being recorded by the Record Audio menu
 	Ui::MainWindow *ui;
 	CSdrInterface* m_pSdrInterface;
 	CMemDialog* m_pMemDialog;
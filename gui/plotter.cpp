@@ -46,11 +46,18 @@
 #include <stdlib.h>
 #include <QDebug>
 #include <QToolTip>
+#include <QGuiApplication>
+#include <QScreen>
+#include <string.h>
 #include "interface/sdrprotocol.h"
+#ifdef ENABLE_OPENGL
+#include <QOpenGLContext>
+#endif
 
 // Local defines
 #define CUR_CUT_DELTA 10        //cursor capture delta in pixels
 #define OVERLOAD_DISPLAY_LIMIT 10
+#define FRAMETIME_ALPHA 0.05    // smoothing of render/paint time measurements
 
 //color lookup table for waterfall
 // index is 0 to 255  where 255 is the minimum dB level, o is max dB level
@@ -318,6 +325,9 @@ const quint8 PALTBL[256*3] =
 CPlotter::CPlotter(QWidget *parent) : QFrame(parent)
 {
     m_pSdrInterface = NULL;
+#ifdef ENABLE_OPENGL
+    m_pGlPlotter = NULL;
+#endif
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     //setFocusPolicy(Qt::StrongFocus);
     //setAttribute(Qt::WA_PaintOnScreen,false);
@@ -352,14 +362,28 @@ CPlotter::CPlotter(QWidget *parent) : QFrame(parent)
     m_Running = false;
     m_ADOverloadOneShotCounter = 0;
     m_ADOverLoad = false;
-    m_2DPixmap = QPixmap(0,0);
+    m_TraceLength = 0;
+    m_ScaleHeight = -1;
+    m_AveRenderTime = 0.0;
+    m_AvePaintTime = 0.0;
     m_OverlayPixmap = QPixmap(10,10);
-    m_WaterfallPixmap = QPixmap(10,10);
+    m_WaterfallImage = QImage(10, 10, QImage::Format_RGB32);
+    m_WaterfallTop = 0;
     m_Size = QSize(10,10);
     m_GrabPosition = 0;
     m_Percent2DScreen = 50; //percent of screen used for 2D display
     m_VideoCompressionMode = 0;
     m_SmoothAlpha = 0.7;
+
+    memset(m_FftData, 0, sizeof(m_FftData));
+    m_FramesMerged = 0;
+    m_FramesRendered = 0;
+    m_LastRenderTime = 0;
+    SetMaxFrameRate(DEFAULT_MAX_FPS);
+    m_RenderClock.start();
+    m_pRenderTimer = new QTimer(this);
+    m_pRenderTimer->setSingleShot(true);
+    connect(m_pRenderTimer, SIGNAL(timeout()), this, SLOT(RenderFrames()));
 }
 
 CPlotter::~CPlotter()
@@ -376,22 +400,83 @@ void CPlotter::setPalette(int pal)
     default:
     case COLPAL_DEFAULT:
         for (i = 0, j = 0; i < 256; i++, j+=3)
-            m_ColorTbl[255-i].setRgb(PALTBL[j], PALTBL[j+1], PALTBL[j+2]);
+            m_ColorTbl[255-i] = qRgb(PALTBL[j], PALTBL[j+1], PALTBL[j+2]);
         break;
 
     case COLPAL_GRAY:
         for (i = 0; i < 256; i++)
-            m_ColorTbl[i].setRgb(i, i, i);
+            m_ColorTbl[i] = qRgb(i, i, i);
         break;
 
     case COLPAL_BLUE:
 
         for (i = 0; i < 256-63; i++)
-            m_ColorTbl[i].setRgb(1+i, 1+i, 63+i);
+            m_ColorTbl[i] = qRgb(1+i, 1+i, 63+i);
         for (i = 256-63; i< 256; i++)
-            m_ColorTbl[i].setRgb(i, i, 255);
+            m_ColorTbl[i] = qRgb(i, i, 255);
         break;
     }
+#ifdef ENABLE_OPENGL
+    if (m_pGlPlotter)
+        m_pGlPlotter->SetPalette(m_ColorTbl);
+#endif
+}
+
+// Switches between QPainter drawing and a CGlPlotter child that covers
+// the plot.  The child ignores mouse events so they still come here.
+// Stays with QPainter drawing and emits OpenGlFailed() if no OpenGL
+// context can be made, the child also reports a bad context or shaders
+// later through OnGlInitFailed().
+bool CPlotter::SetOpenGl(bool enable)
+{
+#ifdef ENABLE_OPENGL
+    QOpenGLContext context;
+
+    if (enable && !m_pGlPlotter)
+    {
+        if (context.create())
+        {
+            m_pGlPlotter = new CGlPlotter(this);
+            connect(m_pGlPlotter, SIGNAL(InitFailed()), this, SLOT(OnGlInitFailed()));
+            m_pGlPlotter->SetPalette(m_ColorTbl);
+            m_pGlPlotter->setGeometry(rect());
+            m_pGlPlotter->show();
+        }
+        else
+        {
+            qDebug() << "No OpenGL context, using QPainter plotter";
+            emit OpenGlFailed();
+        }
+    }
+    else if (!enable && m_pGlPlotter)
+    {
+        delete m_pGlPlotter;
+        m_pGlPlotter = NULL;
+    }
+    m_Size = QSize(0,0);    // force new bitmaps and waterfall
+    resizeEvent(NULL);
+    return (m_pGlPlotter != NULL);
+#else
+    Q_UNUSED(enable);
+    return false;
+#endif
+}
+
+// Called by the CGlPlotter child from its initializeGL() if it cannot
+// draw, so it is deleted later and QPainter drawing takes over.
+void CPlotter::OnGlInitFailed()
+{
+#ifdef ENABLE_OPENGL
+    if (!m_pGlPlotter)
+        return;
+    m_pGlPlotter->hide();
+    m_pGlPlotter->deleteLater();
+    m_pGlPlotter = NULL;
+    m_Size = QSize(0,0);
+    resizeEvent(NULL);
+    update();
+#endif
+    emit OpenGlFailed();
 }
 
 // Sizing interface
@@ -709,125 +794,247 @@ void CPlotter::resizeEvent(QResizeEvent* )
         m_Size = size();
         m_OverlayPixmap = QPixmap(m_Size.width(), m_Percent2DScreen*m_Size.height() / 100);
         m_OverlayPixmap.fill(Qt::white);
-        m_2DPixmap = QPixmap(m_Size.width(), m_Percent2DScreen*m_Size.height() / 100);
-        m_2DPixmap.fill(Qt::white);
-        m_WaterfallPixmap = QPixmap(m_Size.width(), (100 - m_Percent2DScreen) * m_Size.height() / 100);
+        m_WaterfallImage = QImage(m_Size.width(), (100 - m_Percent2DScreen) * m_Size.height() / 100,
+                                  QImage::Format_RGB32);
         emit NewWidth(m_Size.width());
     }
-    m_WaterfallPixmap.fill(Qt::black);
+    m_WaterfallImage.fill(Qt::black);
+    m_WaterfallTop = 0;
+#ifdef ENABLE_OPENGL
+    if (m_pGlPlotter)
+    {
+        m_pGlPlotter->setGeometry(rect());
+        m_pGlPlotter->SetWaterfallSize(m_WaterfallImage.width(), m_WaterfallImage.height());
+    }
+#endif
     DrawOverlay();
 }
 
-// Called by QT when screen needs to be redrawn
-void CPlotter::paintEvent(QPaintEvent *)
+// Called by QT when screen needs to be redrawn.
+// The 2D area is composed from the cached overlay layer and the trace
+// layer, and only the areas in the damaged region are drawn.
+void CPlotter::paintEvent(QPaintEvent *event)
 {
+#ifdef ENABLE_OPENGL
+    if (m_pGlPlotter)
+        return;     // CGlPlotter child covers the whole plot
+#endif
+    QElapsedTimer timer;
+    timer.start();
     QPainter painter(this);
-    painter.drawPixmap(0, 0, m_2DPixmap);
-    painter.drawPixmap(0, m_Percent2DScreen * m_Size.height() / 100, m_WaterfallPixmap);
+    int y = m_Percent2DScreen * m_Size.height() / 100;
+    int w = m_WaterfallImage.width();
+    int h = m_WaterfallImage.height();
+
+    if (event->rect().intersects(m_OverlayPixmap.rect()))
+    {
+        painter.drawPixmap(0, 0, m_OverlayPixmap);
+        if (m_TraceLength > 0)
+        {
+            painter.save();
+// workaround for "fixed" line drawing since Qt 5
+// see http://stackoverflow.com/questions/16990326
+#if QT_VERSION >= 0x050000
+            painter.translate(0.5, 0.5);
+#endif
+            painter.setPen(m_TraceColor);
+            painter.drawPolyline(m_TraceBuf, m_TraceLength);
+            painter.restore();
+        }
+    }
+    if (event->rect().intersects(QRect(0, y, w, h)))
+    {
+        // waterfall ring is drawn newest line first so it wraps at m_WaterfallTop
+        painter.drawImage(QPoint(0, y), m_WaterfallImage,
+                          QRect(0, m_WaterfallTop, w, h - m_WaterfallTop));
+        if (m_WaterfallTop > 0)
+            painter.drawImage(QPoint(0, y + h - m_WaterfallTop), m_WaterfallImage,
+                              QRect(0, 0, w, m_WaterfallTop));
+    }
+    painter.end();
+    m_AvePaintTime = (1.0-FRAMETIME_ALPHA)*m_AvePaintTime + FRAMETIME_ALPHA*(double)timer.nsecsElapsed();
 }
 
-// Called to update the screen with data from video queue
-void CPlotter::Draw(bool newdata)
+// Sets the spectrum repaint rate cap in frames per second.
+// The display refresh rate is used if fps is zero or faster than the display.
+void CPlotter::SetMaxFrameRate(int fps)
 {
-    int i;
-    int w;
-    int h;
-    quint32 fftbuf[MAX_SCREENSIZE];
-    QPoint LineBuf[MAX_SCREENSIZE];
-
-    for (i = 0; i < MAX_SCREENSIZE; i++)
-        fftbuf[i] = 0;
+    int hz = DEFAULT_MAX_FPS;
+
+    if (QGuiApplication::primaryScreen())
+        hz = (int)QGuiApplication::primaryScreen()->refreshRate();
+    if (hz < 1)
+        hz = DEFAULT_MAX_FPS;
+    if ((fps <= 0) || (fps > hz))
+        fps = hz;
+    m_RenderInterval = 1000 / fps;
+}
 
-    // get/draw the waterfall
-    w = m_WaterfallPixmap.width();
-    h = m_WaterfallPixmap.height();
+// Called when the sdr interface has new fft frames waiting.
+// Renders now if the last repaint was at least m_RenderInterval ago,
+// otherwise schedules one render for when the interval is up.
+void CPlotter::NewDataAvailable()
+{
+    qint64 elapsed;
 
-    // move current data down one line(must do before attaching a QPainter object)
-    if (newdata)
-        m_WaterfallPixmap.scroll(0, 1, 0, 0, w, h);
+    if (m_pRenderTimer->isActive())
+        return;
+    elapsed = m_RenderClock.elapsed() - m_LastRenderTime;
+    if (elapsed >= m_RenderInterval)
+        RenderFrames();
+    else
+        m_pRenderTimer->start(m_RenderInterval - (int)elapsed);
+}
 
-    QPainter painter1(&m_WaterfallPixmap);
-    // get scaled FFT data
-    if (m_pSdrInterface)
-        m_pSdrInterface->GetFftData(fftbuf, w);
+// Called to drain all waiting fft frames.  Every frame goes into the
+// waterfall history but only the newest one is drawn in the 2D plot
+// and repainted.
+void CPlotter::RenderFrames()
+{
+    int n = 0;
+    int len;
+    QElapsedTimer timer;
 
-    // draw new line of fft data at top of waterfall bitmap
-    for (i = 0; i < w; i++)
+    if (!m_pSdrInterface)
+        return;
+    timer.start();
+    m_LastRenderTime = m_RenderClock.elapsed();
+    while (m_pSdrInterface->GetFftFrame(&m_VideoFrame))
+    {
+        if (n++ > 0)
+        {   // previous frame is skipped so just add it to the waterfall
+            AddWaterfallLine();
+            m_FramesMerged++;
+        }
+        len = m_VideoFrame.Length;
+        if (len > MAX_SCREENSIZE)
+            len = MAX_SCREENSIZE;
+        memcpy(m_FftData, m_VideoFrame.Data, len);
+        memset(&m_FftData[len], 0, MAX_SCREENSIZE - len);
+    }
+    if (n > 0)
     {
-        painter1.setPen(m_ColorTbl[fftbuf[i]]);
-        painter1.drawPoint(i, 0);
+        Draw(true);
+        m_FramesRendered++;
+        m_AveRenderTime = (1.0-FRAMETIME_ALPHA)*m_AveRenderTime + FRAMETIME_ALPHA*(double)timer.nsecsElapsed();
     }
+}
 
-    // get/draw the 2D spectrum
-    w = m_2DPixmap.width();
-    h = m_2DPixmap.height();
-    // first copy into 2Dbitmap the overlay bitmap.
-    m_2DPixmap = m_OverlayPixmap.copy(0, 0, w, h);
+// Called to write m_FftData as the newest line of the waterfall ring
+void CPlotter::AddWaterfallLine()
+{
+    int i;
+    int w = m_WaterfallImage.width();
+    int h = m_WaterfallImage.height();
+    QRgb* pLine;
 
-    QPainter painter2(&m_2DPixmap);
+    // splitter at 100% leaves no waterfall
+    if (m_WaterfallImage.isNull() || (w <= 0) || (h <= 0))
+        return;
+    if (w > MAX_SCREENSIZE)
+        w = MAX_SCREENSIZE;
 
-// workaround for "fixed" line drawing since Qt 5
-// see http://stackoverflow.com/questions/16990326
-#if QT_VERSION >= 0x050000
-    painter2.translate(0.5, 0.5);
+#ifdef ENABLE_OPENGL
+    if (m_pGlPlotter)
+    {   // line is colored and scrolled by the GPU
+        m_pGlPlotter->AddLine(m_FftData, w);
+        return;
+    }
 #endif
 
-    // scale 0 to 255 fft data to maximum heigth of 2d and invert
+    // new line goes in the ring just above the current top line
+    if (--m_WaterfallTop < 0)
+        m_WaterfallTop = h - 1;
+
+    // write the line as packed colors straight into its scanline
+    pLine = (QRgb*)m_WaterfallImage.scanLine(m_WaterfallTop);
     for (i = 0; i < w; i++)
-    {
-        fftbuf[i] = h - (h * (fftbuf[i]*100) + 12750 ) /(25500);
-    }
+        pLine[i] = m_ColorTbl[m_FftData[i]];
+
+    // only the waterfall area needs repainting
+    update(QRect(0, m_Percent2DScreen * m_Size.height() / 100, w, h));
+}
+
+// Called to update the screen with the newest fft frame in m_FftData
+void CPlotter::Draw(bool newdata)
+{
+    int w;
+    int h;
+
+    if (newdata)
+        AddWaterfallLine();
+
+    // get/draw the 2D spectrum
+    w = m_OverlayPixmap.width();
+    h = m_OverlayPixmap.height();
+    if (w > MAX_SCREENSIZE)
+        w = MAX_SCREENSIZE;
 
-//  if(COMP_MODE_4BIT == m_VideoCompressionMode )
-    SmoothData(fftbuf, w);
+    // scale 0 to 255 fft data to the 2D height and smooth into the trace
+    ScaleAndSmoothData(m_FftData, m_TraceBuf, w, h);
+    m_TraceLength = w;
 
     // draw the 2D spectrum
     bool fftoverload = false;
+    QColor TraceColor(48, 48, 255, 255);
     if (m_ADOverLoad || fftoverload)
     {
-        painter2.setPen(Qt::red);
+        TraceColor = Qt::red;
         if (m_ADOverloadOneShotCounter++ > OVERLOAD_DISPLAY_LIMIT)
         {
             m_ADOverloadOneShotCounter = 0;
             m_ADOverLoad = false;
         }
     }
-    else
-        // painter2.setPen(Qt::blue);
-        painter2.setPen(QColor(48, 48, 255, 255));
 
-    for (i = 0; i < w; i++)
+    m_TraceColor = TraceColor;
+
+#ifdef ENABLE_OPENGL
+    if (m_pGlPlotter)
     {
-        LineBuf[i].setX(i);
-        LineBuf[i].setY(fftbuf[i]);
+        m_pGlPlotter->SetTrace(m_TraceBuf, w, TraceColor);
+        return;
     }
-    painter2.drawPolyline(LineBuf, w);
+#endif
 
-    update();
+    // only the trace layer changed so just repaint the 2D area
+    update(m_OverlayPixmap.rect());
 }
 
-// Called to Smooth the 2D data by exponential smoothing over 2 pixels
-// with an alpha of m_SmoothAlpha
-void CPlotter::SmoothData(quint32* pBuf, qint32 Length)
+// Called to scale 0 to 255 fft data to maximum heigth of 2d, invert it
+// and smooth it by exponential smoothing over 2 pixels with an alpha of
+// m_SmoothAlpha.  The forward pass goes into m_SmoothBuf and the reverse
+// pass averages with it and writes the trace points in the same loop.
+void CPlotter::ScaleAndSmoothData(const quint8* pIn, QPoint* pOut, int Length, int Height)
 {
-    double Lbuf[MAX_SCREENSIZE];
-    double Rbuf[MAX_SCREENSIZE];
+    int i;
+    float a = (float)m_SmoothAlpha;
+    float b = 1.0f - a;
+    float* pL = m_SmoothBuf;
+    float r;
 
-    for (int i = 0; i < Length; i++)
+    if (Length <= 0)
+        return;
+    if (Height != m_ScaleHeight)
     {
-        Lbuf[i] = (float)pBuf[i];
-        Rbuf[i] = (float)pBuf[i];
+        for (i = 0; i < 256; i++)
+            m_ScaleTbl[i] = (float)(Height - (Height * (i*100) + 12750) / 25500);
+        m_ScaleHeight = Height;
     }
 
     // Fwd scan
-    for (int i = 1; i < Length; ++i)
-        Lbuf[i] = m_SmoothAlpha*Lbuf[i] + (1.0-m_SmoothAlpha)*Lbuf[i-1];
-
-    // Rev scan
-    for (int i = Length - 2; i >= 0; --i)
-        Rbuf[i] = m_SmoothAlpha*Rbuf[i] + (1.0-m_SmoothAlpha)*Rbuf[i+1];
-    for (int i = 0; i < Length; i++)
-        pBuf[i] = (quint32)( (Lbuf[i]+Rbuf[i])/2.0 );
+    pL[0] = m_ScaleTbl[pIn[0]];
+    for (i = 1; i < Length; i++)
+        pL[i] = a*m_ScaleTbl[pIn[i]] + b*pL[i-1];
+
+    // Rev scan and average
+    r = m_ScaleTbl[pIn[Length-1]];
+    pOut[Length-1] = QPoint(Length-1, (int)((pL[Length-1] + r)*0.5f));
+    for (i = Length - 2; i >= 0; i--)
+    {
+        r = a*m_ScaleTbl[pIn[i]] + b*r;
+        pOut[i] = QPoint(i, (int)((pL[i] + r)*0.5f));
+    }
 }
 
 // Called to draw an overlay bitmap containing grid and text that
@@ -941,19 +1148,32 @@ void CPlotter::DrawOverlay()
         dB -= m_dBStepSize;
     }
 
+#ifdef ENABLE_OPENGL
+    if (m_pGlPlotter)
+    {
+        m_pGlPlotter->SetOverlay(m_OverlayPixmap);
+        if (!m_Running)
+            m_pGlPlotter->ClearTrace();
+        else if (DEMODDRAG == m_CursorCaptured)
+            Draw(false);
+        return;
+    }
+#endif
     if (!m_Running )
     {
         // if not running so is no data updates to draw to screen
-        // copy into 2Dbitmap the overlay bitmap.
-        m_2DPixmap = m_OverlayPixmap.copy(0, 0, w, h);
-        // trigger a new paintEvent
-        update();
+        // so show just the overlay layer
+        m_TraceLength = 0;
+        update(m_OverlayPixmap.rect());
     }
     else if (DEMODDRAG == m_CursorCaptured)
     {
-        m_2DPixmap = m_OverlayPixmap.copy(0, 0, w, h);
         Draw(false);
     }
+    else
+    {
+        update(m_OverlayPixmap.rect());
+    }
 }
 
 // Helper function Called to create all the frequency division text
@@ -10,13 +10,19 @@
 #include <QtGui>
 #include <QFrame>
 #include <QImage>
+#include <QTimer>
+#include <QElapsedTimer>
 #include "interface/sdrinterface.h"
+#ifdef ENABLE_OPENGL
+#include "gui/glplotter.h"
+#endif
 
 #define VERT_DIVS 10    // specify grid screen divisions
 #define HORZ_DIVS 10
 
 #define MAX_TXT 128
 #define MAX_SCREENSIZE 3000
+#define DEFAULT_MAX_FPS 60  // spectrum repaint cap, also limited to display refresh rate
 
 
 #define COLPAL_DEFAULT  0
@@ -59,12 +65,21 @@ public:
     void SetSmoothAlpha(double alpha) { m_SmoothAlpha = alpha; }
     void UpdateOverlay() { DrawOverlay(); }
     void Draw(bool newdata); // call to draw new fft data onto screen plot
+    void NewDataAvailable(); // call when new fft frames are waiting in the sdr interface
+    void SetMaxFrameRate(int fps);
+    bool SetOpenGl(bool enable); // draw with CGlPlotter if built with OpenGL, returns true if it is used
+    quint32 GetFramesMerged() { return m_FramesMerged; }
+    quint32 GetFramesRendered() { return m_FramesRendered; }
+    int GetFramesDropped() { return m_pSdrInterface ? m_pSdrInterface->GetVideoFramesDropped() : 0; }
+    int GetRenderTime() { return (int)(m_AveRenderTime / 1000.0); }    // uSec GUI thread cost per render
+    int GetPaintTime() { return (int)(m_AvePaintTime / 1000.0); }      // uSec per paintEvent
 
 signals:
     void NewCenterFreq(qint64 f);
     void NewLowCutFreq(int f);
     void NewHighCutFreq(int f);
     void NewWidth(int w);
+    void OpenGlFailed();    // OpenGL was asked for but the QPainter plotter is used
 
 public slots:
     void setPalette(int pal);
@@ -83,6 +98,10 @@ protected:
     void mouseReleaseEvent(QMouseEvent * event);
     void wheelEvent( QWheelEvent * event );
 
+private slots:
+    void RenderFrames();
+    void OnGlInitFailed();
+
 private:
     enum eCapturetype {
        NONE,
@@ -91,8 +110,9 @@ private:
        RIGHT
     };
     void DrawOverlay();
+    void AddWaterfallLine();
     void MakeFrequencyStrs();
-    void SmoothData(quint32* pBuf, qint32 Length);
+    void ScaleAndSmoothData(const quint8* pIn, QPoint* pOut, int Length, int Height);
     int XfromFreq(qint64 freq);
     qint64 FreqfromX(int x);
     qint64 DeltaFreqfromX(int x);
@@ -121,9 +141,16 @@ private:
     int m_FHiCmax;
     int m_ClickResolution;
     int m_FilterClickResolution;
+    int m_RenderInterval;       // minimum mSec between spectrum repaints
     double m_SmoothAlpha;
+    double m_AveRenderTime;     // nSec
+    double m_AvePaintTime;      // nSec
 
     quint32 m_LastSampleRate;
+    quint32 m_FramesMerged;     // frames only added to the waterfall, no repaint
+    quint32 m_FramesRendered;
+
+    qint64 m_LastRenderTime;
 
     qint32 m_Span;
     qint32 m_MaxdB;
@@ -135,14 +162,27 @@ private:
     qint64 m_GrabFrequency;
 
     eCapturetype m_CursorCaptured;
-    QPixmap m_2DPixmap;
-    QPixmap m_OverlayPixmap;
-    QPixmap m_WaterfallPixmap;
-    QColor m_ColorTbl[256];
+    QPixmap m_OverlayPixmap;    // cached grid and text layer of the 2D area
+    QPoint m_TraceBuf[MAX_SCREENSIZE];  // spectrum trace layer drawn over the overlay
+    int m_TraceLength;
+    int m_ScaleHeight;          // 2D height m_ScaleTbl was built for
+    float m_ScaleTbl[256];      // fft value to 2D y position
+    float m_SmoothBuf[MAX_SCREENSIZE];  // forward pass work buffer
+    QColor m_TraceColor;
+    QImage m_WaterfallImage;    // ring of waterfall lines, m_WaterfallTop is newest
+    int m_WaterfallTop;
+    QRgb m_ColorTbl[256];       // packed ARGB so lines are written straight to scanlines
+    quint8 m_FftData[MAX_SCREENSIZE];   // newest spectrum frame
+    tvideoframe m_VideoFrame;
+    QTimer* m_pRenderTimer;
+    QElapsedTimer m_RenderClock;
     QSize m_Size;
     QString m_Str;
     QString m_HDivText[HORZ_DIVS+1];
     CSdrInterface* m_pSdrInterface;
+#ifdef ENABLE_OPENGL
+    CGlPlotter* m_pGlPlotter;   // NULL when drawing with QPainter
+#endif
 };
 
 #endif // PLOTTER_H
@@ -21,6 +21,8 @@ public:
 	void SetOutputIndex(int x){if(x>m_MaxOutIndex) x=m_MaxOutIndex; ui.comboBoxSndOut->setCurrentIndex(x); }
 	int GetInputIndex(){return ui.comboBoxSndIn->currentIndex(); }
 	int GetOutputIndex(){return ui.comboBoxSndOut->currentIndex(); }
+	void SetLatencyProfile(int x){ui.comboBoxLatency->setCurrentIndex(x); }
+	int GetLatencyProfile(){return ui.comboBoxLatency->currentIndex(); }
 
 public slots:
 
@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////
+// ascpframer.cpp: implementation of the CAscpFramer class.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "ascpframer.h"
+#include <string.h>
+
+/////////////////////////////////////////////////////////////////////
+// Called after Length bytes were read into GetRxFreePtr().
+// Parses every complete msg then moves any partial msg to the start
+// of the buffer.
+/////////////////////////////////////////////////////////////////////
+void CAscpFramer::PutRxData(int Length)
+{
+int used;
+	m_RxBufLength += Length;
+	used = AssembleAscpMsg(m_RxBuf, m_RxBufLength);
+	m_RxBufLength -= used;
+	if( m_RxBufLength && used )	//move partial msg to start of buffer
+		memmove(m_RxBuf, &m_RxBuf[used], m_RxBufLength);
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+/*                  -------------------------------                          */
+/*                 | A s s e m b l e A s c p M s g |                         */
+/*                  -------------------------------                          */
+/*  Helper function to assemble TCP data stream into ASCP formatted messages */
+/* Called from worker thread context so be careful.                          */
+/*  Every complete msg in Buf is handed to the parser in place. Returns the  */
+/* number of bytes used. Any partial msg left over is kept by the caller.    */
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+int CAscpFramer::AssembleAscpMsg(quint8* Buf, int Len)
+{
+int MsgLength;
+int Used = 0;
+	while( (Len-Used) >= 2 )
+	{
+		MsgLength = ( (int)Buf[Used] | ((int)Buf[Used+1]<<8) ) & LENGTH_MASK;
+		if( 0 == MsgLength)
+			MsgLength = 8192+2;	//handle special case of 8192 byte data message
+		if( (Len-Used) < MsgLength )
+			break;		//rest of msg has not arrived yet
+		DispatchAscpMsg(&Buf[Used], MsgLength);
+		Used += MsgLength;
+	}
+	return Used;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Hands one complete ASCP msg to OnAscpMsg().
+// Data item msgs are parsed as a view of pMsg with no copy.
+// Control item msgs are small and may hold strings that rely on a
+// terminator so they are parsed from the local buffer with a zero
+// appended after the msg.
+// Called from worker thread context.
+/////////////////////////////////////////////////////////////////////
+void CAscpFramer::DispatchAscpMsg(quint8* pMsg, int Length)
+{
+	if( pMsg[1] & 0x80 )
+	{	//data item so parse it in place
+		m_RxAscpMsg.AttachRxMsg(pMsg);
+		OnAscpMsg( &m_RxAscpMsg, Length );
+		m_RxAscpMsg.DetachRxMsg();
+	}
+	else
+	{
+		memcpy(m_RxAscpMsg.RxBuf8, pMsg, Length);
+		m_RxAscpMsg.RxBuf8[Length] = 0;
+		OnAscpMsg( &m_RxAscpMsg, Length );
+	}
+}
@@ -0,0 +1,46 @@
+//////////////////////////////////////////////////////////////////////
+// ascpframer.h: interface for the CAscpFramer class.
+//
+// Splits the received TCP byte stream into ASCP msgs.  Socket reads
+// go straight into the free space of a receive buffer and every
+// complete msg is handed to OnAscpMsg() in place.  A partial msg is
+// kept at the start of the buffer until the rest arrives.
+// Has no Qt object or network dependencies so it can be unit tested.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef ASCPFRAMER_H
+#define ASCPFRAMER_H
+
+#include "ascpmsg.h"
+
+#define RXBUF_SIZE 65536	//must hold at least one max size ASCP msg
+
+class CAscpFramer
+{
+public:
+	CAscpFramer(){m_RxBufLength = 0;}
+	virtual ~CAscpFramer(){}
+
+	//throw away any partial msg, called when a new connection starts
+	void ResetRx(){m_RxBufLength = 0;}
+	//where the next read goes and how many bytes it may write
+	quint8* GetRxFreePtr(){return &m_RxBuf[m_RxBufLength];}
+	int GetRxFreeLength(){return RXBUF_SIZE - m_RxBufLength;}
+	//Length bytes were read into GetRxFreePtr(), parse every complete msg
+	void PutRxData(int Length);
+
+protected:
+	//called once per complete msg, Length is the whole msg length
+	virtual void OnAscpMsg(CAscpRxMsg* pMsg, int Length) = 0;
+
+private:
+	int AssembleAscpMsg(quint8* Buf, int Len);
+	void DispatchAscpMsg(quint8* pMsg, int Length);
+	CAscpRxMsg m_RxAscpMsg;
+	quint8 m_RxBuf[RXBUF_SIZE];	//receive buffer msgs are parsed from in place
+	int m_RxBufLength;			//number of unparsed bytes at start of m_RxBuf
+};
+
+#endif // ASCPFRAMER_H
@@ -109,16 +109,19 @@
 class CAscpRxMsg
 {
 public:
-	CAscpRxMsg(){Length=0;}
+	CAscpRxMsg(){Length=0; Buf8 = RxBuf8;}
 	// For reading msgs
-	// Put raw received bytes in Buf8[]
+	// Either put raw received bytes in RxBuf8[] or call AttachRxMsg()
+	//  to parse a complete msg in place from an external receive buffer
 	// Call InitRxMsg before reading msg
 	// Call Get type,CItem, Length as needed
 	// Call Getparmx() in sequence to read msg parameters in msg order.
+	void AttachRxMsg(quint8* pBuf){Buf8 = pBuf;}
+	void DetachRxMsg(){Buf8 = RxBuf8;}
 	void InitRxMsg(){Length = 4;}
 	quint8 GetType(){return Buf8[1]&TYPE_MASK;}
-	quint16 GetLength(){return Buf16[0]&LENGTH_MASK;}
-	quint16 GetCItem(){return Buf16[1];}
+	quint16 GetLength(){return ( (quint16)Buf8[0] | ((quint16)Buf8[1]<<8) )&LENGTH_MASK;}
+	quint16 GetCItem(){return (quint16)Buf8[2] | ((quint16)Buf8[3]<<8);}
 	quint8 GetParm8(){return Buf8[Length++];}
 	quint16 GetParm16(){tmp16 = Buf8[Length++]; tmp16 |= (quint16)(Buf8[Length++])<<8;
 						return tmp16;	}
@@ -126,12 +129,11 @@ public:
 						tmp32 |= (quint32)(Buf8[Length++])<<16;
 						tmp32 |= (quint32)(Buf8[Length++])<<24;
 						return tmp32;	}
-	union
-	{
-		quint8 Buf8[MAX_ASCPMSG_LENGTH];
-		quint16 Buf16[MAX_ASCPMSG_LENGTH/2];
-	};
+	quint8* Buf8;		//points to msg being parsed (RxBuf8[] or external buffer)
+	quint8 RxBuf8[MAX_ASCPMSG_LENGTH+1];	//local msg storage (+1 for string terminator)
 private:
+	CAscpRxMsg(const CAscpRxMsg&);		//Buf8 may point into itself so no copies
+	CAscpRxMsg& operator=(const CAscpRxMsg&);
 	quint16 Length;
 	quint16 tmp16;
 	quint32 tmp32;
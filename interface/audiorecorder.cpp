@@ -0,0 +1,342 @@
+//////////////////////////////////////////////////////////////////////
+// audiorecorder.cpp: implementation of the CAudioRecorder class.
+//
+//  Each packet goes into the ring as a taudiorechdr followed by its
+// samples in one all or nothing Put() so the writer always finds whole
+// packets.  Squelch packets only carry their length.  The writer is
+// woken when AUDIOREC_WAKE_SIZE bytes are waiting, the squelch opens
+// or closes, or AUDIOREC_HANG_TIME of squelch has been put since the
+// last wake so a gated segment ends on time.
+//  Squelched time inside a file is written as silence so the file
+// keeps real time.  In gated mode a segment ends once the squelch has
+// been closed AUDIOREC_HANG_TIME, so short gaps stay in one file.
+//  A WAV file is closed and the next one started before its data size
+// passes AUDIOREC_MAX_WAV_BYTES, the 32 bit header sizes would wrap.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "audiorecorder.h"
+#include <QDateTime>
+#include <QtEndian>
+#include <string.h>
+
+/////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+/////////////////////////////////////////////////////////////////////
+CAudioRecorder::CAudioRecorder() : m_Ring(AUDIOREC_RING_SIZE)
+{
+	m_Recording.store(0);
+	m_DataPending.store(0);
+	m_PacketsDropped.store(0);
+	m_LastSquelched = false;
+	m_PutSquelchedSamples = 0;
+	m_Format = AUDIOREC_FORMAT_WAV;
+	m_Gated = false;
+	m_HangSamples = 0;
+	m_FileIndex = 0;
+	m_SamplesWritten = 0;
+#ifdef ENABLE_FLAC
+	m_pFlacEncoder = NULL;
+#endif
+}
+
+CAudioRecorder::~CAudioRecorder()
+{
+	qDebug()<<"CAudioRecorder destructor";
+	CleanupThread();	//tell thread to cleanup after itself by calling ThreadExit()
+}
+
+/////////////////////////////////////////////////////////////////////
+// Thread functions
+/////////////////////////////////////////////////////////////////////
+void CAudioRecorder::ThreadInit()	//overrided funciton is called by new thread when started
+{
+	connect(this,SIGNAL( StartSig(QString,int,bool)), this, SLOT(StartSlot(QString,int,bool)) );
+	connect(this,SIGNAL( StopSig()), this, SLOT(StopSlot()) );
+	connect(this,SIGNAL( NewData()), this, SLOT(WriteData()) );
+}
+
+void CAudioRecorder::ThreadExit()
+{
+	StopSlot();
+}
+
+/////////////////////////////////////////////////////////////////////
+// True if this build can write FLAC files
+/////////////////////////////////////////////////////////////////////
+bool CAudioRecorder::IsFlacSupported()
+{
+#ifdef ENABLE_FLAC
+	return true;
+#else
+	return false;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by network thread with Length 8Ksps audio samples.  If
+// Squelched is true the samples are silence and are not copied.
+// Never blocks, data is counted as dropped if the ring is full.
+/////////////////////////////////////////////////////////////////////
+void CAudioRecorder::PutAudio(const qint16* pBuf, int Length, bool Squelched)
+{
+taudiorechdr* pHdr = (taudiorechdr*)m_PutBuf;
+int size = sizeof(taudiorechdr);
+bool changed;
+	if(!m_Recording.load() || (Length <= 0))
+		return;
+	if(Length > AUDIOREC_MAX_PUT)
+		Length = AUDIOREC_MAX_PUT;
+	pHdr->Length = Length;
+	pHdr->Squelched = Squelched;
+	if(!Squelched)
+	{
+		memcpy(&m_PutBuf[size], pBuf, Length*sizeof(qint16));
+		size += Length*sizeof(qint16);
+	}
+	if(!m_Ring.Put(m_PutBuf, size))
+	{
+		m_PacketsDropped.fetchAndAddRelaxed(1);
+		return;
+	}
+	changed = (Squelched != m_LastSquelched);
+	m_LastSquelched = Squelched;
+	if(Squelched)
+		m_PutSquelchedSamples += Length;
+	if( changed || (m_Ring.Available() >= AUDIOREC_WAKE_SIZE) ||
+		(m_PutSquelchedSamples >= (int)(AUDIOREC_HANG_TIME*AUDIOREC_RATE)) )
+	{
+		m_PutSquelchedSamples = 0;
+		if(m_DataPending.testAndSetOrdered(0, 1))
+			emit NewData();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Worker thread slots
+/////////////////////////////////////////////////////////////////////
+void CAudioRecorder::StartSlot(QString BaseName, int Format, bool Gated)
+{
+char tmp[256];
+	StopSlot();
+	while(m_Ring.Get(tmp, sizeof(tmp)) > 0)
+		;		//throw away anything put while stopping
+	m_BaseName = BaseName;
+	m_Format = Format;
+#ifndef ENABLE_FLAC
+	m_Format = AUDIOREC_FORMAT_WAV;
+#endif
+	m_Gated = Gated;
+	m_HangSamples = 0;
+	m_FileIndex = 0;
+	m_PacketsDropped.store(0);
+	if(!m_Gated && !OpenFile())
+		return;
+	m_Recording.storeRelease(1);		//gated files open when squelch opens
+}
+
+void CAudioRecorder::StopSlot()
+{
+	if(!m_Recording.load())
+		return;
+	m_Recording.store(0);
+	WriteRing();
+	CloseFile();
+}
+
+void CAudioRecorder::WriteData()
+{
+	m_DataPending.storeRelease(0);
+	if(m_Recording.load())
+		WriteRing();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to start a new file.  Gated segments are
+// named with their UTC start time, ungated files after the first one
+// get an index.
+/////////////////////////////////////////////////////////////////////
+bool CAudioRecorder::OpenFile()
+{
+QString name = m_BaseName;
+	if(m_Gated)
+		name += QDateTime::currentDateTimeUtc().toString("_yyyyMMdd_HHmmss");
+	else if(m_FileIndex)
+		name += QString("_%1").arg(m_FileIndex);
+	m_FileIndex++;
+	m_SamplesWritten = 0;
+#ifdef ENABLE_FLAC
+	if(AUDIOREC_FORMAT_FLAC == m_Format)
+	{
+		name += ".flac";
+		m_pFlacEncoder = FLAC__stream_encoder_new();
+		if(m_pFlacEncoder)
+		{
+			FLAC__stream_encoder_set_channels(m_pFlacEncoder, 1);
+			FLAC__stream_encoder_set_bits_per_sample(m_pFlacEncoder, 16);
+			FLAC__stream_encoder_set_sample_rate(m_pFlacEncoder, AUDIOREC_RATE);
+			FLAC__stream_encoder_set_compression_level(m_pFlacEncoder, 5);
+			if(FLAC__STREAM_ENCODER_INIT_STATUS_OK ==
+					FLAC__stream_encoder_init_file(m_pFlacEncoder, QFile::encodeName(name).constData(), NULL, NULL))
+				return true;
+			FLAC__stream_encoder_delete(m_pFlacEncoder);
+			m_pFlacEncoder = NULL;
+		}
+		qDebug()<<"Audio recorder FLAC open failed "<<name;
+		emit RecordingFailed(name + ": FLAC encoder could not be started");
+		return false;
+	}
+#endif
+	m_WavFile.setFileName(name + ".wav");
+	if(!m_WavFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qDebug()<<"Audio recorder open failed "<<m_WavFile.fileName();
+		emit RecordingFailed(m_WavFile.fileName() + ": " + m_WavFile.errorString());
+		return false;
+	}
+	WriteWavHeader();
+	return true;
+}
+
+void CAudioRecorder::CloseFile()
+{
+#ifdef ENABLE_FLAC
+	if(m_pFlacEncoder)
+	{
+		FLAC__stream_encoder_finish(m_pFlacEncoder);
+		FLAC__stream_encoder_delete(m_pFlacEncoder);
+		m_pFlacEncoder = NULL;
+	}
+#endif
+	if(m_WavFile.isOpen())
+	{
+		WriteWavHeader();
+		m_WavFile.close();
+	}
+}
+
+bool CAudioRecorder::IsFileOpen()
+{
+#ifdef ENABLE_FLAC
+	if(m_pFlacEncoder)
+		return true;
+#endif
+	return m_WavFile.isOpen();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to move all whole packets in the ring to
+// the file, opening and closing gated segments as the squelch changes.
+/////////////////////////////////////////////////////////////////////
+void CAudioRecorder::WriteRing()
+{
+taudiorechdr hdr;
+int n;
+int len;
+bool ok = true;
+	while(m_Ring.Available() >= (int)sizeof(taudiorechdr))
+	{
+		m_Ring.Get((char*)&hdr, sizeof(taudiorechdr));
+		if(hdr.Squelched)
+		{
+			if(!IsFileOpen())
+				continue;
+			if(m_Gated)
+			{
+				m_HangSamples += hdr.Length;
+				if(m_HangSamples >= (int)(AUDIOREC_HANG_TIME*AUDIOREC_RATE))
+				{	//squelch stayed closed so end this segment
+					CloseFile();
+					continue;
+				}
+			}
+			memset(m_WriteBuf, 0, sizeof(m_WriteBuf));
+			for(n=hdr.Length; ok && (n>0); n-=len)
+			{
+				len = (n > AUDIOREC_BLOCK) ? AUDIOREC_BLOCK : n;
+				ok = WriteSamples(m_WriteBuf, len);
+			}
+		}
+		else
+		{
+			m_HangSamples = 0;
+			if(!IsFileOpen())
+				ok = OpenFile();
+			//always take the samples out of the ring even if they cannot be written
+			for(n=hdr.Length; n>0; n-=len)
+			{
+				len = (n > AUDIOREC_BLOCK) ? AUDIOREC_BLOCK : n;
+				m_Ring.Get((char*)m_WriteBuf, len*sizeof(qint16));
+				if(ok)
+					ok = WriteSamples(m_WriteBuf, len);
+			}
+		}
+		if(!ok)
+		{
+			m_Recording.store(0);
+			CloseFile();
+			return;
+		}
+	}
+	if(m_WavFile.isOpen())
+		WriteWavHeader();	//keep file playable if the program dies
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to write or encode Length samples.  Starts
+// the next WAV file first if these would take it past its size limit.
+/////////////////////////////////////////////////////////////////////
+bool CAudioRecorder::WriteSamples(const qint16* pBuf, int Length)
+{
+	if( m_WavFile.isOpen() &&
+		((m_SamplesWritten + Length)*(qint64)sizeof(qint16) > AUDIOREC_MAX_WAV_BYTES) )
+	{
+		CloseFile();
+		if(!OpenFile())
+			return false;
+	}
+	m_SamplesWritten += Length;
+#ifdef ENABLE_FLAC
+	if(m_pFlacEncoder)
+	{
+		for(int i=0; i<Length; i++)
+			m_FlacBuf[i] = pBuf[i];
+		if(FLAC__stream_encoder_process_interleaved(m_pFlacEncoder, m_FlacBuf, Length))
+			return true;
+		qDebug()<<"Audio recorder FLAC encode failed";
+		emit RecordingFailed("FLAC encode failed");
+		return false;
+	}
+#endif
+	if(m_WavFile.write((const char*)pBuf, Length*sizeof(qint16)) == (qint64)(Length*sizeof(qint16)))
+		return true;
+	qDebug()<<"Audio recorder write failed "<<m_WavFile.errorString();
+	emit RecordingFailed(m_WavFile.fileName() + ": " + m_WavFile.errorString());
+	return false;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to (re)write the 44 byte header of the
+// 16 bit mono PCM WAV file with the sizes written so far.
+/////////////////////////////////////////////////////////////////////
+void CAudioRecorder::WriteWavHeader()
+{
+uchar hdr[44];
+quint32 datasize = (quint32)(m_SamplesWritten*sizeof(qint16));
+	memcpy(&hdr[0], "RIFF", 4);
+	qToLittleEndian<quint32>(36 + datasize, &hdr[4]);
+	memcpy(&hdr[8], "WAVEfmt ", 8);
+	qToLittleEndian<quint32>(16, &hdr[16]);		//fmt chunk size
+	qToLittleEndian<quint16>(1, &hdr[20]);		//PCM
+	qToLittleEndian<quint16>(1, &hdr[22]);		//channels
+	qToLittleEndian<quint32>(AUDIOREC_RATE, &hdr[24]);
+	qToLittleEndian<quint32>(AUDIOREC_RATE*sizeof(qint16), &hdr[28]);	//bytes per second
+	qToLittleEndian<quint16>(sizeof(qint16), &hdr[32]);	//block align
+	qToLittleEndian<quint16>(16, &hdr[34]);		//bits per sample
+	memcpy(&hdr[36], "data", 4);
+	qToLittleEndian<quint32>(datasize, &hdr[40]);
+	m_WavFile.seek(0);
+	m_WavFile.write((const char*)hdr, sizeof(hdr));
+	m_WavFile.seek(sizeof(hdr) + datasize);
+}
@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////
+// audiorecorder.h: interface for the CAudioRecorder class.
+//
+//  Records the decoded 8Ksps receive audio to WAV or, when built with
+// libFLAC, FLAC files.  The network thread only copies each packet
+// into a lock free ring.  The recorder's own worker thread does all
+// file I/O and encoding.  In squelch gated mode a new file is started
+// each time the squelch opens and closed when it has stayed closed for
+// AUDIOREC_HANG_TIME so only the active parts of a channel use disk.
+//  WAV files hold 32 bit sizes so a recording continues in a new file
+// named BaseName_N once a file reaches AUDIOREC_MAX_WAV_BYTES.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef AUDIORECORDER_H
+#define AUDIORECORDER_H
+
+#include <QAtomicInt>
+#include <QFile>
+#include <QString>
+#include "threadwrapper.h"
+#include "spscring.h"
+#ifdef ENABLE_FLAC
+#include <FLAC/stream_encoder.h>
+#endif
+
+#define AUDIOREC_RATE 8000
+#define AUDIOREC_RING_SIZE (1024*1024)		//bytes, about 1 minute of audio
+#define AUDIOREC_WAKE_SIZE (32*1024)		//bytes waiting before the writer is woken
+#define AUDIOREC_BLOCK 1024					//samples written at a time
+#define AUDIOREC_HANG_TIME 2.0				//seconds squelch must stay closed to end a segment
+#define AUDIOREC_MAX_PUT 4096				//most samples in one PutAudio() call
+#define AUDIOREC_MAX_WAV_BYTES 0x7FFF0000LL	//WAV data per file, under 2GB for readers using signed sizes
+
+#define AUDIOREC_FORMAT_WAV 0
+#define AUDIOREC_FORMAT_FLAC 1
+
+//header in front of every packet in the ring
+typedef struct
+{
+	qint32 Length;		//number of samples
+	qint32 Squelched;	//nonzero if squelch was closed, no samples follow
+} taudiorechdr;
+
+class CAudioRecorder : public CThreadWrapper
+{
+	Q_OBJECT
+public:
+	CAudioRecorder();
+	virtual ~CAudioRecorder();
+
+	//BaseName is the path without extension.  Gated recordings add the
+	//UTC start time of each segment to BaseName.  RecordingFailed() is
+	//emitted if a file cannot be opened or written.
+	void Start(const QString& BaseName, int Format, bool Gated){emit StartSig(BaseName, Format, Gated);}
+	void Stop(){emit StopSig();}
+	bool IsRecording(){return m_Recording.load() != 0;}
+	static bool IsFlacSupported();
+	int GetPacketsDropped(){return m_PacketsDropped.load();}
+
+	//called by network thread
+	void PutAudio(const qint16* pBuf, int Length, bool Squelched);
+
+signals:
+	void StartSig(QString BaseName, int Format, bool Gated);
+	void StopSig();
+	void NewData();
+	void RecordingFailed(QString Reason);	//recording stopped by a file error
+
+private slots:
+	void ThreadInit();	//override function is called by new thread when started
+	void ThreadExit();	//override function is called by thread before exiting
+	void StartSlot(QString BaseName, int Format, bool Gated);
+	void StopSlot();
+	void WriteData();
+
+private:
+	bool OpenFile();
+	void CloseFile();
+	bool IsFileOpen();
+	void WriteRing();
+	bool WriteSamples(const qint16* pBuf, int Length);
+	void WriteWavHeader();
+
+	QAtomicInt m_Recording;
+	QAtomicInt m_DataPending;		//set when NewData emitted and not handled yet
+	QAtomicInt m_PacketsDropped;	//network data lost because the ring was full
+	bool m_LastSquelched;			//network thread only
+	int m_PutSquelchedSamples;		//network thread only, squelched samples since the last wake
+	char m_PutBuf[sizeof(taudiorechdr) + AUDIOREC_MAX_PUT*sizeof(qint16)];	//network thread only
+	CSpscRing m_Ring;
+	qint16 m_WriteBuf[AUDIOREC_BLOCK];
+	QString m_BaseName;
+	int m_Format;
+	bool m_Gated;
+	int m_HangSamples;			//squelched samples since squelch closed
+	int m_FileIndex;			//files started by this ungated recording
+	qint64 m_SamplesWritten;	//to current file
+	QFile m_WavFile;
+#ifdef ENABLE_FLAC
+	FLAC__StreamEncoder* m_pFlacEncoder;
+	FLAC__int32 m_FlacBuf[AUDIOREC_BLOCK];
+#endif
+};
+
+#endif // AUDIORECORDER_H
@@ -0,0 +1,326 @@
+//////////////////////////////////////////////////////////////////////
+// iqrecorder.cpp: implementation of the CIqRecorder class.
+//
+//  The writer thread is woken when a full block is waiting in the
+// ring and writes whole IQREC_BLOCK_SIZE blocks with unbuffered
+// writes.  On Linux file space is reserved IQREC_PREALLOC_SIZE at a
+// time with fallocate(FALLOC_FL_KEEP_SIZE) so the file size is always
+// the data written and long recordings do not fragment.
+//  A sample rate change ends the file at the exact sample it happened
+// and the recording continues in BaseName_N since a SigMF recording
+// has one sample rate.  A frequency change adds a capture segment.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "iqrecorder.h"
+#include <QDateTime>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+/////////////////////////////////////////////////////////////////////
+CIqRecorder::CIqRecorder() : m_Ring(IQREC_RING_SIZE)
+{
+	m_Recording.store(0);
+	m_DataPending.store(0);
+	m_BlocksDropped.store(0);
+	m_SplitPending.store(0);
+	m_SplitRate.store(0);
+	m_PutRate.store(0);
+	m_SplitSample.store(0);
+	m_SamplesPut.store(0);
+	m_BytesWritten.store(0);
+	m_CapturesChanged = false;
+	m_Frequency = 0;
+	m_FileIndex = 0;
+	m_SampleRate = 16000;
+	m_pWriteBuf = new char[IQREC_BLOCK_SIZE];
+}
+
+CIqRecorder::~CIqRecorder()
+{
+	qDebug()<<"CIqRecorder destructor";
+	CleanupThread();	//tell thread to cleanup after itself by calling ThreadExit()
+	delete [] m_pWriteBuf;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Thread functions
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::ThreadInit()	//overrided funciton is called by new thread when started
+{
+	connect(this,SIGNAL( StartSig(QString,int,qint64)), this, SLOT(StartSlot(QString,int,qint64)) );
+	connect(this,SIGNAL( StopSig()), this, SLOT(StopSlot()) );
+	connect(this,SIGNAL( NewData()), this, SLOT(WriteData()) );
+}
+
+void CIqRecorder::ThreadExit()
+{
+	StopSlot();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by network thread with interleaved 8 bit I/Q bytes.
+// Never blocks, data is counted as dropped if the ring is full.
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::PutIqData(const qint8* pBuf, int Length)
+{
+	if(!m_Recording.load())
+		return;
+	Length &= ~1;
+	if(!m_Ring.Put((const char*)pBuf, Length))
+	{
+		m_BlocksDropped.fetchAndAddRelaxed(1);
+		return;
+	}
+	m_SamplesPut.fetchAndAddRelease(Length/2);
+	//only wake the writer when there is a full block to write
+	if( (m_Ring.Available() >= IQREC_BLOCK_SIZE) && m_DataPending.testAndSetOrdered(0, 1) )
+		emit NewData();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by network thread when the raw mode is set.  If the rate
+// changed it marks the sample where the writer has to switch files.
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::SetSampleRate(int SampleRate)
+{
+	if(!m_Recording.load() || (SampleRate == m_PutRate.load()))
+		return;
+	m_PutRate.store(SampleRate);
+	m_SplitSample.store(m_SamplesPut.load());
+	m_SplitRate.store(SampleRate);
+	m_SplitPending.storeRelease(1);
+	if(m_DataPending.testAndSetOrdered(0, 1))
+		emit NewData();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by GUI thread when the receiver is tuned
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::SetFrequency(qint64 Frequency)
+{
+tiqcapture capture;
+	m_Mutex.lock();
+	m_Frequency = Frequency;
+	if(m_Recording.load())
+	{
+		capture.SampleStart = m_SamplesPut.load();
+		capture.Frequency = Frequency;
+		capture.DateTime = QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH:mm:ss.zzzZ");
+		m_Captures.append(capture);
+		m_CapturesChanged = true;
+	}
+	m_Mutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Worker thread slots
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::StartSlot(QString BaseName, int SampleRate, qint64 Frequency)
+{
+char tmp[256];
+	StopSlot();
+	while(m_Ring.Get(tmp, sizeof(tmp)) > 0)
+		;		//throw away anything put while stopping
+	m_BaseName = BaseName;
+	m_FileIndex = 0;
+	m_SampleRate = SampleRate;
+	m_PutRate.store(SampleRate);
+	m_SamplesPut.store(0);
+	m_SplitPending.store(0);
+	m_BlocksDropped.store(0);
+	m_BytesWritten.store(0);
+	m_Mutex.lock();
+	m_Frequency = Frequency;
+	m_Captures.clear();
+	m_Mutex.unlock();
+	m_FileStartSample = 0;
+	if(OpenFile())
+		m_Recording.storeRelease(1);
+}
+
+void CIqRecorder::StopSlot()
+{
+	if(!m_DataFile.isOpen())
+		return;
+	m_Recording.store(0);
+	WriteRing(true);
+	CloseFile();
+}
+
+void CIqRecorder::WriteData()
+{
+	m_DataPending.storeRelease(0);
+	if(m_DataFile.isOpen())
+		WriteRing(false);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to open the next data file and write its
+// metadata.  The first capture segment starts at the file start with
+// the frequency tuned at that sample.  Captures of earlier files are
+// dropped, ones already added past the file start are kept.
+/////////////////////////////////////////////////////////////////////
+bool CIqRecorder::OpenFile()
+{
+tiqcapture capture;
+	if(m_FileIndex)
+		m_FileName = QString("%1_%2").arg(m_BaseName).arg(m_FileIndex);
+	else
+		m_FileName = m_BaseName;
+	m_FileIndex++;
+	m_DataFile.setFileName(m_FileName + ".sigmf-data");
+	if(!m_DataFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+	{
+		qDebug()<<"IQ recorder open failed "<<m_DataFile.fileName();
+		emit RecordingFailed(m_DataFile.fileName() + ": " + m_DataFile.errorString());
+		return false;
+	}
+	m_SamplesWritten = 0;
+	m_Allocated = 0;
+	m_Mutex.lock();
+	capture.Frequency = m_Frequency;
+	while( !m_Captures.isEmpty() && (m_Captures.first().SampleStart <= m_FileStartSample) )
+		capture.Frequency = m_Captures.takeFirst().Frequency;
+	capture.SampleStart = m_FileStartSample;
+	capture.DateTime = QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH:mm:ss.zzzZ");
+	m_Captures.prepend(capture);
+	m_CapturesChanged = false;
+	m_Mutex.unlock();
+	WriteMetaData();
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to end the current data file.  Setting the
+// size gives back the space fallocate() reserved past the data.
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::CloseFile()
+{
+	if(!m_DataFile.isOpen())
+		return;
+	m_DataFile.resize(2*m_SamplesWritten);
+	m_DataFile.close();
+	WriteMetaData();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to move ring data to the file in whole
+// blocks.  Flush also writes the last partial block.
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::WriteRing(bool Flush)
+{
+qint64 limit;
+int n;
+	while(m_DataFile.isOpen())
+	{
+		n = m_Ring.Available();
+		if(m_SplitPending.loadAcquire())
+		{
+			limit = 2*(m_SplitSample.load() - m_FileStartSample - m_SamplesWritten);
+			if(limit <= 0)
+			{	//reached the rate change so continue in a new file
+				CloseFile();
+				m_FileStartSample = m_SplitSample.load();
+				m_SampleRate = m_SplitRate.load();
+				m_SplitPending.store(0);
+				if(!OpenFile())
+					m_Recording.store(0);
+				continue;
+			}
+			if(n > limit)
+				n = (int)limit;
+		}
+		else if(!Flush && (n < IQREC_BLOCK_SIZE))
+			break;
+		if(n <= 0)
+			break;
+		if(n > IQREC_BLOCK_SIZE)
+			n = IQREC_BLOCK_SIZE;
+		n = m_Ring.Get(m_pWriteBuf, n);
+		if(!WriteBlock(n))
+		{
+			m_Recording.store(0);
+			CloseFile();
+			return;
+		}
+	}
+	m_Mutex.lock();
+	if(m_CapturesChanged && m_DataFile.isOpen())
+	{
+		m_CapturesChanged = false;
+		m_Mutex.unlock();
+		WriteMetaData();
+		return;
+	}
+	m_Mutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to write Length bytes of m_pWriteBuf,
+// reserving more file space first if needed.
+/////////////////////////////////////////////////////////////////////
+bool CIqRecorder::WriteBlock(int Length)
+{
+qint64 pos = 2*m_SamplesWritten;
+	if( (pos + Length) > m_Allocated)
+	{
+#ifdef Q_OS_LINUX
+		if(0 == fallocate(m_DataFile.handle(), FALLOC_FL_KEEP_SIZE, m_Allocated, IQREC_PREALLOC_SIZE))
+			m_Allocated += IQREC_PREALLOC_SIZE;
+		else
+#endif
+			m_Allocated = Q_INT64_C(0x7FFFFFFFFFFFFFFF);	//not supported so stop trying
+	}
+	if(m_DataFile.write(m_pWriteBuf, Length) != Length)
+	{
+		qDebug()<<"IQ recorder write failed "<<m_DataFile.errorString();
+		emit RecordingFailed(m_DataFile.fileName() + ": " + m_DataFile.errorString());
+		return false;
+	}
+	m_SamplesWritten += Length/2;
+	m_BytesWritten.fetchAndAddRelaxed(Length);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread to (re)write the SigMF metadata file of the
+// current data file.
+/////////////////////////////////////////////////////////////////////
+void CIqRecorder::WriteMetaData()
+{
+QJsonObject global;
+QJsonObject root;
+QJsonArray captures;
+QSaveFile file(m_FileName + ".sigmf-meta");
+	global.insert("core:datatype", QString("ci8"));
+	global.insert("core:sample_rate", (double)m_SampleRate);
+	global.insert("core:version", QString("1.0.0"));
+	global.insert("core:recorder", QString("RemoteSdrClient"));
+	global.insert("core:description", QString("Raw I/Q from a remote SDR server"));
+	m_Mutex.lock();
+	for(int i=0; i<m_Captures.size(); i++)
+	{
+		QJsonObject capture;
+		capture.insert("core:sample_start", (double)(m_Captures[i].SampleStart - m_FileStartSample));
+		capture.insert("core:frequency", (double)m_Captures[i].Frequency);
+		capture.insert("core:datetime", m_Captures[i].DateTime);
+		captures.append(capture);
+	}
+	m_Mutex.unlock();
+	root.insert("global", global);
+	root.insert("captures", captures);
+	root.insert("annotations", QJsonArray());
+	if(!file.open(QIODevice::WriteOnly))
+		return;
+	file.write(QJsonDocument(root).toJson());
+	file.commit();
+}
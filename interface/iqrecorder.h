@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////
+// iqrecorder.h: interface for the CIqRecorder class.
+//
+//  Records the raw 8 bit I/Q stream as a SigMF recording, a
+// .sigmf-data file of ci8 samples plus a .sigmf-meta JSON sidecar.
+// The network thread only copies data into a lock free ring.  All
+// file I/O is done by the recorder's own worker thread in large
+// blocks into space preallocated ahead of the writes.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef IQRECORDER_H
+#define IQRECORDER_H
+
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include "threadwrapper.h"
+#include "spscring.h"
+
+#define IQREC_RING_SIZE (4*1024*1024)		//bytes, over 2 minutes at 16Ksps
+#define IQREC_BLOCK_SIZE (256*1024)			//bytes per file write
+#define IQREC_PREALLOC_SIZE (64*1024*1024)	//file space reserved at a time
+
+typedef struct
+{
+	qint64 SampleStart;		//samples since the recording started
+	qint64 Frequency;
+	QString DateTime;		//ISO 8601 UTC
+} tiqcapture;
+
+class CIqRecorder : public CThreadWrapper
+{
+	Q_OBJECT
+public:
+	CIqRecorder();
+	virtual ~CIqRecorder();
+
+	//BaseName is the path without the .sigmf-data/.sigmf-meta extension
+	void Start(const QString& BaseName, int SampleRate, qint64 Frequency){emit StartSig(BaseName, SampleRate, Frequency);}
+	void Stop(){emit StopSig();}
+	bool IsRecording(){return m_Recording.load() != 0;}
+	void SetFrequency(qint64 Frequency);		//called by GUI thread, starts a new capture segment
+	int GetBlocksDropped(){return m_BlocksDropped.load();}
+	qint64 GetBytesWritten(){return m_BytesWritten.load();}
+
+	//called by network thread
+	void PutIqData(const qint8* pBuf, int Length);
+	void SetSampleRate(int SampleRate);		//continues in a new file at the new rate
+
+signals:
+	void StartSig(QString BaseName, int SampleRate, qint64 Frequency);
+	void StopSig();
+	void NewData();
+	void RecordingFailed(QString Reason);	//recording stopped by a file error
+
+private slots:
+	void ThreadInit();	//override function is called by new thread when started
+	void ThreadExit();	//override function is called by thread before exiting
+	void StartSlot(QString BaseName, int SampleRate, qint64 Frequency);
+	void StopSlot();
+	void WriteData();
+
+private:
+	bool OpenFile();
+	void CloseFile();
+	void WriteRing(bool Flush);
+	bool WriteBlock(int Length);
+	void WriteMetaData();
+
+	QAtomicInt m_Recording;
+	QAtomicInt m_DataPending;		//set when NewData emitted and not handled yet
+	QAtomicInt m_BlocksDropped;		//network data lost because the ring was full
+	QAtomicInt m_SplitPending;		//sample rate changed at m_SplitSample
+	QAtomicInt m_SplitRate;
+	QAtomicInt m_PutRate;			//rate of the data being put
+	QAtomicInteger<qint64> m_SamplesPut;
+	QAtomicInteger<qint64> m_SplitSample;
+	QAtomicInteger<qint64> m_BytesWritten;
+	bool m_CapturesChanged;		//uses m_Mutex
+	QList<tiqcapture> m_Captures;	//uses m_Mutex
+	qint64 m_Frequency;			//uses m_Mutex
+	CSpscRing m_Ring;
+	char* m_pWriteBuf;
+	QFile m_DataFile;
+	QString m_BaseName;
+	QString m_FileName;			//current file without extension
+	int m_FileIndex;
+	int m_SampleRate;
+	qint64 m_FileStartSample;	//m_SamplesPut count at start of current file
+	qint64 m_SamplesWritten;	//to current file
+	qint64 m_Allocated;			//bytes reserved in current file
+};
+
+#endif // IQRECORDER_H
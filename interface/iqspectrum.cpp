@@ -0,0 +1,342 @@
+//////////////////////////////////////////////////////////////////////
+// iqspectrum.cpp: implementation of the CIqSpectrum class.
+//
+//  Raw I/Q bytes are converted to float, windowed and FFT'd with
+// the selected overlap.  FFT power is summed until it is time for a
+// new plot frame, then averaged across frames, reduced to the plot
+// bin count by taking the max of the FFT bins in each plot bin and
+// scaled to 0-255 between MindB and MaxdB like the server video data.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "iqspectrum.h"
+#include "dsp/vectorops.h"
+#include <math.h>
+
+/////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+/////////////////////////////////////////////////////////////////////
+CIqSpectrum::CIqSpectrum() : m_RawRing(IQSPEC_RAW_RING_SIZE),
+	m_FrameRing(IQSPEC_FRAME_RING_SIZE)
+{
+	m_Enabled.store(0);
+	m_DataPending.store(0);
+	m_FramePending.store(0);
+	m_FramesDropped.store(0);
+	m_NewSetup.FftSize = IQSPEC_DEFAULT_FFTSIZE;
+	m_NewSetup.Window = IQSPEC_WINDOW_HANN;
+	m_NewSetup.Overlap = 50;
+	m_NewSetup.Bins = 0;
+	m_NewSetup.Span = 16000;
+	m_NewSetup.MaxdB = 0;
+	m_NewSetup.MindB = -120;
+	m_NewSetup.Ave = 1;
+	m_NewSetup.Rate = 10;
+	m_NewSetup.SampleRate = 16000;
+	m_Setup = m_NewSetup;
+	m_InPos = 0;
+	m_SetupChanged = true;
+}
+
+CIqSpectrum::~CIqSpectrum()
+{
+	qDebug()<<"CIqSpectrum destructor";
+	CleanupThread();	//tell thread to cleanup after itself by calling ThreadExit()
+}
+
+/////////////////////////////////////////////////////////////////////
+// Thread functions
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::ThreadInit()	//overrided funciton is called by new thread when started
+{
+	connect(this,SIGNAL( NewIqData()), this, SLOT(ProcessIqData()) );
+}
+
+void CIqSpectrum::ThreadExit()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Settings, called by GUI or network thread.  The worker thread picks
+// them up with the next block of raw data.
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::SetEnabled(bool On)
+{
+	m_Mutex.lock();
+	m_Enabled.store(On ? 1 : 0);
+	m_SetupChanged = true;		//start clean with new data
+	m_Mutex.unlock();
+}
+
+void CIqSpectrum::SetupFft(int FftSize, int Window, int OverlapPercent)
+{
+	if( (FftSize < 64) || (FftSize > MAX_FFT_SIZE) || (FftSize & (FftSize-1)) )
+		FftSize = IQSPEC_DEFAULT_FFTSIZE;
+	if(OverlapPercent < 0)
+		OverlapPercent = 0;
+	if(OverlapPercent > 90)
+		OverlapPercent = 90;
+	m_Mutex.lock();
+	m_NewSetup.FftSize = FftSize;
+	m_NewSetup.Window = Window;
+	m_NewSetup.Overlap = OverlapPercent;
+	m_SetupChanged = true;
+	m_Mutex.unlock();
+}
+
+void CIqSpectrum::SetupDisplay(int Bins, int Span, int MaxdB, int MindB, int Ave, int Rate)
+{
+	if(Bins > IQSPEC_MAX_BINS)
+		Bins = IQSPEC_MAX_BINS;
+	if(MaxdB <= MindB)
+		MaxdB = MindB + 10;
+	m_Mutex.lock();
+	m_NewSetup.Bins = Bins;
+	m_NewSetup.Span = Span;
+	m_NewSetup.MaxdB = MaxdB;
+	m_NewSetup.MindB = MindB;
+	m_NewSetup.Ave = (Ave < 1) ? 1 : Ave;
+	m_NewSetup.Rate = (Rate < 1) ? 1 : Rate;
+	m_SetupChanged = true;
+	m_Mutex.unlock();
+}
+
+void CIqSpectrum::SetSampleRate(int SampleRate)
+{
+	m_Mutex.lock();
+	if(SampleRate != m_NewSetup.SampleRate)
+	{
+		m_NewSetup.SampleRate = SampleRate;
+		m_SetupChanged = true;
+	}
+	m_Mutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by network thread with interleaved 8 bit I/Q bytes.
+// Data is dropped if the worker thread has fallen 2 seconds behind.
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::PutIqData(const qint8* pBuf, int NumBytes)
+{
+	if(!m_Enabled.load())
+		return;
+	if(!m_RawRing.Put((const char*)pBuf, NumBytes & ~1))
+		return;
+	if(m_DataPending.testAndSetOrdered(0, 1))
+		emit NewIqData();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by GUI thread to get the next plot frame.
+// Returns number of points copied or 0 if no frame is waiting.
+/////////////////////////////////////////////////////////////////////
+int CIqSpectrum::GetFrame(quint8* pData, int MaxLength)
+{
+int len;
+	if( (int)sizeof(tiqspecframe) != m_FrameRing.Get((char*)&m_OutFrame, sizeof(tiqspecframe)) )
+	{
+		m_FramePending.storeRelease(0);
+		//catch a frame put after the failed Get but before the flag was cleared
+		if( (int)sizeof(tiqspecframe) != m_FrameRing.Get((char*)&m_OutFrame, sizeof(tiqspecframe)) )
+			return 0;
+	}
+	len = m_OutFrame.Length;
+	if(len > MaxLength)
+		len = MaxLength;
+	memcpy(pData, m_OutFrame.Data, len);
+	return len;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Worker thread slot, drains the raw ring and runs an FFT every m_Hop
+// new samples.  m_Mutex is only held to pick up new settings so the
+// FFTs never hold up the thread changing them.
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::ProcessIqData()
+{
+int i;
+int n;
+	m_DataPending.storeRelease(0);
+	while( (n = m_RawRing.Get((char*)m_RawBuf, sizeof(m_RawBuf))) > 0 )
+	{
+		if(!m_Enabled.load())
+			continue;	//just empty the ring
+		if( TakeSetup() )
+			Setup();
+		VecS8ToFloat(m_RawBuf, m_FloatBuf, n);
+		for(i=0; i<n; i+=2)
+		{
+			m_InBuf[m_InPos].re = m_FloatBuf[i];
+			m_InBuf[m_InPos].im = m_FloatBuf[i+1];
+			if(++m_InPos >= m_Setup.FftSize)
+			{
+				ProcessFft();
+				//keep the overlapped samples for the next FFT
+				memmove(m_InBuf, &m_InBuf[m_Hop], (m_Setup.FftSize-m_Hop)*sizeof(TYPECPX));
+				m_InPos = m_Setup.FftSize - m_Hop;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by the worker thread to copy new settings into m_Setup.
+// Returns true if they changed since the last call.
+/////////////////////////////////////////////////////////////////////
+bool CIqSpectrum::TakeSetup()
+{
+bool changed;
+	m_Mutex.lock();
+	changed = m_SetupChanged;
+	if(changed)
+		m_Setup = m_NewSetup;
+	m_SetupChanged = false;
+	m_Mutex.unlock();
+	return changed;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by the worker thread to build the window and plot bin tables
+// from m_Setup and restart averaging after any settings change.
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::Setup()
+{
+int i;
+int N = m_Setup.FftSize;
+double x;
+double sumw = 0.0;
+double f0;
+double f1;
+	m_Fft.SetSize(N);
+	m_Hop = N - (N*m_Setup.Overlap)/100;
+	for(i=0; i<N; i++)
+	{
+		x = K_2PI*(double)i/(double)N;
+		switch(m_Setup.Window)
+		{
+			case IQSPEC_WINDOW_RECT:
+				m_WindowTbl[i] = 1.0;
+				break;
+			case IQSPEC_WINDOW_BLACKMANHARRIS:
+				m_WindowTbl[i] = 0.35875 - 0.48829*cos(x) + 0.14128*cos(2.0*x) - 0.01168*cos(3.0*x);
+				break;
+			case IQSPEC_WINDOW_HANN:
+			default:
+				m_WindowTbl[i] = 0.5 - 0.5*cos(x);
+				break;
+		}
+		sumw += m_WindowTbl[i];
+	}
+	//a full scale (127) complex sine ends up in one bin with power (127*sumw)^2
+	m_dBOffset = IQSPEC_FULLSCALE_DB - 20.0*log10(127.0*sumw);
+	//plot bin i covers Span/Bins Hz starting at -Span/2, FFT bin b is
+	//at (b-N/2)*SampleRate/N Hz after the DC to middle reorder
+	for(i=0; i<m_Setup.Bins; i++)
+	{
+		f0 = (double)m_Setup.Span*( (double)i/(double)m_Setup.Bins - 0.5);
+		f1 = f0 + (double)m_Setup.Span/(double)m_Setup.Bins;
+		m_BinStart[i] = (int)floor(f0*N/m_Setup.SampleRate + N/2 + 0.5);
+		m_BinEnd[i] = (int)floor(f1*N/m_Setup.SampleRate + N/2 + 0.5);
+		if(m_BinEnd[i] <= m_BinStart[i])
+			m_BinEnd[i] = m_BinStart[i] + 1;	//zoomed in past FFT resolution
+		if(m_BinStart[i] < 0)
+			m_BinStart[i] = 0;
+		if(m_BinEnd[i] > N)
+			m_BinEnd[i] = N;
+		if(m_BinStart[i] >= m_BinEnd[i])
+			m_BinStart[i] = m_BinEnd[i] = 0;	//outside the raw bandwidth
+	}
+	m_FrameSamples = m_Setup.SampleRate/m_Setup.Rate;
+	m_InPos = 0;
+	m_NumSummed = 0;
+	m_SamplesSinceFrame = 0;
+	m_AveValid = false;
+	for(i=0; i<N; i++)
+		m_PwrSum[i] = 0.0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Windows and FFT's m_InBuf and adds the power into m_PwrSum
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::ProcessFft()
+{
+int i;
+int N = m_Setup.FftSize;
+int mask = N-1;
+int half = N/2;
+	for(i=0; i<N; i++)
+	{
+		m_FftBuf[i].re = m_InBuf[i].re * m_WindowTbl[i];
+		m_FftBuf[i].im = m_InBuf[i].im * m_WindowTbl[i];
+	}
+	m_Fft.Forward(m_FftBuf);
+	//swap halves so negative frequencies come first
+	for(i=0; i<N; i++)
+		m_PwrSum[(i+half) & mask] += m_FftBuf[i].re*m_FftBuf[i].re + m_FftBuf[i].im*m_FftBuf[i].im;
+	m_NumSummed++;
+	m_SamplesSinceFrame += m_Hop;
+	if(m_SamplesSinceFrame >= m_FrameSamples)
+	{
+		m_SamplesSinceFrame -= m_FrameSamples;
+		if(m_SamplesSinceFrame >= m_FrameSamples)
+			m_SamplesSinceFrame = 0;		//FFT hop is longer than frame period
+		OutputFrame();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Averages the summed power, converts it to a 0-255 plot frame and
+// passes it to the GUI thread.
+/////////////////////////////////////////////////////////////////////
+void CIqSpectrum::OutputFrame()
+{
+int i;
+int k;
+int v;
+float p;
+float pmax;
+float alpha = 1.0/(float)m_Setup.Ave;
+float scale = 255.0/(float)(m_Setup.MaxdB - m_Setup.MindB);
+	for(k=0; k<m_Setup.FftSize; k++)
+	{
+		p = m_PwrSum[k]/(float)m_NumSummed;
+		if(m_AveValid)
+			m_PwrAve[k] += alpha*(p - m_PwrAve[k]);
+		else
+			m_PwrAve[k] = p;
+		m_PwrSum[k] = 0.0;
+	}
+	m_NumSummed = 0;
+	m_AveValid = true;
+	if(m_Setup.Bins <= 0)
+		return;
+	for(i=0; i<m_Setup.Bins; i++)
+	{
+		if(m_BinStart[i] == m_BinEnd[i])
+		{
+			m_Frame.Data[i] = 0;
+			continue;
+		}
+		pmax = m_PwrAve[m_BinStart[i]];
+		for(k=m_BinStart[i]+1; k<m_BinEnd[i]; k++)
+		{
+			if(m_PwrAve[k] > pmax)
+				pmax = m_PwrAve[k];
+		}
+		v = (int)( (10.0*log10(pmax + 1e-20) + m_dBOffset - m_Setup.MindB)*scale );
+		if(v < 0)
+			v = 0;
+		if(v > 255)
+			v = 255;
+		m_Frame.Data[i] = (quint8)v;
+	}
+	m_Frame.Length = m_Setup.Bins;
+	if(!m_FrameRing.Put((const char*)&m_Frame, sizeof(tiqspecframe)))
+	{
+		m_FramesDropped.fetchAndAddRelaxed(1);
+		return;
+	}
+	if(m_FramePending.testAndSetOrdered(0, 1))
+		emit NewFrame();
+}
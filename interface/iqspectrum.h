@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////
+// iqspectrum.h: interface for the CIqSpectrum class.
+//
+//  Computes the plot spectrum locally from the raw 8 bit I/Q stream
+// on its own worker thread.  Raw data comes in from the network
+// thread and finished 0-255 plot frames go out to the GUI thread,
+// both through lock free rings.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef IQSPECTRUM_H
+#define IQSPECTRUM_H
+
+#include <QAtomicInt>
+#include "threadwrapper.h"
+#include "spscring.h"
+#include "dsp/fft.h"
+
+#define IQSPEC_MAX_BINS 3000		//same as MAX_VIDEO_LENGTH
+#define IQSPEC_RAW_RING_SIZE 65536	//raw I/Q bytes, 2 seconds at 16Ksps
+#define IQSPEC_FRAME_RING_SIZE 32768
+#define IQSPEC_DEFAULT_FFTSIZE 2048
+#define IQSPEC_FULLSCALE_DB 0		//dB value plotted for a full scale raw I/Q sine
+
+#define IQSPEC_WINDOW_RECT 0
+#define IQSPEC_WINDOW_HANN 1
+#define IQSPEC_WINDOW_BLACKMANHARRIS 2
+
+typedef struct
+{
+	int FftSize;
+	int Window;
+	int Overlap;		//percent
+	int Bins;
+	int Span;
+	int MaxdB;
+	int MindB;
+	int Ave;
+	int Rate;
+	int SampleRate;
+} tiqspecsetup;
+
+typedef struct
+{
+	quint16 Length;
+	quint8 Data[IQSPEC_MAX_BINS];
+} __attribute__ ((__packed__)) tiqspecframe;
+
+class CIqSpectrum : public CThreadWrapper
+{
+	Q_OBJECT
+public:
+	CIqSpectrum();
+	virtual ~CIqSpectrum();
+
+	void SetEnabled(bool On);
+	bool IsEnabled(){return m_Enabled.load() != 0;}
+	void SetupFft(int FftSize, int Window, int OverlapPercent);
+	void SetupDisplay(int Bins, int Span, int MaxdB, int MindB, int Ave, int Rate);
+	void SetSampleRate(int SampleRate);
+	int GetFramesDropped(){return m_FramesDropped.load();}
+
+	void PutIqData(const qint8* pBuf, int NumBytes);	//called by network thread
+	int GetFrame(quint8* pData, int MaxLength);			//called by GUI thread, returns 0 if none
+
+signals:
+	void NewFrame();
+	void NewIqData();
+
+private slots:
+	void ThreadInit();	//override function is called by new thread when started
+	void ThreadExit();	//override function is called by thread before exiting
+	void ProcessIqData();
+
+private:
+	bool TakeSetup();
+	void Setup();
+	void ProcessFft();
+	void OutputFrame();
+
+	QAtomicInt m_Enabled;
+	QAtomicInt m_DataPending;	//set when NewIqData emitted and raw ring not drained yet
+	QAtomicInt m_FramePending;	//set when NewFrame emitted and frame ring not drained yet
+	QAtomicInt m_FramesDropped;
+	bool m_SetupChanged;		//m_NewSetup changed, uses m_Mutex
+	tiqspecsetup m_NewSetup;	//set by other threads, uses m_Mutex
+	tiqspecsetup m_Setup;		//copy used by the worker thread without the lock
+	int m_Hop;					//new samples per FFT
+	int m_InPos;				//samples in m_InBuf
+	int m_NumSummed;			//FFTs in m_PwrSum
+	int m_FrameSamples;			//samples per output frame
+	int m_SamplesSinceFrame;
+	bool m_AveValid;
+	float m_dBOffset;			//scales FFT power to dB
+	CSpscRing m_RawRing;
+	CSpscRing m_FrameRing;
+	CFft m_Fft;
+	qint8 m_RawBuf[2*MAX_FFT_SIZE];
+	float m_FloatBuf[2*MAX_FFT_SIZE];
+	TYPECPX m_InBuf[MAX_FFT_SIZE];
+	TYPECPX m_FftBuf[MAX_FFT_SIZE];
+	float m_WindowTbl[MAX_FFT_SIZE];
+	float m_PwrSum[MAX_FFT_SIZE];	//in frequency order, DC in the middle
+	float m_PwrAve[MAX_FFT_SIZE];
+	int m_BinStart[IQSPEC_MAX_BINS];	//FFT bins [start,end) shown in each plot bin
+	int m_BinEnd[IQSPEC_MAX_BINS];
+	tiqspecframe m_Frame;		//being built by worker thread
+	tiqspecframe m_OutFrame;	//being read by GUI thread
+};
+
+#endif // IQSPECTRUM_H
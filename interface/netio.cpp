@@ -41,6 +41,7 @@
 /*---------------------------------------------------------------------------*/
 #include <QtNetwork>
 #include <QDebug>
+#include <string.h>
 #include "netio.h"
 
 #define TCP_CONNECT_TIMELIMIT 100	//time to wait for connect in 100mSec steps
@@ -48,9 +49,12 @@
 /////////////////////////////////////////////////////////////////////
 // Constructor/Destructor
 /////////////////////////////////////////////////////////////////////
-CTcp::CTcp(QObject *parent) : m_pParent(parent)
+CTcp::CTcp(QObject *parent) : m_TxAudioQ(TXAUDIOQ_SIZE),
+	m_pParent(parent)
 {
 	m_pTcpClient = NULL;
+	m_pSendTimer = NULL;
+	m_TxCoalesceTime.store(TX_COALESCE_TIME);
 //	qDebug()<<"CTcp constructor";
 }
 
@@ -66,16 +70,24 @@ CTcp::~CTcp()
 void CTcp::ThreadInit()	//override called by new thread when started
 {
 //qDebug()<<"CTcp Thread Init "<<this->thread()->currentThread();
+	m_TxLength = 0;
 	m_TxPosition = 0;
+	((CNetio*)m_pParent)->ResetRx();
 	m_pTcpClient = new QTcpSocket;	//must be deleted in this same thread
 									//by calling CleanupThread() in destructor
 	connect(m_pTcpClient, SIGNAL(readyRead()), this, SLOT(ReadTcpDataSlot()));
+	connect(m_pTcpClient, SIGNAL(bytesWritten(qint64)), this, SLOT(SendSlot()));
+	m_pSendTimer = new QTimer;	//single shot timer sets the Tx msg collection window
+	m_pSendTimer->setSingleShot(true);
+	m_pSendTimer->setTimerType(Qt::PreciseTimer);
+	connect(m_pSendTimer, SIGNAL(timeout()), this, SLOT(FlushSlot()));
 	connect(m_pTcpClient, SIGNAL(stateChanged(QAbstractSocket::SocketState)),
 			this, SLOT(TcpStateChangedSlot(QAbstractSocket::SocketState)));
 
 	connect(m_pParent, SIGNAL(ConnectToServerSig() ), this, SLOT( ConnectToServerSlot() ) );
 	connect(m_pParent, SIGNAL(DisconnectFromServerSig() ), this, SLOT( DisconnectFromServerSlot() ) );
-	connect(m_pParent, SIGNAL(SendSig() ), this, SLOT( SendSlot() ) );
+	connect(m_pParent, SIGNAL(SendSig() ), this, SLOT( ScheduleSendSlot() ) );
+	m_TxFlushPending.fetchAndStoreOrdered(0);	//in case a SendSig came before the connect
 	connect(this, SIGNAL(NewSdrStatusSig(int)  ), m_pParent, SLOT( NewSdrStatusSlot(int) ) );
 	emit NewSdrStatusSig(SDR_OFF);
 }
@@ -87,7 +99,9 @@ void CTcp::ThreadExit()
 {
 	DisconnectFromServerSlot();
 	disconnect();
-	//must delete this resource in thread context that created it
+	//must delete these resources in thread context that created them
+	if(m_pSendTimer)
+		delete m_pSendTimer;
 	if(m_pTcpClient)
 		delete m_pTcpClient;
 }
@@ -103,6 +117,8 @@ void CTcp::ConnectToServerSlot()
 		m_pTcpClient->abort();
 	if( QAbstractSocket::ConnectedState == m_pTcpClient->state())
 		m_pTcpClient->close();
+	((CNetio*)m_pParent)->ResetRx();	//toss any partial msgs from last connection
+	ResetTxQueues();
 
 qDebug()<<"Connecting to Server"<<m_pTcpClient->state() << m_DomainName << m_ServerIPAdr <<m_ServerPort;
 	if(m_DomainName != "")
@@ -124,6 +140,21 @@ void CTcp::DisconnectFromServerSlot()
 		m_pTcpClient->close();
 		qDebug()<<"Disconnect from serverSlot";
 	}
+	ResetTxQueues();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by worker thread on connect and disconnect to throw away
+// everything queued for the old connection, including pending and
+// last sent setting values.
+/////////////////////////////////////////////////////////////////////
+void CTcp::ResetTxQueues()
+{
+	m_TxLength = 0;
+	m_TxPosition = 0;
+	m_TxCtrlQ.Reset();	//new connection so server may not have the sent setting values
+	while( m_TxAudioQ.Get(m_TxBuf, TXAUDIOQ_SIZE) > 0 )
+		;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -131,56 +162,124 @@ void CTcp::DisconnectFromServerSlot()
 /////////////////////////////////////////////////////////////////////
 void CTcp::ReadTcpDataSlot()
 {
-quint8 pBuf[50000];
 qint64 n;
+CAscpFramer* pFramer = (CNetio*)m_pParent;
 	if( QAbstractSocket::ConnectedState == m_pTcpClient->state())
 	{
 		do
-		{
-			n = m_pTcpClient->bytesAvailable();
-			if( (n<50000) && n>0 )
-			{
-				m_pTcpClient->read((char*)pBuf, 50000);
-				((CNetio*)m_pParent)->AssembleAscpMsg(pBuf, n);
-			}
-		}while(n>0);
+		{	//read straight into free space after any partial msg
+			n = m_pTcpClient->read((char*)pFramer->GetRxFreePtr(), pFramer->GetRxFreeLength());
+			if(n <= 0)
+				break;	//nothing read or socket error
+			m_RxByteCount.fetchAndAddRelaxed(n);
+			m_RxReadCount.fetchAndAddRelaxed(1);
+			pFramer->PutRxData(n);
+		}while( m_pTcpClient->bytesAvailable() > 0 );
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// called from external thread context to queue control msgs for the
+// TCP server. Only one thread may put msgs in each queue and no lock
+// is taken, see CTxCtrlQueue for how settings are collapsed.
+// Returns false if the queue is full and the msg was dropped.
+/////////////////////////////////////////////////////////////////////
+bool CTcp::PutTxBuf(char* pBuf, int length)
+{
+	if( m_TxCtrlQ.PutMsg(pBuf, length) )
+		return true;
+	m_TxDropCount.fetchAndAddRelaxed(1);
+	return false;
+}
+
+bool CTcp::PutTxAudioBuf(char* pBuf, int length)
+{
+	if( m_TxAudioQ.Put(pBuf, length) )
+	{
+		m_TxMsgCount.fetchAndAddRelaxed(1);
+		return true;
 	}
+	m_TxDropCount.fetchAndAddRelaxed(1);
+	return false;
+}
+
+/////////////////////////////////////////////////////////////////////
+// called from external thread context to queue a setting msg where
+// only the latest value matters (frequency, filter, gain etc.).
+// Must be the same thread that calls PutTxBuf().
+/////////////////////////////////////////////////////////////////////
+bool CTcp::PutTxSetting(char* pBuf, int length)
+{
+	if( m_TxCtrlQ.PutSetting(pBuf, length) )
+		return true;
+	m_TxDropCount.fetchAndAddRelaxed(1);
+	return false;
 }
 
 /////////////////////////////////////////////////////////////////////
-// called from external thread context to send buffer to TCP server
+// called by tcp worker thread when SendSig arrives.
+// Waits m_TxCoalesceTime so a burst of msgs goes out in one write.
 /////////////////////////////////////////////////////////////////////
-void CTcp::PutTxBuf(char* pBuf, int length)
+void CTcp::ScheduleSendSlot()
 {
-	m_Mutex.lock();
-	for(int i=0; i<length; i++)
+int time = m_TxCoalesceTime.load();
+	if(time > 0)
 	{
-		m_TxBuf[m_TxPosition++] = pBuf[i];
-		if(m_TxPosition >= TXQ_SIZE)
-			m_TxPosition = 0;	//should never get here
+		if( !m_pSendTimer->isActive() )
+			m_pSendTimer->start(time);
 	}
-	m_Mutex.unlock();
+	else
+	{
+		FlushSlot();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// called by tcp worker thread at end of collection window
+/////////////////////////////////////////////////////////////////////
+void CTcp::FlushSlot()
+{
+	//clear flag before reading queues so any msg put after this signals again
+	m_TxFlushPending.fetchAndStoreOrdered(0);
+	SendSlot();
 }
 
 /////////////////////////////////////////////////////////////////////
 // called by tcp worker thread to send buffer to TCP server
+// Everything queued is gathered into m_TxBuf and sent with one write.
+// If the socket only takes part of it the rest is sent first next time.
 /////////////////////////////////////////////////////////////////////
 void CTcp::SendSlot()
 {
-	if(0==m_TxPosition)
-		return;	//nothing to send
-	if( QAbstractSocket::ConnectedState == m_pTcpClient->state())
+qint64 sent;
+int msgs;
+int collapsed;
+	if( QAbstractSocket::ConnectedState != m_pTcpClient->state())
+		return;
+	if(0 == m_TxLength)
+	{	//previous buffer all sent so gather up whole msgs from both queues
+		m_TxPosition = 0;
+		//settings are held back while the link is backed up so they keep
+		//collapsing until it catches up (bytesWritten re-arms)
+		m_TxLength = m_TxCtrlQ.Gather(m_TxBuf, m_pTcpClient->bytesToWrite() >= TXSETTING_HOLDOFF,
+									msgs, collapsed);
+		m_TxMsgCount.fetchAndAddRelaxed(msgs);
+		m_TxCollapsedCount.fetchAndAddRelaxed(collapsed);
+		m_TxLength += m_TxAudioQ.Get(&m_TxBuf[m_TxLength], TXAUDIOQ_SIZE);
+		if(0 == m_TxLength)
+			return;	//nothing to send
+	}
+	sent = m_pTcpClient->write(&m_TxBuf[m_TxPosition], m_TxLength-m_TxPosition);
+	m_TxWriteCount.fetchAndAddRelaxed(1);
+	if(sent < 0)
 	{
-		m_Mutex.lock();
-		qint64 sent = m_pTcpClient->write(m_TxBuf, m_TxPosition );
-		m_TxPosition = m_TxPosition - sent;
-		m_Mutex.unlock();
-		if(m_TxPosition<0)
-		{
-			qDebug()<<"Tx Error";
-			m_TxPosition = 0;
-		}
+		qDebug()<<"Tx Error";
+		m_TxLength = 0;
+		return;
 	}
+	m_TxPosition += sent;
+	if(m_TxPosition >= m_TxLength)
+		m_TxLength = 0;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -222,6 +321,11 @@ qDebug()<<"Disconnected from Server";
 CNetio::CNetio()
 {
 	m_SdrStatus = SDR_OFF;
+	m_RxStatsTimer = 0;
+	m_RxReadsPerSec = 0;
+	m_RxAveReadSize = 0;
+	m_RxTotalBytes = 0;
+	m_TxMsgsPerWrite = 0.0;
 	m_pTcpIo = new CTcp(this);
 	qDebug()<<"CNetio constructor";
 	m_TcpConnectTimer = 0;
@@ -243,9 +347,7 @@ qDebug()<<"CNetio destructor";
 /////////////////////////////////////////////////////////////////////
 void CNetio::ConnectToServer()
 {
-	m_MsgState = MSGSTATE_HDR1;
-	m_RxMsgIndex = 0;
-	m_RxMsgLength = 0;
+	m_RxTotalBytes = 0;
 	m_TcpConnectTimer = TCP_CONNECT_TIMELIMIT;	//start connect timer
 	emit ConnectToServerSig();
 }
@@ -265,6 +367,28 @@ void CNetio::DisconnectFromServer(eSdrStatus reason )
 /////////////////////////////////////////////////////////////////////
 void CNetio::OnTimer()
 {
+int bytes;
+int reads;
+int msgs;
+int writes;
+	if( ++m_RxStatsTimer >= 10 )
+	{	//once a second update the receive statistics
+		m_RxStatsTimer = 0;
+		bytes = m_pTcpIo->m_RxByteCount.fetchAndStoreRelaxed(0);
+		reads = m_pTcpIo->m_RxReadCount.fetchAndStoreRelaxed(0);
+		m_RxTotalBytes += bytes;
+		m_RxReadsPerSec = reads;
+		if(reads)
+			m_RxAveReadSize = bytes/reads;
+		else
+			m_RxAveReadSize = 0;
+		msgs = m_pTcpIo->m_TxMsgCount.fetchAndStoreRelaxed(0);
+		writes = m_pTcpIo->m_TxWriteCount.fetchAndStoreRelaxed(0);
+		if(writes)
+			m_TxMsgsPerWrite = (float)msgs/(float)writes;
+		else
+			m_TxMsgsPerWrite = 0.0;
+	}
 	if( (SDR_OFF != m_SdrStatus ) &&
 		(SDR_DISCONNECT_BUSY != m_SdrStatus ) &&
 		(SDR_DISCONNECT_PWERROR != m_SdrStatus ) &&
@@ -284,60 +408,70 @@ qDebug()<<"TCP_Connect_Timeout";
 
 /////////////////////////////////////////////////////////////////////
 // Called to send an ASCP formatted message to the server
+// Returns false if the Tx queue was full and the msg was dropped.
 /////////////////////////////////////////////////////////////////////
-void CNetio::SendAscpMsg(CAscpTxMsg* pMsg)
+bool CNetio::SendAscpMsg(CAscpTxMsg* pMsg)
 {
 	if(m_pTcpIo)
 	{
-		m_pTcpIo->PutTxBuf( (char*)pMsg->Buf8, pMsg->GetLength() );
-		emit SendSig();
+		if( !m_pTcpIo->PutTxBuf( (char*)pMsg->Buf8, pMsg->GetLength() ) )
+			return false;
+		ScheduleSend();
+		return true;
 	}
+	return false;
 }
 
-/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
-/*                  -------------------------------                          */
-/*                 | A s s e m b l e A s c p M s g |                         */
-/*                  -------------------------------                          */
-/*  Helper function to assemble TCP data stream into ASCP formatted messages */
-/* Called from worker thread context so be careful.                          */
-/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
-void CNetio::AssembleAscpMsg(quint8* Buf, int Len)
+/////////////////////////////////////////////////////////////////////
+// Called to send an ASCP Tx audio data message to the server
+// Uses its own queue so audio does not contend with control msgs.
+/////////////////////////////////////////////////////////////////////
+bool CNetio::SendAscpDataMsg(CAscpTxMsg* pMsg)
 {
-	for(int i=0; i<Len; i++)
-	{	//process everything in Buf
-		switch(m_MsgState)	//Simple state machine to get generic ASCP msg
-		{
-			case MSGSTATE_HDR1:		//get first header byte of ASCP msg
-				m_RxAscpMsg.Buf8[0] = Buf[i];
-				m_MsgState = MSGSTATE_HDR2;	//go to get second header byte state
-				break;
-			case MSGSTATE_HDR2:	//here for second byte of header
-				m_RxAscpMsg.Buf8[1] = Buf[i];
-				m_RxMsgLength = m_RxAscpMsg.Buf16[0] & 0x1FFF;
-				m_RxMsgIndex = 2;
-				if(2 == m_RxMsgLength)	//if msg has no parameters then we are done
-				{
-					m_MsgState = MSGSTATE_HDR1;	//go back to first state
-					ParseAscpMsg( &m_RxAscpMsg );
-				}
-				else	//there are data bytes to fetch
-				{
-					if( 0 == m_RxMsgLength)
-						m_RxMsgLength = 8192+2;	//handle special case of 8192 byte data message
-					m_MsgState = MSGSTATE_DATA;	//go to data byte reading state
-				}
-				break;
-			case MSGSTATE_DATA:	//try to read the rest of the message
-				m_RxAscpMsg.Buf8[m_RxMsgIndex++] = Buf[i];
-				if( m_RxMsgIndex >= m_RxMsgLength )
-				{
-					m_MsgState = MSGSTATE_HDR1;	//go back to first stage
-					m_RxMsgIndex = 0;
-					ParseAscpMsg( &m_RxAscpMsg );	//got complete msg so call virtual parser.
-					m_TcpConnectTimer = TCP_CONNECT_TIMELIMIT;	//reset connect timer
-				}
-				break;
-		} //end switch statement
+	if(m_pTcpIo)
+	{
+		if( !m_pTcpIo->PutTxAudioBuf( (char*)pMsg->Buf8, pMsg->GetLength() ) )
+			return false;
+		ScheduleSend();
+		return true;
 	}
+	return false;
 }
 
+/////////////////////////////////////////////////////////////////////
+// Called to send an ASCP setting msg where only the latest value
+// matters. Unsent older values of the same CItem and channel are
+// replaced instead of being sent.
+/////////////////////////////////////////////////////////////////////
+bool CNetio::SendAscpSetting(CAscpTxMsg* pMsg)
+{
+	if(m_pTcpIo)
+	{
+		if( !m_pTcpIo->PutTxSetting( (char*)pMsg->Buf8, pMsg->GetLength() ) )
+			return false;
+		ScheduleSend();
+		return true;
+	}
+	return false;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Only signals the worker thread if a flush is not already pending
+// so a burst of msgs costs one queued signal and one socket write.
+/////////////////////////////////////////////////////////////////////
+void CNetio::ScheduleSend()
+{
+	if( m_pTcpIo->m_TxFlushPending.testAndSetOrdered(0, 1) )
+		emit SendSig();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called by CAscpFramer for each complete msg received.
+// Called from worker thread context.
+/////////////////////////////////////////////////////////////////////
+void CNetio::OnAscpMsg(CAscpRxMsg* pMsg, int Length)
+{
+	ParseAscpMsg(pMsg);
+	if(Length > 2)
+		m_TcpConnectTimer = TCP_CONNECT_TIMELIMIT;	//reset connect timer
+}
@@ -10,11 +10,15 @@
 
 #include "threadwrapper.h"
 #include "ascpmsg.h"
+#include "ascpframer.h"
+#include "spscring.h"
+#include "txctrlqueue.h"
 #include <QTcpServer>
 #include <QUdpSocket>
 #include <QHostAddress>
 #include <QTimer>
 #include <QMutex>
+#include <QAtomicInt>
 
 
 enum eSdrStatus
@@ -30,7 +34,9 @@ enum eSdrStatus
 	SDR_DISCONNECT_TIMEOUT
 };
 
-#define TXQ_SIZE 16384
+#define TXAUDIOQ_SIZE 16384	//Tx audio data msg queue size (must be power of 2)
+#define TX_COALESCE_TIME 2	//default mSec to collect Tx msgs into one socket write
+#define TXSETTING_HOLDOFF 4096	//hold settings while socket has this many bytes unsent
 
 class CTcp : public CThreadWrapper
 {
@@ -38,7 +44,9 @@ class CTcp : public CThreadWrapper
 public:
 	CTcp(QObject *parent = 0);
 	~CTcp();
-	void PutTxBuf(char* pBuf, int length);
+	bool PutTxBuf(char* pBuf, int length);
+	bool PutTxAudioBuf(char* pBuf, int length);
+	bool PutTxSetting(char* pBuf, int length);
 
 	QHostAddress m_ServerIPAdr;
 	QString m_DomainName;
@@ -47,6 +55,17 @@ public:
 	quint16 m_ClientPort;
 	void SendAscpMsg(CAscpTxMsg* pMsg);
 
+	//receive statistics, added to by worker thread and sampled by CNetio
+	QAtomicInt m_RxByteCount;
+	QAtomicInt m_RxReadCount;
+	QAtomicInt m_TxDropCount;	//msgs dropped because a Tx queue was full
+	QAtomicInt m_TxMsgCount;	//msgs gathered for writing
+	QAtomicInt m_TxWriteCount;	//socket writes
+	QAtomicInt m_TxCollapsedCount;	//setting msgs replaced by a newer value or already sent
+
+	QAtomicInt m_TxFlushPending;	//set when SendSig emitted and queues not flushed yet
+	QAtomicInt m_TxCoalesceTime;	//mSec to collect Tx msgs before writing (0=no wait)
+
 signals:
 	void NewSdrStatusSig(int status);
 
@@ -60,18 +79,25 @@ public slots:
 	void ConnectToServerSlot();
 	void DisconnectFromServerSlot();
 	void SendSlot();
+	void ScheduleSendSlot();
+	void FlushSlot();
 
 private:
-	char m_TxBuf[TXQ_SIZE];
-	qint64 m_TxPosition;
+	void ResetTxQueues();
+	CTxCtrlQueue m_TxCtrlQ;		//control and setting msgs from GUI thread
+	CSpscRing m_TxAudioQ;		//Tx audio data msgs
+	char m_TxBuf[TXCTRL_GATHER_SIZE+TXAUDIOQ_SIZE];	//msgs gathered for one socket write
+	int m_TxLength;				//number of bytes in m_TxBuf
+	int m_TxPosition;			//number of bytes of m_TxBuf already written
 	QObject* m_pParent;
 	QTcpSocket* m_pTcpClient;
+	QTimer* m_pSendTimer;
 };
 
 ///////////////////////////////////////////////////////////////////////////
 // CNetIO class which is base class of CSdrInterface class
 ///////////////////////////////////////////////////////////////////////////
-class CNetio : public QObject
+class CNetio : public QObject, public CAscpFramer
 {
 	Q_OBJECT
 public:
@@ -85,11 +111,19 @@ public:
 	}
 	void ConnectToServer();
 	void DisconnectFromServer(eSdrStatus reason);
-	void AssembleAscpMsg(quint8* Buf, int Len);
 
 	virtual void ParseAscpMsg( CAscpRxMsg* pMsg){Q_UNUSED(pMsg)}
 	QHostAddress GetServerAddress() { return m_pTcpIo->m_ServerIPAdr;}
-	void SendAscpMsg(CAscpTxMsg* pMsg);
+	bool SendAscpMsg(CAscpTxMsg* pMsg);
+	bool SendAscpDataMsg(CAscpTxMsg* pMsg);
+	bool SendAscpSetting(CAscpTxMsg* pMsg);
+	int GetTxCollapsedCount(){return m_pTcpIo->m_TxCollapsedCount.load();}
+	int GetTxDropCount(){return m_pTcpIo->m_TxDropCount.load();}
+	float GetTxMsgsPerWrite(){return m_TxMsgsPerWrite;}
+	void SetTxCoalesceTime(int mSec){m_pTcpIo->m_TxCoalesceTime.store(mSec);}
+	quint64 GetRxTotalBytes(){return m_RxTotalBytes;}
+	int GetRxReadsPerSec(){return m_RxReadsPerSec;}
+	int GetRxAveReadSize(){return m_RxAveReadSize;}
 	eSdrStatus m_SdrStatus;
 
 signals:
@@ -104,12 +138,17 @@ public slots:
 private slots:
 	void OnTimer();
 
+protected:
+	void OnAscpMsg(CAscpRxMsg* pMsg, int Length);
+
 private:
-	CAscpRxMsg m_RxAscpMsg;
-	int m_RxMsgLength;
-	int m_RxMsgIndex;
-	int m_MsgState;
+	void ScheduleSend();
 	int m_MsgTimer;
+	int m_RxStatsTimer;
+	int m_RxReadsPerSec;
+	int m_RxAveReadSize;
+	quint64 m_RxTotalBytes;
+	float m_TxMsgsPerWrite;
 	int m_TcpConnectTimer;
 	QMutex m_Mutex;		//for keeping threads from stomping on each other
 	QTimer *m_pTimer;
@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////
+// rxchannel.cpp: implementation of the CRxChannel class.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "rxchannel.h"
+#include "interface/sdrprotocol.h"
+
+/////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+/////////////////////////////////////////////////////////////////////
+CRxChannel::CRxChannel(int Channel, tRxAudioDecoder* pDecoder, QObject *parent) : QObject(parent)
+{
+	m_Channel = Channel;
+	m_pDecoder = pDecoder;
+	m_Frequency = 0;
+	m_DemodMode = DEMOD_MODE_AM;
+	m_Volume = 0;
+	m_SquelchThreshold = CI_RX_SQUELCH_THRESH_MIN;
+	m_LowCut = 0;
+	m_HighCut = 0;
+	m_Offset = 0;
+	m_pAudioSink = NULL;
+	m_pAudioRecorder = new CAudioRecorder;
+	SetupDecoder(COMP_MODE_NOAUDIO);
+}
+
+CRxChannel::~CRxChannel()
+{
+	if(m_pAudioRecorder)
+		delete m_pAudioRecorder;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Keeps the demod filter settings and creates the audio lowpass/bandpass
+// post filter to limit audio BW to the same as the receiver filtering.
+// This is important to limit the high frequency noise created by the
+// audio de-compression of narrow bandwidths such as when CW filters are used.
+// returns false if nothing changed.
+////////////////////////////////////////////////////////////////////////
+bool CRxChannel::SetDemodFilter(int LowCut, int HighCut, int Offset)
+{
+TYPEREAL fc;
+	if( (m_LowCut == LowCut) &&
+		(m_HighCut == HighCut ) &&
+		(m_Offset == Offset ) )
+		return false;		//do nothing if no changes
+	m_LowCut = LowCut;
+	m_HighCut = HighCut;
+	m_Offset = Offset;
+	//figure out audio post filter limts based on receiver demod filter settings
+	if( (LowCut==HighCut) && ( (LowCut*HighCut) < 0) )
+	{	//is a symetric filter so use |H-L|/2
+		fc = abs(HighCut-LowCut)/2.0;
+	}
+	else
+	{	//is sideband filter so use max(H,L)
+		if( abs(HighCut) > abs(LowCut) )
+			fc = abs(HighCut);
+		else
+			fc = abs(LowCut);
+	}
+	if(fc > 3900.0)
+		fc = 3900.0;
+	if(fc < 100.0)
+		fc = 700.0;
+	m_Fir.CreateLPFilter(0, 1.0, 50.0, fc, fc+200.0, fabs(Offset),  8000.0);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+// call to reset the decoder for a new compression mode
+////////////////////////////////////////////////////////////////////////
+void CRxChannel::SetupDecoder(int CompressionMode)
+{
+	m_pDecoder->CompressionMode = CompressionMode;
+	m_pDecoder->RxG726.Reset();
+	if(COMP_MODE_G726_40 == CompressionMode)
+		m_pDecoder->RxG726.SetRate(G726::Rate40kBits);	//5 bits/sample
+	else if(COMP_MODE_G726_32 == CompressionMode)
+		m_pDecoder->RxG726.SetRate(G726::Rate32kBits);	//4 bits/sample
+	else if(COMP_MODE_G726_24 == CompressionMode)
+		m_pDecoder->RxG726.SetRate(G726::Rate24kBits);	//3 bits/sample
+	else if(COMP_MODE_G726_16 == CompressionMode)
+		m_pDecoder->RxG726.SetRate(G726::Rate16kBits);	//2 bits/sample
+	else if( (CompressionMode >= COMP_MODE_RAW_16000) && (CompressionMode <= COMP_MODE_RAW_500) )
+		m_IqDemod.SetSampleRate(16000 >> (CompressionMode - COMP_MODE_RAW_16000));
+	m_IqDemod.Reset();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Sets the demod mode and filter used to demodulate raw I/Q locally.
+// These are separate from the server settings which are in raw mode.
+////////////////////////////////////////////////////////////////////////
+void CRxChannel::SetupIqDemod(int Mode, int LowCut, int HighCut, int Offset)
+{
+	m_IqDemod.SetDemodMode(Mode);
+	m_IqDemod.SetDemodFilter(LowCut, HighCut, Offset);
+}
+
+////////////////////////////////////////////////////////////////////////
+// call to decode the audio data packet into pOutBuf, returns number of samples
+//if length is == 2, then it is a squelched audio packet so the 2 data
+// bytes specify how many Zero samples to output.
+////////////////////////////////////////////////////////////////////////
+int CRxChannel::DecodeAudio(quint8* pInBuf, int Length, qint16* pOutBuf)
+{
+int n = 0;
+	if( 2 == Length )
+	{	//is a squelch packet so fill in pInBuf[1,0] samples with zero
+		n = ( (quint32)pInBuf[1] << 8 )+ (quint32)pInBuf[0];
+		for(int i=0; i<n; i++)
+			pOutBuf[i] = 0;
+	}
+	else if(COMP_MODE_RAW == m_pDecoder->CompressionMode)
+	{
+		for(int i=0; i<Length; i++)
+			pOutBuf[i] = (qint16)pInBuf[i] << 8;
+		n = Length;
+	}
+	else if(COMP_MODE_G711 == m_pDecoder->CompressionMode)
+	{
+		n = m_G711.ULawDecode(pOutBuf, pInBuf, Length) / 2;
+	}
+	else
+	{
+		n = m_pDecoder->RxG726.Decode(pOutBuf, pInBuf, 0, Length*8 ) / 2;
+	}
+	return n;
+}
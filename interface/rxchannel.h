@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////
+// rxchannel.h: interface for the CRxChannel class.
+//
+// Holds the settings, audio decoder state, audio sink and audio recorder
+// of one server receiver channel.  CSdrInterface owns one per channel ID and sends all
+// of their msgs over its single TCP session.  The codec state is the channel's
+// entry in the CSdrInterface decoder pool.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef RXCHANNEL_H
+#define RXCHANNEL_H
+
+#include <QObject>
+#include "soundout.h"
+#include "audiorecorder.h"
+#include "dsp/G711.h"
+#include "dsp/G726.h"
+#include "dsp/fir.h"
+#include "dsp/iqdemod.h"
+
+//audio decoder state for one receiver channel
+typedef struct
+{
+	int CompressionMode;
+	G726 RxG726;
+}tRxAudioDecoder;
+
+class CRxChannel : public QObject
+{
+	Q_OBJECT
+public:
+	CRxChannel(int Channel, tRxAudioDecoder* pDecoder, QObject *parent = 0);
+	virtual ~CRxChannel();
+
+	int GetChannel(){return m_Channel;}
+	qint64 GetFrequency(){return m_Frequency;}
+	void SetFrequency(qint64 freq){m_Frequency = freq;}
+	int GetDemodMode(){return m_DemodMode;}
+	void SetDemodMode(int mode){m_DemodMode = mode;}
+	int GetVolume(){return m_Volume;}
+	void SetVolume(int vol){m_Volume = vol;}
+	int GetSquelchThreshold(){return m_SquelchThreshold;}
+	void SetSquelchThreshold(int val){m_SquelchThreshold = val;}
+	bool SetDemodFilter(int LowCut, int HighCut, int Offset);
+	void ClearDemodFilter(){m_LowCut = 0; m_HighCut = 0; m_Offset = 0;}	//forces next filter to be sent
+
+	//decoded audio goes to the sink, NULL if channel is not being listened to
+	CSoundOut* GetAudioSink(){return m_pAudioSink;}
+	void SetAudioSink(CSoundOut* pSink){m_pAudioSink = pSink;}
+	//records the decoded audio whether or not it is listened to
+	CAudioRecorder* GetAudioRecorder(){return m_pAudioRecorder;}
+
+	int GetCompressionMode(){return m_pDecoder->CompressionMode;}
+	void SetupDecoder(int CompressionMode);
+	int DecodeAudio(quint8* pInBuf, int Length, qint16* pOutBuf);
+	void ProcessPostFilter(int n, qint16* pBuf){m_Fir.ProcessFilter(n, pBuf, pBuf);}
+
+	//local demodulation of raw I/Q compression modes
+	void SetupIqDemod(int Mode, int LowCut, int HighCut, int Offset);
+	void SetIqDemodAgc(int Slope, int Thresh, int Decay){m_IqDemod.SetAgc(Slope, Thresh, Decay);}
+	int GetMaxIqLength(int MaxOutput){return m_IqDemod.GetMaxInputLength(MaxOutput);}
+	int DemodIq(quint8* pInBuf, int Length, qint16* pOutBuf){return m_IqDemod.ProcessData((qint8*)pInBuf, Length, pOutBuf);}
+
+signals:
+	void NewSMeterValue(qint16 Val);
+
+private:
+	int m_Channel;
+	qint64 m_Frequency;
+	int m_DemodMode;
+	int m_Volume;
+	int m_SquelchThreshold;
+	int m_LowCut;
+	int m_HighCut;
+	int m_Offset;
+	tRxAudioDecoder* m_pDecoder;
+	CSoundOut* m_pAudioSink;
+	CAudioRecorder* m_pAudioRecorder;
+	G711 m_G711;
+	CFir m_Fir;		//post filter to limit audio BW to the demod filter BW
+	CIqDemod m_IqDemod;
+};
+
+#endif // RXCHANNEL_H
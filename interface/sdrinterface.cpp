@@ -70,6 +70,12 @@ const int MAX_TXPACKET_BYTES[7] = {
 #define KEEPALIVE_TIME 2		//rate to send keepalive msg
 #define KEEPALIVE_TRYLIMIT 3	//retry limit
 
+#define JITTER_TARGET_MULT 4		//jitter buffer target is this many times the jitter
+#define JITTER_RESET_GAP 1000.0	//restart jitter estimate after audio gap of this many mSec
+#define TARGET_UPDATE_TIME 1000.0	//mSec between jitter buffer target changes
+
+#define CHANNEL_PWR_TIME 0.1		//sub-channel power averaging time in seconds
+
 #define MIN_RX_SPAN 1000
 #define MAX_RX_SPAN 10000000
 #define MIN_TX_SPAN 1000
@@ -78,7 +84,8 @@ const int MAX_TXPACKET_BYTES[7] = {
 /////////////////////////////////////////////////////////////////////
 // Constructor/Destructor
 /////////////////////////////////////////////////////////////////////
-CSdrInterface::CSdrInterface(QObject *parent) : m_pParent(parent)
+CSdrInterface::CSdrInterface(QObject *parent) : m_pParent(parent),
+	m_VideoRing(VIDEO_RING_SIZE)
 {
 	m_SdrStatus = SDR_OFF;
 	m_MsgPos = 0;
@@ -93,18 +100,39 @@ CSdrInterface::CSdrInterface(QObject *parent) : m_pParent(parent)
 	m_CurrentDemodMode = DEMOD_MODE_AM;
 	m_TxUnlocked = false;
 	m_TxActive = false;
+	m_LocalDemod = false;
+	m_RawSampleRate = 16000;
+	m_ChannelizerSize = 0;
+	m_ChannelizerMonitor = -1;
 	m_pSoundOut = new CSoundOut;
 	m_pSoundIn = new CSoundIn;
+	m_pIqSpectrum = new CIqSpectrum;
+	m_pIqRecorder = new CIqRecorder;
 	for(int i=0; i<4; i++)
 	{
 		m_pRxFrequencyRangeMin[i] = 0;
 		m_pRxFrequencyRangeMax[i] = 30000000;
 	}
+	m_LatencyProfileMsec = LATENCY_PROFILE_MSEC[DEFAULT_LATENCY_PROFILE];
+	m_AudioTargetMsec = 0;
+	m_AudioMediaTime = 0.0;
+	m_AudioTransit = 0.0;
+	m_AudioJitter = 0.0;
+	m_LastAudioArrival = 0.0;
+	m_LastTargetUpdate = 0.0;
+	for(int i=0; i<MAX_RX_CHANNELS; i++)
+		m_pRxChannel[i] = new CRxChannel(i, &m_RxDecoder[i], this);
+	m_RxAudioChannel = 0;
+	m_RxChannelCount = 1;
+	m_pRxChannel[0]->SetAudioSink(m_pSoundOut);
 	m_AudioCompressionMode = COMP_MODE_NOAUDIO;
+	m_TxCompressionMode = COMP_MODE_NOAUDIO;
 	SetupAudioDecompression();
+	SetupTxEncoder();
 	SetupVideoDecompression(COMP_MODE_NOVIDEO);
 
 	connect(m_pSoundIn,SIGNAL( NewSoundDataRdy() ), this, SLOT( OnNewSoundDataRdySlot() ) );
+	connect(m_pIqSpectrum,SIGNAL( NewFrame() ), this, SIGNAL( NewVideoData() ) );
 
 #ifdef ENABLE_CODEC2
     fdv = new CFreedv(this);
@@ -123,6 +151,10 @@ CSdrInterface::~CSdrInterface()
 		delete m_pSoundOut;
 	if(m_pSoundIn)
 		delete m_pSoundIn;
+	if(m_pIqSpectrum)
+		delete m_pIqSpectrum;
+	if(m_pIqRecorder)
+		delete m_pIqRecorder;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -139,6 +171,84 @@ void CSdrInterface::StopAudioOut()
 	m_pSoundOut->Stop();
 }
 
+////////////////////////////////////////////////////////////////////////
+// Select one of the LATENCY_PROFILE_MSEC[] audio output latencies.
+// This is the smallest target, it grows if network jitter needs it.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetAudioLatencyProfile(int Profile)
+{
+	if( (Profile < 0) || (Profile >= NUM_LATENCY_PROFILES) )
+		Profile = DEFAULT_LATENCY_PROFILE;
+	m_Mutex.lock();
+	m_LatencyProfileMsec = LATENCY_PROFILE_MSEC[Profile];
+	m_AudioTargetMsec = m_LatencyProfileMsec;
+	m_pSoundOut->SetTargetDelay(m_AudioTargetMsec);
+	m_Mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Select which receiver channel's audio goes to the sound card.
+// All channels are always decoded so their decoder state is current.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetRxAudioChannel(int Channel)
+{
+	if(!IsValidChannel(Channel))
+		Channel = 0;
+	m_Mutex.lock();
+	if(Channel != m_RxAudioChannel)
+	{
+		m_pRxChannel[m_RxAudioChannel]->SetAudioSink(NULL);
+		m_pSoundOut->RemoveStream(m_RxAudioChannel);
+	}
+	m_RxAudioChannel = Channel;
+	m_pRxChannel[m_RxAudioChannel]->SetAudioSink(m_pSoundOut);
+	m_AudioCompressionMode = m_pRxChannel[Channel]->GetCompressionMode();
+	if( m_AudioCompressionMode < COMP_MODE_RAW_16000)
+		SetupAudioDecompression();
+	else if( m_LocalDemod && !m_pSoundOut->IsRunning() )
+		m_pSoundOut->Start(m_SoundcardOutIndex);
+	m_AudioMediaTime = 0.0;		//restart jitter estimate on new stream
+	m_Mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Start/Stop recording a receiver channel's decoded audio.  Any channel
+// can be recorded whether or not it is being listened to.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::StartAudioRecording(int Channel, const QString& BaseName, int Format, bool Gated)
+{
+	if(IsValidChannel(Channel))
+		m_pRxChannel[Channel]->GetAudioRecorder()->Start(BaseName, Format, Gated);
+}
+
+void CSdrInterface::StopAudioRecording(int Channel)
+{
+	if(IsValidChannel(Channel))
+		m_pRxChannel[Channel]->GetAudioRecorder()->Stop();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Adds or removes a receiver channel's audio to the sound card mix
+// along with the m_RxAudioChannel audio.  Pan is -100(left) to 100(right).
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetRxChannelMonitor(int Channel, bool On, int Pan)
+{
+	if(!IsValidChannel(Channel))
+		return;
+	m_Mutex.lock();
+	m_pSoundOut->SetStreamPan(Channel, Pan);
+	if(On)
+	{
+		m_pRxChannel[Channel]->SetAudioSink(m_pSoundOut);
+	}
+	else if(Channel != m_RxAudioChannel)
+	{
+		m_pRxChannel[Channel]->SetAudioSink(NULL);
+		m_pSoundOut->RemoveStream(Channel);
+	}
+	m_Mutex.unlock();
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Start/Stop Sound card input
 ////////////////////////////////////////////////////////////////////////
@@ -157,7 +267,8 @@ void CSdrInterface::StopAudioIn()
 
 ////////////////////////////////////////////////////////////////////////
 // Send messages to SDR to obtain a bunch of intial information
-// like name serial number etc.
+// like name serial number etc.  Only channel 0 is used until the
+// interface version reply shows the server has multiple channels.
 ////////////////////////////////////////////////////////////////////////
 void CSdrInterface::GetInfo()
 {
@@ -165,6 +276,15 @@ CAscpTxMsg TxAscpMsg;
 	m_SdrName = "";
 	m_ServerName = "";
 	m_SerialNumStr = "";
+	for(int i=1; i<m_RxChannelCount; i++)
+		SetRxChannelMonitor(i, false);
+	if(m_RxAudioChannel != 0)
+		SetRxAudioChannel(0);
+	m_RxChannelCount = 1;
+
+	TxAscpMsg.InitTxMsg(TYPE_HOST_REQ_CITEM);
+	TxAscpMsg.AddCItem(CI_GENERAL_INTERFACE_VERSION);
+	SendAscpMsg(&TxAscpMsg);
 
 	TxAscpMsg.InitTxMsg(TYPE_HOST_REQ_CITEM);
 	TxAscpMsg.AddCItem(CI_GENERAL_INTERFACE_NAME);
@@ -192,9 +312,8 @@ CAscpTxMsg TxAscpMsg;
 	TxAscpMsg.AddParm8(0);
 	SendAscpMsg(&TxAscpMsg);
 
-	m_CurLowCut = 0;
-	m_CurHighCut = 0;
-	m_CurOffset = 0;
+	for(int i=0; i<MAX_RX_CHANNELS; i++)
+		m_pRxChannel[i]->ClearDemodFilter();
 	m_RxSpanMin = 10000;
 	m_RxSpanMax = 50000;
 }
@@ -314,29 +433,37 @@ CAscpTxMsg TxAscpMsg;
 ////////////////////////////////////////////////////////////////////////
 // Send sdr volume msg
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetVolume(qint32 vol)
+void CSdrInterface::SetVolume(qint32 vol, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
-	m_pSoundOut->SetVolume(vol);
+	if(!IsValidChannel(Channel))
+		return;
+	m_pRxChannel[Channel]->SetVolume(vol);
+	m_pSoundOut->SetStreamVolume(Channel, vol);	//channel ID is its mixer stream ID
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_AF_GAIN);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm8((quint8)vol);
-	SendAscpMsg(&TxAscpMsg);
+	SendAscpSetting(&TxAscpMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////
 // Send sdr rx frequency msgs
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetRxFrequency(qint64 freq)
+void CSdrInterface::SetRxFrequency(qint64 freq, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
+	if(!IsValidChannel(Channel))
+		return;
+	m_pRxChannel[Channel]->SetFrequency(freq);
+	if(Channel == m_RxAudioChannel)
+		m_pIqRecorder->SetFrequency(freq);
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_FREQUENCY);
-	TxAscpMsg.AddParm8( 0 ) ;
+	TxAscpMsg.AddParm8( (quint8)Channel ) ;
 	TxAscpMsg.AddParm32( (quint32)(freq&0xFFFFFFFF) );
 	TxAscpMsg.AddParm8( (quint8)(freq>>32) ) ;
-	SendAscpMsg(&TxAscpMsg);
+	SendAscpSetting(&TxAscpMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -350,21 +477,27 @@ CAscpTxMsg TxAscpMsg;
 	TxAscpMsg.AddParm8( 0 ) ;
 	TxAscpMsg.AddParm32( (quint32)(freq&0xFFFFFFFF) );
 	TxAscpMsg.AddParm8( (quint8)(freq>>32) ) ;
-	SendAscpMsg(&TxAscpMsg);
+	SendAscpSetting(&TxAscpMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////
 // Send sdr demodulation/modulation mode msgs
+// The transmitter follows the channel 0 mode.
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetDemodMode(quint32 mode)
+void CSdrInterface::SetDemodMode(quint32 mode, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
-	m_CurrentDemodMode = mode;
+	if(!IsValidChannel(Channel))
+		return;
+	m_pRxChannel[Channel]->SetDemodMode(mode);
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_DEMOD_MODE);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm8((quint8)mode);
 	SendAscpMsg(&TxAscpMsg);
+	if(Channel)
+		return;
+	m_CurrentDemodMode = mode;
 //send same mode for transmitter
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_TX_MOD_MODE);
@@ -404,10 +537,12 @@ CAscpTxMsg TxAscpMsg;
 ////////////////////////////////////////////////////////////////////////
 // Send sdr rx attenuator msg
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetAtten(qint32 atten)
+void CSdrInterface::SetAtten(qint32 atten, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
 qint8 bg;
+	if(!IsValidChannel(Channel))
+		return;
 	//limit values to 0, -10, -20, and -30
 	if( atten > -5 )
 		atten = 0;
@@ -420,21 +555,24 @@ qint8 bg;
 	bg = (qint8)atten;
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_RF_GAIN);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm8(bg);
 	SendAscpMsg(&TxAscpMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////
-// Send sdr rx AGC parameters msg
+// Send sdr rx AGC parameters msg.  The local raw I/Q demods get the
+// AGC settings of the local demod mode from SetLocalDemod().
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetAgc(int Slope, int Thresh, int delay)
+void CSdrInterface::SetAgc(int Slope, int Thresh, int delay, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
 qint8 sb;
+	if(!IsValidChannel(Channel))
+		return;
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_AGC);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	sb = (qint8)Thresh;
 	TxAscpMsg.AddParm8((quint8)sb);
 	sb = (qint8)Slope;
@@ -445,24 +583,31 @@ qint8 sb;
 
 ////////////////////////////////////////////////////////////////////////
 // Send sdr rx/tx audio compression msgs
+// The transmitter follows the channel 0 mode.
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetAudioCompressionMode(int Mode)
+void CSdrInterface::SetAudioCompressionMode(int Mode, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
 //	SetupAudioDecompression(Mode);	//now compressionmode is in data packet
-
+	if(!IsValidChannel(Channel))
+		return;
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_AUDIO_COMPRESSION);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm8((quint8)Mode);
 	SendAscpMsg(&TxAscpMsg);
+	if(Channel)
+		return;
 
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_TX_AUDIO_COMPRESSION);
 	TxAscpMsg.AddParm8(0);
 	TxAscpMsg.AddParm8((quint8)Mode);
 	SendAscpMsg(&TxAscpMsg);
-
+	m_Mutex.lock();
+	m_TxCompressionMode = Mode;
+	SetupTxEncoder();
+	m_Mutex.unlock();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -482,29 +627,34 @@ void CSdrInterface::SetVideoCompressionMode(int Mode)
 ////////////////////////////////////////////////////////////////////////
 // Send sdr rx squelch Threshold msg
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetSquelchThreshold(int val)
+void CSdrInterface::SetSquelchThreshold(int val, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
+	if(!IsValidChannel(Channel))
+		return;
 	if(val < CI_RX_SQUELCH_THRESH_MIN)
 		val = CI_RX_SQUELCH_THRESH_MIN;
 	if(val > CI_RX_SQUELCH_THRESH_MAX)
 		val = CI_RX_SQUELCH_THRESH_MAX;
+	m_pRxChannel[Channel]->SetSquelchThreshold(val);
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_SQUELCH_THRESH);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm16((qint16)val);
-	SendAscpMsg(&TxAscpMsg);
+	SendAscpSetting(&TxAscpMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////
 // Send sdr rx HP audio filter msg
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetAudioFilter(int val)
+void CSdrInterface::SetAudioFilter(int val, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
+	if(!IsValidChannel(Channel))
+		return;
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_AUDIO_FILTER);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm8((quint8)val);
 	SendAscpMsg(&TxAscpMsg);
 }
@@ -523,45 +673,21 @@ void CSdrInterface::SetAntenna(int antenna)
 ////////////////////////////////////////////////////////////////////////
 // Send sdr rx demodulator filter parameters msg
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::SetDemodFilter(int LowCut, int HighCut, int Offset)
+void CSdrInterface::SetDemodFilter(int LowCut, int HighCut, int Offset, int Channel)
 {
 CAscpTxMsg TxAscpMsg;
-	if( (m_CurLowCut == LowCut) &&
-		(m_CurHighCut == HighCut ) &&
-		(m_CurOffset == Offset ) )
+	if(!IsValidChannel(Channel))
+		return;
+	//also sets up the channel's audio post filter
+	if( !m_pRxChannel[Channel]->SetDemodFilter(LowCut, HighCut, Offset) )
 		return;		//do nothing if no changes
-	m_CurLowCut = LowCut;
-	m_CurHighCut = HighCut;
-	m_CurOffset = Offset;
 	TxAscpMsg.InitTxMsg(TYPE_HOST_SET_CITEM);
 	TxAscpMsg.AddCItem(CI_RX_DEMOD_FILTER);
-	TxAscpMsg.AddParm8(0);
+	TxAscpMsg.AddParm8((quint8)Channel);
 	TxAscpMsg.AddParm16((quint16)( (qint16)LowCut) );
 	TxAscpMsg.AddParm16((quint16)( (qint16)HighCut) );
 	TxAscpMsg.AddParm16((quint16)Offset);
-	SendAscpMsg(&TxAscpMsg);
-	// Create audio lowpass/bandpass post filter to limit audio BW to the
-	//same as the receiver filtering.  This is important to limit the
-	//high frequency noise created by the audio de-compression of narrow bandwidths
-	//such as when CW filters are used.
-	TYPEREAL fc;
-	//figure out audio post filter limts based on receiver demod filter settings
-	if( (LowCut==HighCut) && ( (LowCut*HighCut) < 0) )
-	{	//is a symetric filter so use |H-L|/2
-		fc = abs(HighCut-LowCut)/2.0;
-	}
-	else
-	{	//is sideband filter so use max(H,L)
-		if( abs(HighCut) > abs(LowCut) )
-			fc = abs(HighCut);
-		else
-			fc = abs(LowCut);
-	}
-	if(fc > 3900.0)
-		fc = 3900.0;
-	if(fc < 100.0)
-		fc = 700.0;
-	m_Fir.CreateLPFilter(0, 1.0, 50.0, fc, fc+200.0, fabs(Offset),  8000.0);
+	SendAscpSetting(&TxAscpMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -579,6 +705,7 @@ CAscpTxMsg TxAscpMsg;
 	TxAscpMsg.AddParm8( (quint8)Ave );
 	TxAscpMsg.AddParm8( (quint8)Rate );
 	SendAscpMsg(&TxAscpMsg);
+	m_pIqSpectrum->SetupDisplay(Xpoints, Span, MaxdB, MindB, Ave, Rate);
 //qDebug()<<Xpoints << Span << MindB << MaxdB << Ave << Rate;
 }
 
@@ -663,6 +790,9 @@ CAscpTxMsg TxAscpMsg;
 trxaudiodatapkt* aptr;
 tvideodatapkt* vptr;
 int i;
+int chan;
+int mode;
+CRxChannel* pChan;
 int length = pMsg->GetLength();
 quint16 Ci;
 //qDebug()<<"Got Msg";
@@ -699,6 +829,11 @@ quint16 Ci;
 				}
 				break;
 			case CI_GENERAL_INTERFACE_VERSION:
+				if(pMsg->GetParm16() >= MULTICHAN_INTERFACE_VERSION)
+					m_RxChannelCount = MAX_RX_CHANNELS;
+				else
+					m_RxChannelCount = 1;
+				emit NewRxChannelCount(m_RxChannelCount);
 				break;
 			case CI_GENERAL_HARDFIRM_VERSION:
 				break;
@@ -771,13 +906,17 @@ qDebug()<<"tx span limits "<<m_TxSpanMin << m_TxSpanMax;
 				emit NewFftAvePwr(pMsg->GetParm16());
 				break;
 			case CI_RX_AUDIO_COMPRESSION:
-				pMsg->GetParm8();	//ignor chan num
+				chan = pMsg->GetParm8();
 				//if NO Audio is selected then shut off sound card output
-				if(	pMsg->GetParm8() == COMP_MODE_NOAUDIO)
+				if(	(pMsg->GetParm8() == COMP_MODE_NOAUDIO) && IsValidChannel(chan) )
 				{
-					m_AudioCompressionMode = COMP_MODE_NOAUDIO;
-					if( m_pSoundOut->IsRunning() )
-						StopAudioOut();
+					m_pRxChannel[chan]->SetupDecoder(COMP_MODE_NOAUDIO);
+					if(chan == m_RxAudioChannel)
+					{
+						m_AudioCompressionMode = COMP_MODE_NOAUDIO;
+						if( m_pSoundOut->IsRunning() )
+							StopAudioOut();
+					}
 				}
 				break;
 			default:
@@ -833,41 +972,101 @@ qDebug()<<"Tx Range Fmax = "<<m_pTxFrequencyRangeMax[i];
 	else if( pMsg->GetType() == TYPE_TARG_DATA_ITEM0 )
 	{	// rx audio data msg from sdr
 		aptr = (trxaudiodatapkt*)pMsg->Buf8;
-		if( aptr->hdr.comptype != m_AudioCompressionMode)
+		if(m_RxChannelCount > 1)
+		{	//multiple channel servers put the channel ID in the upper comptype bits
+			chan = aptr->hdr.comptype >> COMPTYPE_CHAN_SHIFT;
+			mode = aptr->hdr.comptype & COMPTYPE_MODE_MASK;
+		}
+		else
+		{
+			chan = 0;
+			mode = aptr->hdr.comptype;
+		}
+		pChan = m_pRxChannel[chan];
+		if( mode != pChan->GetCompressionMode())
+		{	//channel compression mode changed so start its decoder over
+			pChan->SetupDecoder(mode);
+		}
+		if(chan != m_RxAudioChannel)
+		{	//keep other channel decoders in step so switching to them is clean
+			if( mode < COMP_MODE_RAW_16000)
+			{
+				m_Mutex.lock();
+				DecodeAudioPacket(pChan, aptr->hdr.Data, length-5);
+				m_Mutex.unlock();
+			}
+			else if(m_LocalDemod)
+			{
+				m_Mutex.lock();
+				DemodIqPacket(pChan, aptr->hdr.Data, length-5);
+				m_Mutex.unlock();
+			}
+			if(!m_TxActive)
+				emit pChan->NewSMeterValue(aptr->hdr.smeter);
+			return;
+		}
+		if( mode != m_AudioCompressionMode)
 		{	//if compression mode changed
-			m_AudioCompressionMode = aptr->hdr.comptype;
+			m_AudioCompressionMode = mode;
 			if( m_AudioCompressionMode < COMP_MODE_RAW_16000)
 			{
 				SetupAudioDecompression();
 			}
 			else
 			{
-				if( m_pSoundOut->IsRunning())
+				if(m_LocalDemod)
+				{	//demodulated here so keep the sound card running
+					if( !m_pSoundOut->IsRunning())
+						m_pSoundOut->Start(m_SoundcardOutIndex);
+				}
+				else if( m_pSoundOut->IsRunning())
 					StopAudioOut();
+				if( m_AudioCompressionMode <= COMP_MODE_RAW_500)
+				{
+					m_Mutex.lock();
+					m_RawSampleRate = 16000 >> (m_AudioCompressionMode - COMP_MODE_RAW_16000);
+					SetupChannelizer();
+					m_Mutex.unlock();
+					m_pIqSpectrum->SetSampleRate(m_RawSampleRate);
+					m_pIqRecorder->SetSampleRate(m_RawSampleRate);
+				}
 			}
 		}
 		if( m_AudioCompressionMode < COMP_MODE_RAW_16000)
 		{
 			m_Mutex.lock();
-			DecodeAudioPacket(aptr->hdr.Data, length-5);
+			DecodeAudioPacket(pChan, aptr->hdr.Data, length-5);
 			m_Mutex.unlock();
 		}
 		else
 		{
 			m_Mutex.lock();
 			g_pRawIQWidget->ProccessRawIQData((qint8*)aptr->hdr.Data,  (int)((aptr->hdr.header&0x7FFF) - 5));
+			if( !ChannelizeIqPacket(pChan, aptr->hdr.Data, length-5) && m_LocalDemod)
+				DemodIqPacket(pChan, aptr->hdr.Data, length-5);
 			m_Mutex.unlock();
+			m_pIqSpectrum->PutIqData((qint8*)aptr->hdr.Data, length-5);
+			m_pIqRecorder->PutIqData((qint8*)aptr->hdr.Data, length-5);
 		}
 		if(!m_TxActive)
+		{
 			emit NewSMeterValue(aptr->hdr.smeter);
+			emit pChan->NewSMeterValue(aptr->hdr.smeter);
+		}
 	}
 	else if( pMsg->GetType() == TYPE_TARG_DATA_ITEM1 )
 	{	//video data msg from sdr
 		vptr = (tvideodatapkt*)pMsg->Buf8;
+		if( IsLocalFftActive() )
+			return;		//plot is fed from the raw I/Q instead
 		m_Mutex.lock();
-		DecodeVideoPacket(vptr->hdr.comptype, vptr->hdr.Data, length-3);
+		m_VideoFrame.Length = DecodeVideoPacket(vptr->hdr.comptype, vptr->hdr.Data, length-3);
 		m_Mutex.unlock();
-		emit NewVideoData();
+		if( !m_VideoRing.Put((char*)&m_VideoFrame, sizeof(tvideoframe)) )
+			m_VideoFramesDropped.fetchAndAddRelaxed(1);
+		//only signal once until the GUI drains the ring
+		if( m_VideoSignalPending.testAndSetOrdered(0, 1) )
+			emit NewVideoData();
 	}
 	else if( pMsg->GetType() == TYPE_TARG_DATA_ITEM2 )
 	{
@@ -896,12 +1095,11 @@ void CSdrInterface::SetupVideoDecompression(int Mode)
 }
 
 ////////////////////////////////////////////////////////////////////////
-// call to set the audio compression mode
+// call to set the audio compression mode of the monitored channel.
+// Starts/stops the sound card.
 ////////////////////////////////////////////////////////////////////////
 void CSdrInterface::SetupAudioDecompression()
 {
-	m_RxG726.Reset();
-	m_TxG726.Reset();
 	if(COMP_MODE_NOAUDIO == m_AudioCompressionMode )
 	{
 		if( m_pSoundOut->IsRunning())
@@ -912,86 +1110,191 @@ void CSdrInterface::SetupAudioDecompression()
 		if( !m_pSoundOut->IsRunning())
 			m_pSoundOut->Start(m_SoundcardOutIndex);
 	}
-	if(COMP_MODE_G726_40 == m_AudioCompressionMode)
-	{
-		m_RxG726.SetRate(G726::Rate40kBits);	//5 bits/sample
+}
+
+////////////////////////////////////////////////////////////////////////
+// call to set up the transmit encoder for m_TxCompressionMode.
+// This is the channel 0 mode and does not change with the channel
+// being listened to.  Raw I/Q modes leave the last audio setup.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetupTxEncoder()
+{
+	if( m_TxCompressionMode >= COMP_MODE_RAW_16000)
+		return;
+	m_TxG726.Reset();
+	if(COMP_MODE_G726_40 == m_TxCompressionMode)
 		m_TxG726.SetRate(G726::Rate40kBits);	//5 bits/sample
-	}
-	else if(COMP_MODE_G726_32 == m_AudioCompressionMode)
-	{
-		m_RxG726.SetRate(G726::Rate32kBits);	//4 bits/sample
+	else if(COMP_MODE_G726_32 == m_TxCompressionMode)
 		m_TxG726.SetRate(G726::Rate32kBits);	//4 bits/sample
-	}
-	else if(COMP_MODE_G726_24 == m_AudioCompressionMode)
-	{
-		m_RxG726.SetRate(G726::Rate24kBits);	//3 bits/sample
+	else if(COMP_MODE_G726_24 == m_TxCompressionMode)
 		m_TxG726.SetRate(G726::Rate24kBits);	//3 bits/sample
-	}
-	else if(COMP_MODE_G726_16 == m_AudioCompressionMode)
-	{
-		m_RxG726.SetRate(G726::Rate16kBits);	//2 bits/sample
+	else if(COMP_MODE_G726_16 == m_TxCompressionMode)
 		m_TxG726.SetRate(G726::Rate16kBits);	//2 bits/sample
-	}
-	m_MaxTxSamplesInPkt = MAX_TXPACKET_BYTES[m_AudioCompressionMode];
+	m_MaxTxSamplesInPkt = MAX_TXPACKET_BYTES[m_TxCompressionMode];
 }
 
 ////////////////////////////////////////////////////////////////////////
-// call to decode the audio data packet
-//if length is == 2, then it is a squelched audio packet so the 2 data
-// bytes specify how many Zero samples to send to the sound card.
+// call to decode the audio data packet of receiver channel pChan
+// and send it to the channel's audio sink if it has one.
 ////////////////////////////////////////////////////////////////////////
-void CSdrInterface::DecodeAudioPacket( quint8* pInBuf, int Length)
+void CSdrInterface::DecodeAudioPacket(CRxChannel* pChan, quint8* pInBuf, int Length)
 {
-int n = 0;
+int n;
 //qDebug()<<Length;
-	if( 2 == Length )
-	{	//is a squelch packet so fill in pInBuf[1,0] samples with zero
-		n = ( (quint32)pInBuf[1] << 8 )+ (quint32)pInBuf[0];
-		for(int i=0; i<n; i++)
-			m_SoundOutBuf[i] = 0;
+	n = pChan->DecodeAudio(pInBuf, Length, m_SoundOutBuf);
+	PutChannelAudio(pChan, n, true, 2 == Length);	//2 byte packets are squelched audio
+}
+
+////////////////////////////////////////////////////////////////////////
+// call to demodulate a raw I/Q data packet of receiver channel pChan
+// and send it to the channel's audio sink if it has one.
+// Low I/Q rates make more audio samples than there are bytes so the
+// packet is done in pieces that fit in m_SoundOutBuf.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::DemodIqPacket(CRxChannel* pChan, quint8* pInBuf, int Length)
+{
+int n;
+int len;
+	while(Length > 0)
+	{
+		len = pChan->GetMaxIqLength(MAX_DATAPKT_LENGTH);
+		if(len <= 0)
+			return;
+		if(len > Length)
+			len = Length;
+		n = pChan->DemodIq(pInBuf, len, m_SoundOutBuf);
+		PutChannelAudio(pChan, n, false);	//channel filter already limits BW
+		pInBuf += len;
+		Length -= len;
 	}
-	else if(COMP_MODE_RAW ==m_AudioCompressionMode)
+}
+
+////////////////////////////////////////////////////////////////////////
+// call to run a raw I/Q data packet through the channelizer to update
+// the sub-channel power levels.  If a sub-channel is monitored it is
+// demodulated and sent to the audio sink of pChan.  Like DemodIqPacket()
+// the sub-channel is demodulated in pieces that fit in m_SoundOutBuf.
+// Returns true if the monitored sub-channel made the channel audio.
+////////////////////////////////////////////////////////////////////////
+bool CSdrInterface::ChannelizeIqPacket(CRxChannel* pChan, quint8* pInBuf, int Length)
+{
+int i;
+int k;
+int n;
+int len;
+int frames;
+int N = m_ChannelizerSize;
+TYPECPX* pOut = m_ChannelizerBuf;
+	if(!N)
+		return false;
+	if(Length > MAX_DATAPKT_LENGTH)
+		Length = MAX_DATAPKT_LENGTH;
+	frames = m_Channelizer.ProcessData((qint8*)pInBuf, Length, m_ChannelizerBuf);
+	for(i=0; i<frames; i++)
 	{
-		for(int i=0; i<Length; i++)
-			m_SoundOutBuf[i] = (qint16)pInBuf[i] << 8;
-		n = Length;
+		for(k=0; k<N; k++)
+			m_ChannelPwr[k] += m_ChannelPwrAlpha*(pOut[k].re*pOut[k].re + pOut[k].im*pOut[k].im - m_ChannelPwr[k]);
+		pOut += N;
 	}
-	else if(COMP_MODE_G711 == m_AudioCompressionMode)
+	if( !m_LocalDemod || (m_ChannelizerMonitor < 0) || (m_ChannelizerMonitor >= N) ||
+		(m_Channelizer.GetChannelRate() < IQDEMOD_OUTRATE/IQDEMOD_MAX_INTP) )
+		return false;
+	//pull the monitored sub-channel out of the frames in place
+	for(i=0; i<frames; i++)
+		m_ChannelizerBuf[i] = m_ChannelizerBuf[i*N + m_ChannelizerMonitor];
+	for(i=0; i<frames; i+=len)
 	{
-		n = m_G711.ULawDecode(m_SoundOutBuf, pInBuf, Length) / 2;
+		len = m_SubChanDemod.GetMaxInputLength(MAX_DATAPKT_LENGTH)/2;	//bytes to I/Q samples
+		if(len <= 0)
+			break;
+		if(len > (frames - i))
+			len = frames - i;
+		n = m_SubChanDemod.ProcessData(&m_ChannelizerBuf[i], len, m_SoundOutBuf);
+		Q_ASSERT(n <= MAX_DATAPKT_LENGTH);
+		PutChannelAudio(pChan, n, false);
 	}
-	else
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Sends n decoded samples in m_SoundOutBuf to the audio recorder of
+// pChan and to its audio sink if it has one that is running.
+// Squelched is true if the samples are silence from a squelch packet.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::PutChannelAudio(CRxChannel* pChan, int n, bool PostFilter, bool Squelched)
+{
+CSoundOut* pSink;
+CAudioRecorder* pRecorder;
+qint16* pBuf = m_SoundOutBuf;
+	pSink = pChan->GetAudioSink();
+	pRecorder = pChan->GetAudioRecorder();
+	if( !pSink && !pRecorder->IsRecording() )
+		return;		//nobody wants this channel's audio
+	if( pSink && (pChan->GetChannel() == m_RxAudioChannel) )	//other monitored channels share its timing
+		UpdateAudioJitter(n);
+	if(m_TxActive)
 	{
-		n = m_RxG726.Decode(m_SoundOutBuf, pInBuf, 0, Length*8 ) / 2;
+		for (int i = 0; i < n; i++)
+			m_SoundOutBuf[i] = 0;
+		Squelched = true;
 	}
-	if( m_pSoundOut->IsRunning())
+	else
 	{
-		if(m_TxActive)
+		// process post audio filter to get rid of noise created by
+		// audio de-compression on narrow BW reeciver settings
+		if(PostFilter)
+			pChan->ProcessPostFilter(n, m_SoundOutBuf);
+#ifdef ENABLE_CODEC2
+		//one FreeDV modem so only the channel being listened to
+		if( fdv->is_active() && (pChan->GetChannel() == m_RxAudioChannel) )
 		{
-            for (int i = 0; i < n; i++)
-				m_SoundOutBuf[i] = 0;
-
-            m_pSoundOut->PutOutQueue(n, m_SoundOutBuf);
+			n = fdv->process(n, m_SoundOutBuf, m_SoundDvBuf);
+			pBuf = m_SoundDvBuf;
 		}
-		else
-        {
-            // process post audio filter to get rid of noise created by
-            // audio de-compression on narrow BW reeciver settings
-			m_Fir.ProcessFilter(n, m_SoundOutBuf, m_SoundOutBuf);
-
-#ifdef ENABLE_CODEC2
-            if (fdv->is_active())
-            {
-                int m = fdv->process(n, m_SoundOutBuf, m_SoundDvBuf);
-                m_pSoundOut->PutOutQueue(m, m_SoundDvBuf);
-            }
-            else
 #endif
-            {
-                m_pSoundOut->PutOutQueue(n, m_SoundOutBuf);
-            }
-		}
+	}
+	pRecorder->PutAudio(pBuf, n, Squelched);
+	if( pSink && pSink->IsRunning() )
+		pSink->PutOutQueue(n, pBuf, pChan->GetChannel());
+}
+
+////////////////////////////////////////////////////////////////////////
+// Called with each audio packet of n samples to estimate the packet
+// arrival jitter (RFC3550 style) and size the sound output jitter buffer.
+// The audio data is a steady 8Ksps stream so the difference between
+// arrival time and audio time shows how late each packet is.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::UpdateAudioJitter(int n)
+{
+double now;
+double transit;
+int target;
+	if( !m_AudioArrivalTimer.isValid() )
+		m_AudioArrivalTimer.start();
+	now = (double)m_AudioArrivalTimer.nsecsElapsed()*1.0e-6;
+	if( (0.0 == m_AudioMediaTime) || ((now - m_LastAudioArrival) > JITTER_RESET_GAP) )
+	{	//first packet or stream restarted so start over
+		m_AudioMediaTime = 0.0;
+		m_AudioTransit = now;
+		m_LastTargetUpdate = now;
+	}
+	m_LastAudioArrival = now;
+	transit = now - m_AudioMediaTime;
+	m_AudioJitter += ( fabs(transit - m_AudioTransit) - m_AudioJitter )/16.0;
+	m_AudioTransit = transit;
+	m_AudioMediaTime += ((double)n*1000.0)/8000.0;
 
+	if( (now - m_LastTargetUpdate) < TARGET_UPDATE_TIME )
+		return;
+	m_LastTargetUpdate = now;
+	//need enough queued to cover the jitter plus one packet on top of the soundcard buffer
+	target = (int)(JITTER_TARGET_MULT*m_AudioJitter) + (n*1000)/8000 + m_pSoundOut->GetCardBufDelay();
+	if(target < m_LatencyProfileMsec)
+		target = m_LatencyProfileMsec;
+	if( abs(target - m_AudioTargetMsec) > (m_AudioTargetMsec/10) )
+	{	//only move the target on a significant change
+		m_AudioTargetMsec = target;
+		m_pSoundOut->SetTargetDelay(m_AudioTargetMsec);
 	}
 }
 
@@ -1001,21 +1304,26 @@ int n = 0;
 void  CSdrInterface::OnNewSoundDataRdySlot()
 {
 	ttxaudiodatapkt TxDataPacket;
-	if(!m_TxActive || (COMP_MODE_NOAUDIO == m_AudioCompressionMode) )
+	if(!m_TxActive)
 		return;
-
-	TxDataPacket.hdr.comptype = m_AudioCompressionMode;
+	m_Mutex.lock();		//encoder setup can change from the GUI thread
+	if(COMP_MODE_NOAUDIO == m_TxCompressionMode)
+	{
+		m_Mutex.unlock();
+		return;
+	}
+	TxDataPacket.hdr.comptype = m_TxCompressionMode;
 	int availsamples = m_pSoundIn->GetInQueueSampsAvailable();
 	while(m_MaxTxSamplesInPkt <= availsamples)
 	{
 		availsamples = m_pSoundIn->GetInQueue(m_MaxTxSamplesInPkt, m_SoundInBuf);
 		int n = m_MaxTxSamplesInPkt;
-		if(COMP_MODE_RAW == m_AudioCompressionMode)
+		if(COMP_MODE_RAW == m_TxCompressionMode)
 		{
 			for(int i=0; i<m_MaxTxSamplesInPkt; i++)
 				TxDataPacket.hdr.Data[i] = (m_SoundInBuf[i]>>8)& 0xFF;
 		}
-		else if(COMP_MODE_G711 == m_AudioCompressionMode)
+		else if(COMP_MODE_G711 == m_TxCompressionMode)
 		{
 			n = m_G711.ULawEncode(TxDataPacket.hdr.Data, m_SoundInBuf, m_MaxTxSamplesInPkt*2 );
 		}
@@ -1024,31 +1332,169 @@ void  CSdrInterface::OnNewSoundDataRdySlot()
 			n = m_TxG726.Encode(TxDataPacket.hdr.Data, 0, m_SoundInBuf, m_MaxTxSamplesInPkt*2)/8;
 		}
 		TxDataPacket.hdr.header = (n+3) | (TYPE_TARG_DATA_ITEM0<<8);
-		SendAscpMsg((CAscpTxMsg*)&TxDataPacket);
+		SendAscpDataMsg((CAscpTxMsg*)&TxDataPacket);
 		emit NewSMeterValue(m_pSoundIn->GetInputLevel());
 qDebug()<<availsamples << n <<m_MaxTxSamplesInPkt;
 	}
+	m_Mutex.unlock();
 }
 
-void CSdrInterface::DecodeVideoPacket(quint8 comptype, quint8* pInBuf, int Length)
+////////////////////////////////////////////////////////////////////////
+// Called by the GUI thread to get the oldest waiting spectrum frame.
+// Local raw I/Q spectrum frames are taken first.  Returns false when
+// no frames are waiting.  The NewVideoData signal is armed again when
+// the rings are found empty.
+////////////////////////////////////////////////////////////////////////
+bool CSdrInterface::GetFftFrame(tvideoframe* pFrame)
+{
+	pFrame->Length = m_pIqSpectrum->GetFrame(pFrame->Data, MAX_VIDEO_LENGTH);
+	if(pFrame->Length)
+		return true;
+	if( (int)sizeof(tvideoframe) == m_VideoRing.Get((char*)pFrame, sizeof(tvideoframe)) )
+		return true;
+	m_VideoSignalPending.storeRelease(0);
+	//catch a frame put after the failed Get but before the flag was cleared
+	return ( (int)sizeof(tvideoframe) == m_VideoRing.Get((char*)pFrame, sizeof(tvideoframe)) );
+}
+
+////////////////////////////////////////////////////////////////////////
+// Turns local demodulation of raw I/Q modes on or off.  Mode is one
+// of the DEMOD_MODE_xx values with its filter and AGC settings, the
+// server itself stays in raw mode.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetLocalDemod(int Mode, int LowCut, int HighCut, int Offset, int AgcThresh, int AgcDecay)
+{
+	m_Mutex.lock();
+	m_LocalDemod = (Mode >= 0);
+	if(m_LocalDemod)
+	{
+		for(int i=0; i<MAX_RX_CHANNELS; i++)
+		{
+			m_pRxChannel[i]->SetupIqDemod(Mode, LowCut, HighCut, Offset);
+			m_pRxChannel[i]->SetIqDemodAgc(0, AgcThresh, AgcDecay);
+		}
+		m_SubChanDemod.SetDemodMode(Mode);
+		m_SubChanDemod.SetDemodFilter(LowCut, HighCut, Offset);
+		m_SubChanDemod.SetAgc(0, AgcThresh, AgcDecay);
+	}
+	if( (m_AudioCompressionMode >= COMP_MODE_RAW_16000) && (m_AudioCompressionMode <= COMP_MODE_RAW_500) )
+	{
+		if(m_LocalDemod && !m_pSoundOut->IsRunning())
+			m_pSoundOut->Start(m_SoundcardOutIndex);
+		else if(!m_LocalDemod && m_pSoundOut->IsRunning())
+			StopAudioOut();
+	}
+	m_Mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Sets the number of channelizer sub-channels, a power of 2 up to
+// MAX_CHANNELIZER_SIZE.  0 turns the channelizer off.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetChannelizer(int NumChannels)
+{
+	m_Mutex.lock();
+	m_ChannelizerSize = NumChannels;
+	SetupChannelizer();
+	m_Mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Selects a sub-channel to demodulate with the local demod settings in
+// place of the whole raw stream.  -1 goes back to the whole stream.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetChannelizerMonitor(int SubChannel)
+{
+	m_Mutex.lock();
+	m_ChannelizerMonitor = SubChannel;
+	m_SubChanDemod.Reset();
+	m_Mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Called by GUI thread to get the averaged power of each sub-channel
+// in dB below a full scale raw I/Q sine.  Returns number of sub-channels.
+////////////////////////////////////////////////////////////////////////
+int CSdrInterface::GetChannelizerLevels(float* pdB, int MaxChannels)
+{
+int n;
+	m_Mutex.lock();
+	n = (m_ChannelizerSize < MaxChannels) ? m_ChannelizerSize : MaxChannels;
+	for(int i=0; i<n; i++)
+		pdB[i] = 10.0*log10(m_ChannelPwr[i] + 1e-10) - 20.0*log10(127.0);
+	m_Mutex.unlock();
+	return n;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Called with m_Mutex locked when the channelizer size or raw sample
+// rate changes.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::SetupChannelizer()
+{
+int rate;
+	if( m_ChannelizerSize && !m_Channelizer.Setup(m_ChannelizerSize, m_RawSampleRate) )
+		m_ChannelizerSize = 0;
+	if(!m_ChannelizerSize)
+		return;
+	rate = m_Channelizer.GetChannelRate();
+	m_SubChanDemod.SetSampleRate(rate);
+	m_ChannelPwrAlpha = 1.0/(CHANNEL_PWR_TIME*rate);
+	if(m_ChannelPwrAlpha > 1.0)
+		m_ChannelPwrAlpha = 1.0;
+	for(int i=0; i<m_ChannelizerSize; i++)
+		m_ChannelPwr[i] = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Starts a SigMF recording of the monitored channel's raw I/Q stream.
+// Nothing is written until a raw I/Q mode is selected.
+////////////////////////////////////////////////////////////////////////
+void CSdrInterface::StartIqRecording(const QString& BaseName)
+{
+	m_pIqRecorder->Start(BaseName, m_RawSampleRate, m_pRxChannel[m_RxAudioChannel]->GetFrequency());
+}
+
+////////////////////////////////////////////////////////////////////////
+// True when the plot spectrum is computed locally so server video
+// data is ignored.  Only possible while a raw I/Q mode is selected.
+////////////////////////////////////////////////////////////////////////
+bool CSdrInterface::IsLocalFftActive()
+{
+	return ( m_pIqSpectrum->IsEnabled() &&
+			(m_AudioCompressionMode >= COMP_MODE_RAW_16000) &&
+			(m_AudioCompressionMode <= COMP_MODE_RAW_500) );
+}
+
+////////////////////////////////////////////////////////////////////////
+// Decodes a video data packet into m_VideoFrame.Data and returns the
+// number of spectrum points.
+////////////////////////////////////////////////////////////////////////
+int CSdrInterface::DecodeVideoPacket(quint8 comptype, quint8* pInBuf, int Length)
 {
 int j=0;
 int preval = 0;
 int curval;
 quint8 tmp;
+quint8* pVideoData = m_VideoFrame.Data;
 
 //qDebug()<<"L="<<Length;
 	if(comptype != m_VideoCompressionMode)
 		SetupVideoDecompression(comptype);
 	if(COMP_MODE_8BIT == m_VideoCompressionMode)
 	{
+		if(Length > MAX_VIDEO_LENGTH)
+			Length = MAX_VIDEO_LENGTH;
 		for(int i=0; i<Length; i++)
-			m_VideoData[i] = pInBuf[i];
+			pVideoData[i] = pInBuf[i];
 		for(int i=Length; i<MAX_VIDEO_LENGTH; i++)
-			m_VideoData[i] = 0;
+			pVideoData[i] = 0;
+		j = Length;
 	}
 	else if(COMP_MODE_4BIT == m_VideoCompressionMode )
 	{
+		if(Length > MAX_VIDEO_LENGTH/2)
+			Length = MAX_VIDEO_LENGTH/2;
 		for(int i=0; i<Length; i++)
 		{
 			tmp = pInBuf[i];
@@ -1056,15 +1502,16 @@ quint8 tmp;
 			if(curval > 255) curval = 255;
 			if(curval < 0) curval = 0;
 			preval = curval;
-			m_VideoData[j++] = (quint8)(curval&0xFF);
+			pVideoData[j++] = (quint8)(curval&0xFF);
 
 			curval = ANTILOGTBL[tmp >> 4] + preval;
 			if(curval > 255) curval = 255;
 			if(curval < 0) curval = 0;
 			preval = curval;
-			m_VideoData[j++] = (quint8)(curval&0xFF);
+			pVideoData[j++] = (quint8)(curval&0xFF);
 		}
 	}
+	return j;
 }
 
 
@@ -13,9 +13,17 @@
 #include "netio.h"
 #include "soundout.h"
 #include "soundin.h"
+#include "sdrprotocol.h"
+#include "rxchannel.h"
+#include "spscring.h"
+#include "iqspectrum.h"
+#include "iqrecorder.h"
+#include "audiorecorder.h"
 #include "dsp/G711.h"
 #include "dsp/G726.h"
 #include "dsp/fir.h"
+#include "dsp/iqdemod.h"
+#include "dsp/channelizer.h"
 
 #ifdef ENABLE_CODEC2
 #include "freedv.h"
@@ -23,9 +31,16 @@
 
 #define MAX_DATAPKT_LENGTH 3000
 #define MAX_VIDEO_LENGTH 3000
+#define VIDEO_RING_SIZE 32768	//holds 10 spectrum frames waiting for the GUI
 
 #define FM_DEVIATION 5000
 
+//audio output latency profiles selected by index
+#define NUM_LATENCY_PROFILES 4
+#define DEFAULT_LATENCY_PROFILE 3
+//output delay of queue plus soundcard buffer, what GetAudioOutputDelay() shows
+const int LATENCY_PROFILE_MSEC[NUM_LATENCY_PROFILES] = {40, 80, 150, 250};
+
 #define RATE_64 0
 #define RATE_40 1
 #define RATE_32 2
@@ -67,6 +82,13 @@ typedef  union
 	char Buf[MAX_DATAPKT_LENGTH+3];
 }tvideodatapkt;
 
+//decoded spectrum frame passed to the GUI through m_VideoRing
+typedef struct
+{
+	quint16 Length;		//number of spectrum points in Data
+	quint8 Data[MAX_VIDEO_LENGTH];
+} __attribute__ ((__packed__)) tvideoframe;
+
 typedef struct
 {
 	int Fls;	//low shelf frequency
@@ -90,18 +112,19 @@ public:
 	void SetSdrRunState(bool on);
 	void GetInfo();
 	void GetFftAvePwr();
-	void SetVolume(qint32 vol);
-	void SetRxFrequency(qint64 freq);
+	//receiver settings default to channel 0 which is the only channel on most servers
+	void SetVolume(qint32 vol, int Channel = 0);
+	void SetRxFrequency(qint64 freq, int Channel = 0);
 	void SetTxFrequency(qint64 freq);
-	void SetDemodMode(quint32 mode);
+	void SetDemodMode(quint32 mode, int Channel = 0);
 	void SetDigitalMode(quint32 mode);
 	void SetPTT(int TxState);
-	void SetAtten(qint32 atten);
-	void SetAgc(int Slope, int Thresh, int delay);
-	void SetDemodFilter(int LowCut, int HighCut, int Offset);
-	void SetSquelchThreshold(int Val);
-	void SetAudioFilter(int val);
-	void SetAudioCompressionMode(int Mode);
+	void SetAtten(qint32 atten, int Channel = 0);
+	void SetAgc(int Slope, int Thresh, int delay, int Channel = 0);
+	void SetDemodFilter(int LowCut, int HighCut, int Offset, int Channel = 0);
+	void SetSquelchThreshold(int Val, int Channel = 0);
+	void SetAudioFilter(int val, int Channel = 0);
+	void SetAudioCompressionMode(int Mode, int Channel = 0);
 	void SetEqualizer(tEqualizer Params);
 	void SetTxTestSignalMode(quint8 Mode, int Freq);
 	void SetVideoCompressionMode(int Mode);
@@ -111,10 +134,32 @@ public:
 	void TryPW(QString RxPw, QString TxPw);
 	void SendClientDesc(QString ClientDesc);
 	void SetupFft(int xpoints, int Span, int MindB, int MaxdB, int Ave, int Rate );
-	void GetFftData(quint32* Buf, int Length){for(int i=0; i<Length;i++) Buf[i] = m_VideoData[i];}
+	bool GetFftFrame(tvideoframe* pFrame);
+	int GetVideoFramesDropped(){return m_VideoFramesDropped.load();}
+	void SetLocalFft(bool On){m_pIqSpectrum->SetEnabled(On);}
+	void SetupLocalFft(int FftSize, int Window, int OverlapPercent){m_pIqSpectrum->SetupFft(FftSize, Window, OverlapPercent);}
+	bool IsLocalFftActive();
+	void SetLocalDemod(int Mode, int LowCut, int HighCut, int Offset, int AgcThresh, int AgcDecay);	//Mode < 0 is off
+	void SetChannelizer(int NumChannels);		//split raw I/Q into sub-channels, 0 is off
+	void SetChannelizerMonitor(int SubChannel);	//local demod of one sub-channel, -1 is off
+	int GetChannelizerLevels(float* pdB, int MaxChannels);	//sub-channel power in dBFS
+	void StartIqRecording(const QString& BaseName);
+	void StopIqRecording(){m_pIqRecorder->Stop();}
+	CIqRecorder* GetIqRecorder(){return m_pIqRecorder;}
+	void StartAudioRecording(int Channel, const QString& BaseName, int Format, bool Gated);
+	void StopAudioRecording(int Channel);
+	CAudioRecorder* GetAudioRecorder(int Channel){return m_pRxChannel[Channel]->GetAudioRecorder();}
 	void SendKeepalive();
 	void ParseAscpMsg(CAscpRxMsg *pMsg);
 	qint32 GetDataLatency() {return (qint32)m_CurrentLatency;}
+	void SetAudioLatencyProfile(int Profile);
+	void SetRxAudioChannel(int Channel);
+	void SetRxChannelMonitor(int Channel, bool On, int Pan = 0);
+	int GetRxAudioChannel(){return m_RxAudioChannel;}
+	CRxChannel* GetRxChannel(int Channel){return m_pRxChannel[Channel];}
+	int GetRxChannelCount(){return m_RxChannelCount;}	//1 until the server reports multiple channel support
+	int GetAudioOutputDelay(){return m_pSoundOut->GetOutputDelay();}
+	int GetAudioJitter(){return (int)m_AudioJitter;}
 
     void SetAntenna(int antenna);
 
@@ -154,6 +199,7 @@ signals:
 	void NewSMeterValue(qint16 Val);
 	void NewFftAvePwr(qint16 Val);
 	void NewVideoData();
+	void NewRxChannelCount(int Count);	//server reported how many receiver channels it has
 
 public slots:
     void SetFreedvMode(const QString &mode_str)
@@ -169,38 +215,67 @@ private slots:
 	void OnNewSoundDataRdySlot();
 	
 private:
-	void DecodeAudioPacket( quint8* pInBuf, int Length);
-	void DecodeVideoPacket(quint8 comptype, quint8* pInBuf, int Length);
+	bool IsValidChannel(int Channel){return (Channel >= 0) && (Channel < m_RxChannelCount);}
+	void DecodeAudioPacket(CRxChannel* pChan, quint8* pInBuf, int Length);
+	void DemodIqPacket(CRxChannel* pChan, quint8* pInBuf, int Length);
+	bool ChannelizeIqPacket(CRxChannel* pChan, quint8* pInBuf, int Length);
+	void SetupChannelizer();
+	void PutChannelAudio(CRxChannel* pChan, int n, bool PostFilter, bool Squelched = false);
+	int DecodeVideoPacket(quint8 comptype, quint8* pInBuf, int Length);
 	void SetupAudioDecompression();
+	void SetupTxEncoder();
+	void UpdateAudioJitter(int n);
 	void SetupVideoDecompression(int Mode);
 
-	quint8 m_VideoData[MAX_VIDEO_LENGTH];
+	tvideoframe m_VideoFrame;	//frame being decoded by the network thread
 	qint16 m_SoundOutBuf[MAX_DATAPKT_LENGTH];
 	qint16 m_SoundInBuf[MAX_DATAPKT_LENGTH];
 	qint32 m_CurrentLatency;
 	bool m_TxUnlocked;
 	bool m_TxActive;
+	bool m_LocalDemod;		//demodulate raw I/Q modes here
+	int m_RawSampleRate;
+	int m_ChannelizerSize;
+	int m_ChannelizerMonitor;
+	float m_ChannelPwrAlpha;
+	float m_ChannelPwr[MAX_CHANNELIZER_SIZE];
+	TYPECPX m_ChannelizerBuf[MAX_DATAPKT_LENGTH/2 + MAX_CHANNELIZER_SIZE];
+	CChannelizer m_Channelizer;
+	CIqDemod m_SubChanDemod;	//demod for the monitored sub-channel
 	int m_MsgPos;
 	int m_SoundcardOutIndex;
 	int m_SoundcardInIndex;
-	int m_AudioCompressionMode;
+	int m_AudioCompressionMode;	//mode of the channel sent to the sound card
+	int m_TxCompressionMode;		//transmit audio mode, follows channel 0
 	int m_VideoCompressionMode;
-	int m_CurLowCut;
-	int m_CurHighCut;
-	int m_CurOffset;
 	int m_KeepAliveCount;
 	int m_KeepAliveTimer;
 	int m_MaxTxSamplesInPkt;
 	int m_CurrentDemodMode;
+	int m_RxAudioChannel;		//receiver channel sent to the sound card
+	int m_RxChannelCount;		//receiver channels the server supports
+	int m_LatencyProfileMsec;
+	int m_AudioTargetMsec;
+	double m_AudioMediaTime;	//mSec of audio received since jitter estimate started
+	double m_AudioTransit;		//relative transit time of last audio packet in mSec
+	double m_AudioJitter;		//smoothed audio packet arrival jitter in mSec
+	double m_LastAudioArrival;
+	double m_LastTargetUpdate;
 	QString m_Str;
-	G726 m_RxG726;
+	tRxAudioDecoder m_RxDecoder[MAX_RX_CHANNELS];	//decoder pool indexed by receiver channel ID
+	CRxChannel* m_pRxChannel[MAX_RX_CHANNELS];	//indexed by receiver channel ID
 	G726 m_TxG726;
 	G711 m_G711;
-	CFir m_Fir;
 	CSoundOut* m_pSoundOut;
 	CSoundIn* m_pSoundIn;
+	CIqSpectrum* m_pIqSpectrum;	//plot spectrum from raw I/Q when enabled
+	CIqRecorder* m_pIqRecorder;
 	QObject* m_pParent;
+	CSpscRing m_VideoRing;		//fixed size tvideoframe records to the GUI thread
+	QAtomicInt m_VideoFramesDropped;	//frames lost because the GUI fell behind
+	QAtomicInt m_VideoSignalPending;	//set when NewVideoData emitted and ring not drained yet
 	QElapsedTimer m_LatencyTimer;
+	QElapsedTimer m_AudioArrivalTimer;
 	QMutex m_Mutex;		//for keeping threads from stomping on each other
 
 #ifdef ENABLE_CODEC2
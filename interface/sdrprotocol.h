@@ -154,6 +154,16 @@
 #define COMP_MODE_RAW_2000 10
 #define COMP_MODE_RAW_1000 11
 #define COMP_MODE_RAW_500 12
+//Multiple receiver channel extension, not part of the original protocol.
+//Servers reporting CI_GENERAL_INTERFACE_VERSION of MULTICHAN_INTERFACE_VERSION or
+//higher put the receiver channel ID in the upper 3 bits of the rx audio data item
+//comptype byte and the compression mode in the lower 5 bits, and accept channel
+//IDs 1 to MAX_RX_CHANNELS-1 in the channel parameter of the rx control items.
+//For older servers the whole comptype byte is the mode and only channel 0 is used.
+#define MULTICHAN_INTERFACE_VERSION 200		//version 2.00
+#define COMPTYPE_MODE_MASK 0x1F
+#define COMPTYPE_CHAN_SHIFT 5
+#define MAX_RX_CHANNELS 8
 
 
 #define CI_RX_AD_MODES 0x008A
@@ -62,12 +62,6 @@ CSoundIn::CSoundIn()
 	m_pIODevice = NULL;
 	m_pAudioInput = NULL;
 	m_InAudioFormat.setSampleRate(SOUNDCARD_INRATE);
-	m_SampCnt = 0;
-	m_Dec3State = DEC3TAP_LENGTH-1;
-	for(int i=0; i<DEC2TAP_LENGTH ;i++)
-		m_Dec2FirBuf[i] = 0.0;
-	for(int i=0; i<DEC3TAP_LENGTH ;i++)
-		m_Dec3FirBuf[i] = 0.0;
 //	qDebug()<<"CSoundIn constructor";
 
 	m_ToneInc = K_2PI*(double)TEST_FREQ/SOUNDCARD_INRATE;
@@ -233,8 +227,7 @@ int i;
 	}
 #endif
 
-	int n = DecBy2(numsamples, pData, m_TmpDecBuf);
-	n = DecBy3(n, m_TmpDecBuf, pData);
+	int n = m_Decimator.ProcessData(numsamples, pData, pData);
 
 	m_Mutex.lock();
 	if( numsamples < (INQSIZE-m_InQAvailable) )
@@ -302,74 +295,3 @@ int i;
 	m_Mutex.unlock();
 	return m_InQAvailable;
 }
-
-//////////////////////////////////////////////////////////////////////
-// Half band filter and decimate by 2 function.
-// Two restrictions on this routine:
-// InLength must be larger or equal to the Number of Halfband Taps
-// InLength must be an even number
-//////////////////////////////////////////////////////////////////////
-int CSoundIn::DecBy2(int InLength, qint16* pInData, double* pOutData)
-{
-int i;
-int j;
-int numoutsamples = 0;
-#if 0
-	//safety net to make sure InLength is even and large enough to process
-	if( (InLength&1) || (InLength<DEC2TAP_LENGTH) )
-	{
-		qDebug()<<"Dec2 error";
-		return InLength/2;
-	}
-#endif
-	//copy input samples into buffer starting at position m_FirLength-1
-	for(i=0,j = DEC2TAP_LENGTH - 1; i<InLength; i++)
-		m_Dec2FirBuf[j++] = (double)pInData[i];
-	//perform decimation FIR filter on even samples
-	for(i=0; i<InLength; i+=2)
-	{
-		double acc;
-		acc = ( m_Dec2FirBuf[i] * DEC2_H[0] );
-		for(j=2; j<DEC2TAP_LENGTH; j+=2)	//only use even coefficients since odd are zero(except center point)
-			acc += ( m_Dec2FirBuf[i+j] * DEC2_H[j] );
-		//now multiply the center coefficient
-		acc += ( m_Dec2FirBuf[i+(DEC2TAP_LENGTH-1)/2] * DEC2_H[(DEC2TAP_LENGTH-1)/2] );
-		pOutData[numoutsamples++] = acc;	//put in  output buffer
-
-	}
-	//need to copy last m_FirLength - 1 input samples in buffer to beginning of buffer
-	// for FIR wrap around management
-	for(i=0,j = InLength-DEC2TAP_LENGTH+1; i<DEC2TAP_LENGTH - 1; i++)
-		m_Dec2FirBuf[i] = (double)pInData[j++];
-	return numoutsamples;
-}
-
-//////////////////////////////////////////////////////////////////////
-// Decimate by 3 function.
-//////////////////////////////////////////////////////////////////////
-int CSoundIn::DecBy3(int InLength, double* pInData, qint16* pOutData)
-{
-int i,j,n;
-const double* Kptr;
-double acc;
-double* Firptr;
-	n = 0;
-	for( i = 0; i<InLength; i++ )	// put new samples into Queue
-	{
-//decimate by 3 filter
-		m_Dec3FirBuf[m_Dec3State] = pInData[i];	//place in circular Queue
-		if(--m_SampCnt <=0 )	//calc first decimation filter every 2 samples
-		{
-			m_SampCnt = 3;
-			acc = 0.0;
-			Firptr = m_Dec3FirBuf;
-			Kptr = DEC3_H + DEC3TAP_LENGTH - m_Dec3State;
-			for(j=0; j<	DEC3TAP_LENGTH; j++)	//do the MAC's
-				acc += ( (*(Firptr++)) * (*Kptr++) );
-			pOutData[n++] = (qint16)acc;
-		}
-		if( --m_Dec3State < 0)	//deal with FIR pointer wraparound
-			m_Dec3State = DEC3TAP_LENGTH-1;
-	}
-	return n;
-}
@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////
 // soundout.cpp: implementation of the CSoundOut class.
-// Only mono 16 bit mode supported
+// Mixes mono 8Ksps input streams to one 16 bit stereo soundcard output
 //
 //
 // History:
@@ -41,6 +41,7 @@
 /*---------------------------------------------------------------------------*/
 #include "soundout.h"
 #include <math.h>
+#include <string.h>
 #include <QDebug>
 
 /*---------------------------------------------------------------------------*/
@@ -51,7 +52,10 @@
 //#define SOUNDCARD_OUTRATE 8000
 
 #define FILTERQLEVEL_ALPHA 0.02
-#define P_GAIN 2.0e-6		//Proportional gain
+#define P_GAIN 0.05			//Proportional gain (ratio per second of queue error)
+#define I_GAIN 0.0025		//Integral gain (ratio per second of queue error per second)
+#define MAX_PPM_CORRECTION 1000	//limit of rate correction in ppm
+#define MIN_CARDBUF_MSEC 30		//smallest soundcard buffer to ask for
 
 /////////////////////////////////////////////////////////////////////
 //   constructor/destructor
@@ -60,11 +64,22 @@ CSoundOut::CSoundOut()
 {
 	m_pAudioOutput = NULL;
 	m_pIODevice = NULL;
-	m_OutRatio = 1.0;
 	m_OutAudioFormat.setSampleRate(SOUNDCARD_OUTRATE);
 	m_Gain = 1.0;
 	m_Startup = true;
-	m_PpmError = 0;
+	m_TargetQLevel = OUTQ_TARGET_LEVEL;
+	m_TargetDelayMsec = (OUTQ_TARGET_LEVEL*1000)/SOUNDCARD_OUTRATE;
+	m_CardBufLevel = 0;
+	m_CardBufSize = 0;
+	m_OutChannels = OUT_CHANNELS;
+	ResetRateCorrection();
+	for(int i=0; i<MAX_MIX_STREAMS; i++)
+	{
+		m_MixStream[i].Gain = 1.0;
+		m_MixStream[i].PanL = 1.0;
+		m_MixStream[i].PanR = 1.0;
+	}
+	ResetMixer();
 }
 
 CSoundOut::~CSoundOut()
@@ -97,20 +112,15 @@ void CSoundOut::ThreadExit()
 void CSoundOut::StartSlot(int OutDevIndx)
 {
 QAudioDeviceInfo  DeviceInfo;
-	m_PpmError = 0;
+	m_Mutex.lock();
+	ResetRateCorrection();
 	m_OutQHead = 0;
 	m_OutQTail = 0;
 	m_OutQLevel = 0;
 	m_AveOutQLevel = 0;
 	m_Startup = true;
-	//init X6 interpolator
-	m_FirState2 = INTP2_QUE_SIZE-1;
-	m_FirState3 = INTP3_QUE_SIZE-1;
-	m_Indx = 0;
-	for(int i=0; i<INTP2_QUE_SIZE; i++)
-		m_pQue2[i] = 0.0;
-	for( int i=0; i<INTP3_QUE_SIZE; i++)
-		m_pQue3[i] = 0.0;
+	m_Mutex.unlock();
+	ResetMixer();
 
 	m_pThread->setPriority(QThread::HighestPriority);
 	//Get required soundcard from list
@@ -130,7 +140,13 @@ QAudioDeviceInfo  DeviceInfo;
 	m_OutAudioFormat.setSampleSize(16);
 	m_OutAudioFormat.setSampleType(QAudioFormat::SignedInt);
 	m_OutAudioFormat.setByteOrder(QAudioFormat::LittleEndian);
-	m_OutAudioFormat.setChannelCount(1);
+	m_OutAudioFormat.setChannelCount(OUT_CHANNELS);
+	m_OutChannels = OUT_CHANNELS;
+	if(!m_OutDeviceInfo.isFormatSupported(m_OutAudioFormat))
+	{	//fall back to mono, the mixed stereo queue is summed to one channel
+		m_OutAudioFormat.setChannelCount(1);
+		m_OutChannels = 1;
+	}
 
 	m_pAudioOutput = new QAudioOutput(m_OutDeviceInfo, m_OutAudioFormat, this);
 	if(!m_pAudioOutput)
@@ -144,10 +160,20 @@ QAudioDeviceInfo  DeviceInfo;
 		//operate in mode where notify() slot is called periodically to
 		// see how much data can be sent to soundcard output
 		//connect notify signal to get more soundcard output data
-		m_pAudioOutput->setBufferSize(SOUND_WRITEBUFSIZE);
+		//soundcard buffer gets half the latency target and the queue the rest
+		int bufsize = (m_TargetDelayMsec*SOUNDCARD_OUTRATE)/2000;
+		if(bufsize < (MIN_CARDBUF_MSEC*SOUNDCARD_OUTRATE)/1000)
+			bufsize = (MIN_CARDBUF_MSEC*SOUNDCARD_OUTRATE)/1000;
+		if(bufsize > SOUND_WRITEBUFSIZE/2)
+			bufsize = SOUND_WRITEBUFSIZE/2;
+		m_pAudioOutput->setBufferSize(bufsize*2*m_OutChannels);
 		connect(m_pAudioOutput,SIGNAL(notify()), this, SLOT(GetNewData()));
 		m_pIODevice = m_pAudioOutput->start(); //start Qt AudioOutput
 		m_pAudioOutput->setNotifyInterval(20);
+		m_Mutex.lock();
+		m_CardBufSize = m_pAudioOutput->bufferSize()/(2*m_OutChannels);	//may not be what was asked for
+		m_Mutex.unlock();
+		SetTargetDelay(m_TargetDelayMsec);	//queue target is what the soundcard buffer leaves
 		GetNewData();	//fill buffer initially
 		//qDebug()<<"Soundcard output opened";
 	}
@@ -162,6 +188,9 @@ QAudioDeviceInfo  DeviceInfo;
 //////////////////////////////////////////////////////////////////////////
 void CSoundOut::StopSlot()
 {
+	m_Mutex.lock();
+	m_CardBufSize = 0;
+	m_Mutex.unlock();
 	if(m_pAudioOutput)
 	{
 		if( ( QAudio::ActiveState==m_pAudioOutput->state() )
@@ -182,13 +211,127 @@ void CSoundOut::StopSlot()
 void CSoundOut::Reset()
 {
 	m_Mutex.lock();
-	m_PpmError = 0;
+	ResetRateCorrection();
 	m_OutQHead = 0;
 	m_OutQTail = 0;
 	m_OutQLevel = 0;
 	m_AveOutQLevel = 0;
 	m_Startup = true;
 	m_Mutex.unlock();
+	ResetMixer();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Resets the mixer input streams and interpolator history.
+// Stream gain and pan settings are kept.
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::ResetMixer()
+{
+	m_MixMutex.lock();
+	for(int i=0; i<MAX_MIX_STREAMS; i++)
+	{
+		m_MixStream[i].Active = false;
+		m_MixStream[i].Rd = 0;
+		m_MixStream[i].Level = 0;
+	}
+	for(int c=0; c<OUT_CHANNELS; c++)
+		m_Interpolator[c].Reset();
+	m_MixMutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called when a source stops sending so the mixer no longer waits
+//for its samples.
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::RemoveStream(int Stream)
+{
+	if( (Stream < 0) || (Stream >= MAX_MIX_STREAMS) )
+		return;
+	m_MixMutex.lock();
+	m_MixStream[Stream].Active = false;
+	m_MixStream[Stream].Rd = 0;
+	m_MixStream[Stream].Level = 0;
+	MixStreams();	//other streams may have been waiting on this one
+	m_MixMutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Sets the queue level in 48Ksps samples that the rate correction
+// steers toward. This sets the output latency.
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::SetTargetLevel(int samples)
+{
+	if(samples < SOUNDCARD_OUTRATE/100)
+		samples = SOUNDCARD_OUTRATE/100;
+	if(samples > (OUTQSIZE*3)/4)
+		samples = (OUTQSIZE*3)/4;
+	m_Mutex.lock();
+	m_TargetQLevel = samples;
+	m_PpmIntegral = 0.0;
+	m_Mutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Sets the target output latency in mSec of queued plus soundcard
+// buffered samples, the same delay GetOutputDelay() measures.
+// The soundcard buffer is kept full so the queue target is what is
+// left after it.  Until output is started the buffer is taken to be
+// the size StartSlot() will ask for.
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::SetTargetDelay(int mSec)
+{
+int cardbuf;
+	m_Mutex.lock();
+	m_TargetDelayMsec = mSec;
+	cardbuf = m_CardBufSize;
+	m_Mutex.unlock();
+	if(0 == cardbuf)
+	{
+		cardbuf = (mSec*SOUNDCARD_OUTRATE)/2000;
+		if(cardbuf < (MIN_CARDBUF_MSEC*SOUNDCARD_OUTRATE)/1000)
+			cardbuf = (MIN_CARDBUF_MSEC*SOUNDCARD_OUTRATE)/1000;
+	}
+	SetTargetLevel( (mSec*SOUNDCARD_OUTRATE)/1000 - cardbuf );
+}
+
+/////////////////////////////////////////////////////////////////////
+// Returns the delay in mSec of a full soundcard buffer, 0 if not open
+/////////////////////////////////////////////////////////////////////
+int CSoundOut::GetCardBufDelay()
+{
+int delay;
+	m_Mutex.lock();
+	delay = (m_CardBufSize*1000)/SOUNDCARD_OUTRATE;
+	m_Mutex.unlock();
+	return delay;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Returns current output delay in mSec of queued plus soundcard
+// buffered samples.
+/////////////////////////////////////////////////////////////////////
+int CSoundOut::GetOutputDelay()
+{
+int delay;
+	m_Mutex.lock();
+	delay = (int)( ((m_AveOutQLevel + (double)m_CardBufLevel)*1000.0)/SOUNDCARD_OUTRATE );
+	m_Mutex.unlock();
+	return delay;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Called with m_Mutex locked to reset the rate correction resampler
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::ResetRateCorrection()
+{
+	m_PpmError = 0;
+	m_PpmIntegral = 0.0;
+	m_OutRatio = 1.0;
+	m_ResampleStep = 1.0;
+	m_ResampleMu = 0.0;
+	for(int c=0; c<OUT_CHANNELS; c++)
+		for(int i=0; i<4; i++)
+			m_ResampleHist[c][i] = 0.0;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -202,17 +345,21 @@ void CSoundOut::GetNewData()
 	if( (QAudio::IdleState == m_pAudioOutput->state() ) ||
 		(QAudio::ActiveState == m_pAudioOutput->state() ) )
 	{	//Process sound data while soundcard is active and no errors
+		int framesize = 2*m_OutChannels;
 		int len =  m_pAudioOutput->bytesFree();	//in bytes
 //qDebug()<<len;
 		if( len>0 )
 		{
 			//limit size to m_periodSize
-			if(len > SOUND_WRITEBUFSIZE)
-				len = SOUND_WRITEBUFSIZE;
-			len &= ~(0x01);	//keep on 2 byte chunks
-			GetOutQueue( len/2, (qint16*)m_pData );
+			if(len > SOUND_WRITEBUFSIZE*m_OutChannels)
+				len = SOUND_WRITEBUFSIZE*m_OutChannels;
+			len -= len%framesize;	//keep on whole frames
+			GetOutQueue( len/framesize, (qint16*)m_pData );
 			m_pIODevice->write((char*)m_pData, len);
 		}
+		m_Mutex.lock();
+		m_CardBufLevel = (m_pAudioOutput->bufferSize() - m_pAudioOutput->bytesFree())/framesize;
+		m_Mutex.unlock();
 	}
 	else
 	{	//bail out if error occurs
@@ -223,105 +370,309 @@ void CSoundOut::GetNewData()
 
 
 /////////////////////////////////////////////////////////////////////
-// Sets/changes volume control gain  0 <= vol <= 99
+// Sets/changes master volume control gain  0 <= vol <= 99
 //range scales to attenuation(gain) of -50dB to 0dB
 /////////////////////////////////////////////////////////////////////
 void CSoundOut::SetVolume(qint32 vol)
 {
-	m_Mutex.lock();
+	m_MixMutex.lock();
 	if(0==vol)	//if zero make infinite attenuation
 		m_Gain = 0.0;
 	else if(vol<=99)
 		m_Gain = pow(10.0, ((double)vol-99.0)/39.2 );
-	m_Mutex.unlock();
+	m_MixMutex.unlock();
 //qDebug()<<"Volume "<<vol << m_Gain;
 }
 
+/////////////////////////////////////////////////////////////////////
+// Sets/changes volume of one mixer input stream, same scale as SetVolume()
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::SetStreamVolume(int Stream, qint32 vol)
+{
+	if( (Stream < 0) || (Stream >= MAX_MIX_STREAMS) )
+		return;
+	m_MixMutex.lock();
+	if(0==vol)
+		m_MixStream[Stream].Gain = 0.0;
+	else if(vol<=99)
+		m_MixStream[Stream].Gain = (float)pow(10.0, ((double)vol-99.0)/39.2 );
+	m_MixMutex.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Pans a mixer input stream  -100 == left, 0 == center, 100 == right
+// Centered streams are at full level in both channels.
+/////////////////////////////////////////////////////////////////////
+void CSoundOut::SetStreamPan(int Stream, int Pan)
+{
+	if( (Stream < 0) || (Stream >= MAX_MIX_STREAMS) )
+		return;
+	if(Pan < -100)
+		Pan = -100;
+	if(Pan > 100)
+		Pan = 100;
+	m_MixMutex.lock();
+	m_MixStream[Stream].PanL = (Pan > 0) ? 1.0f - (float)Pan/100.0f : 1.0f;
+	m_MixStream[Stream].PanR = (Pan < 0) ? 1.0f + (float)Pan/100.0f : 1.0f;
+	m_MixMutex.unlock();
+}
+
 ////////////////////////////////////////////////////////////////
 //Called by application to put 16 bit soundcard output samples
-//into soundcard queue
+//into the mixer input fifo of Stream.
 // Input is at 8Ksps rate (1/6 the 48Ksps soundcard rate)
+// Each stream is summed with the other active streams at 8Ksps then
+//the mixed block is interpolated once and sent to the output queue.
 ////////////////////////////////////////////////////////////////
-void CSoundOut::PutOutQueue(int numsamples, qint16* pData )
+void CSoundOut::PutOutQueue(int numsamples, qint16* pData, int Stream)
 {
-int i;
-	if( (0==numsamples) || !pData)
+int n;
+tMixStream* pS;
+	if( (0==numsamples) || !pData )
 		return;
+	if( (Stream < 0) || (Stream >= MAX_MIX_STREAMS) )
+		return;
+	if(numsamples > MIX_FIFO_SIZE)
+	{	//keep only the newest samples
+		pData += (numsamples - MIX_FIFO_SIZE);
+		numsamples = MIX_FIFO_SIZE;
+	}
+	m_MixMutex.lock();
+	pS = &m_MixStream[Stream];
+	n = pS->Level + numsamples - MIX_FIFO_SIZE;
+	if(n > 0)
+	{	//stream is too far ahead of the others so drop its oldest samples
+		pS->Rd += n;
+		pS->Level -= n;
+		qDebug()<<"Snd Mix Overflow"<<Stream<<n;
+	}
+	if( (pS->Rd + pS->Level + numsamples) > MIX_FIFO_SIZE )
+	{	//move waiting samples to the start of the fifo to make room
+		memmove(pS->Fifo, &pS->Fifo[pS->Rd], pS->Level*sizeof(qint16));
+		pS->Rd = 0;
+	}
+	memcpy(&pS->Fifo[pS->Rd + pS->Level], pData, numsamples*sizeof(qint16));
+	pS->Level += numsamples;
+	pS->Active = true;
+	MixStreams();
+	m_MixMutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////
+// Called with m_MixMutex locked to mix all the samples every active
+//stream has ready.  If one stream gets MIX_STALL_LEVEL ahead the
+//streams that stopped sending are mixed as silence and dropped
+//until they send again.
+////////////////////////////////////////////////////////////////
+void CSoundOut::MixStreams()
+{
+int i;
+int s;
+int m;
+int len;
+int n = MIX_FIFO_SIZE;
+int maxlevel = 0;
+bool stereo;
+float gl;
+float gr;
+float x;
+float* pL = m_MixBuf[0];
+float* pR = m_MixBuf[1];
+qint16* pIn;
+tMixStream* pS;
+	for(s=0; s<MAX_MIX_STREAMS; s++)
+	{
+		pS = &m_MixStream[s];
+		if(!pS->Active)
+			continue;
+		if(pS->Level < n)
+			n = pS->Level;
+		if(pS->Level > maxlevel)
+			maxlevel = pS->Level;
+	}
+	if(maxlevel >= MIX_STALL_LEVEL)
+		n = maxlevel;
+	else if(0 == maxlevel)
+		n = 0;
+	while(n > 0)
+	{
+		len = n;
+		if(len > INTP6_BLOCK)
+			len = INTP6_BLOCK;
+		for(i=0; i<len; i++)
+		{
+			pL[i] = 0.0;
+			pR[i] = 0.0;
+		}
+		stereo = false;
+		for(s=0; s<MAX_MIX_STREAMS; s++)
+		{
+			pS = &m_MixStream[s];
+			if(!pS->Active)
+				continue;
+			m = len;
+			if(m > pS->Level)
+			{	//stalled stream
+				m = pS->Level;
+				pS->Active = false;
+			}
+			pIn = &pS->Fifo[pS->Rd];
+			gl = (float)m_Gain*pS->Gain*pS->PanL;
+			gr = (float)m_Gain*pS->Gain*pS->PanR;
+			if(gl != gr)
+				stereo = true;
+			for(i=0; i<m; i++)
+			{
+				x = (float)pIn[i];
+				pL[i] += gl*x;
+				pR[i] += gr*x;
+			}
+			pS->Rd += m;
+			pS->Level -= m;
+			if(0 == pS->Level)
+				pS->Rd = 0;
+		}
+		ResampleToQueue(len, stereo);
+		n -= len;
+	}
+}
+
+////////////////////////////////////////////////////////////////
+// Called with m_MixMutex locked to interpolate n mixed samples up
+//to 48Ksps and put them in the output queue.
+// After interpolation a cubic Farrow resampler runs at m_OutRatio
+//to track the soundcard clock so the queue stays near m_TargetQLevel.
+// If all streams are centered only the left channel is filtered and
+//copied to the right.
+////////////////////////////////////////////////////////////////
+void CSoundOut::ResampleToQueue(int n, bool Stereo)
+{
+int i;
+int c;
+int numout = 0;
+int nchan = Stereo ? OUT_CHANNELS : 1;
+int overflow = 0;
+float c1[OUT_CHANNELS];
+float c2[OUT_CHANNELS];
+float c3[OUT_CHANNELS];
+float y;
+float* h;
+qint16* pOut;
+double mu;
 	//interoplate up to 48Ksps
-	int n = InterpolateX6(pData, m_InterpolatedOutput, numsamples);
+	for(c=0; c<nchan; c++)
+		numout = m_Interpolator[c].ProcessData(m_MixBuf[c], m_InterpolatedOutput[c], n);
+	if(!Stereo)	//keep right channel filter history current for when panning starts
+		m_Interpolator[1].CopyHistory(m_Interpolator[0]);
 	m_Mutex.lock();
-	for( i=0; i<n; i++)
+	mu = m_ResampleMu;
+	for( i=0; i<numout; i++)
 	{
-		m_OutQueueMono[m_OutQHead++] = (qint16)(m_Gain * (double)m_InterpolatedOutput[i]);
-		if(m_OutQHead >= OUTQSIZE)
-			m_OutQHead = 0;
-		m_OutQLevel++;
-		if(m_OutQHead==m_OutQTail)	//if full
-		{	//remove 1/2 a queue's worth of data
-			m_OutQLevel = OUTQSIZE/2;
-			m_AveOutQLevel = m_OutQLevel;
-			m_OutQTail += (OUTQSIZE/2);
-			if(m_OutQTail >= OUTQSIZE)
-				m_OutQTail = m_OutQTail - OUTQSIZE;
-			i = numsamples;		//force break out of for loop
-			qDebug()<<"Snd Out Overflow";
+		for(c=0; c<nchan; c++)
+		{
+			h = m_ResampleHist[c];
+			h[0] = h[1];
+			h[1] = h[2];
+			h[2] = h[3];
+			h[3] = m_InterpolatedOutput[c][i];
+			//Farrow form cubic Lagrange coefficients for point between h[1] and h[2]
+			c1[c] = h[2] - h[0]*(1.0f/3.0f) - h[1]*0.5f - h[3]*(1.0f/6.0f);
+			c2[c] = (h[0] + h[2])*0.5f - h[1];
+			c3[c] = (h[3] - h[0])*(1.0f/6.0f) + (h[1] - h[2])*0.5f;
 		}
+		while(mu < 1.0)
+		{
+			float x = (float)mu;
+			pOut = &m_OutQueue[m_OutQHead*OUT_CHANNELS];
+			for(c=0; c<nchan; c++)
+			{
+				h = m_ResampleHist[c];
+				y = ((c3[c]*x + c2[c])*x + c1[c])*x + h[1];
+				if(y > 32767.0f)
+					y = 32767.0f;
+				if(y < -32768.0f)
+					y = -32768.0f;
+				pOut[c] = (qint16)y;
+			}
+			if(!Stereo)
+				pOut[1] = pOut[0];
+			if(++m_OutQHead >= OUTQSIZE)
+				m_OutQHead = 0;
+			m_OutQLevel++;
+			if(m_OutQHead==m_OutQTail)	//if full
+			{	//drop only the oldest frame
+				if(++m_OutQTail >= OUTQSIZE)
+					m_OutQTail = 0;
+				m_OutQLevel--;
+				overflow++;
+			}
+			mu += m_ResampleStep;
+		}
+		mu -= 1.0;
 	}
+	m_ResampleMu = mu;
+	if(!Stereo)
+		memcpy(m_ResampleHist[1], m_ResampleHist[0], sizeof(m_ResampleHist[0]));
 	//calculate average Queue fill level
 	m_AveOutQLevel = (1.0-FILTERQLEVEL_ALPHA)*m_AveOutQLevel + FILTERQLEVEL_ALPHA*(double)m_OutQLevel;
 	m_Mutex.unlock();
+	if(overflow)
+		qDebug()<<"Snd Out Overflow"<<overflow;
 }
 
 ////////////////////////////////////////////////////////////////
-//Called by CSoundOut worker thread to get new samples from queue
+//Called by CSoundOut worker thread to get new frames from queue
 // This routine is called from a worker thread so must be careful.
-//   MONO version
+// Writes m_OutChannels samples per frame, a mono card gets L+R/2
 ////////////////////////////////////////////////////////////////
-void CSoundOut::GetOutQueue(int numsamples, qint16* pData )
+void CSoundOut::GetOutQueue(int numframes, qint16* pData )
 {
 int i;
+int numsamples = numframes*m_OutChannels;
+qint16* pIn;
 	m_Mutex.lock();
 	if(m_Startup)
 	{	//if no data in queue yet just stuff in silence until something is put in queue
 		for( i=0; i<numsamples; i++)
 			pData[i] = 0;
-		if(m_OutQLevel>OUTQSIZE/2)
+		if(m_OutQLevel >= m_TargetQLevel)
 		{
 			m_Startup = false;
 			m_RateUpdateCount = -5*SOUNDCARD_OUTRATE;	//delay first error update to let settle
-			m_PpmError = 0;
 			m_AveOutQLevel = m_OutQLevel;
 		}
 		m_Mutex.unlock();
 		return;
 	}
 
-	for( i=0; i<numsamples; i++)
+	for( i=0; i<numframes; i++)
 	{
 		if(m_OutQHead != m_OutQTail)
 		{
-			pData[i] = m_OutQueueMono[m_OutQTail++];
-			if(m_OutQTail >= OUTQSIZE)
+			pIn = &m_OutQueue[m_OutQTail*OUT_CHANNELS];
+			if(1 == m_OutChannels)
+			{
+				pData[i] = (qint16)( ((int)pIn[0] + (int)pIn[1])/2 );
+			}
+			else
+			{
+				pData[2*i] = pIn[0];
+				pData[2*i+1] = pIn[1];
+			}
+			if(++m_OutQTail >= OUTQSIZE)
 				m_OutQTail = 0;
 			if(m_OutQLevel>0)
 				m_OutQLevel--;
 		}
 		else	//queue went empty
-		{
-#if 1
-			for(i=0; i<OUTQSIZE; i++)
-				m_OutQueueMono[i] = 0;
-#endif
-			//backup 1/2 queue ptr and use previous data in queue
-			m_OutQTail -= (OUTQSIZE/2);
-			if(m_OutQTail < 0)
-				m_OutQTail = m_OutQTail + OUTQSIZE;
-			pData[i] = m_OutQueueMono[m_OutQTail++];
-			if(m_OutQTail >= OUTQSIZE)
-				m_OutQTail = 0;
-			m_OutQLevel = (OUTQSIZE/2)-1;
-			m_AveOutQLevel = m_OutQLevel;
+		{	//play silence and let the queue fill back up to the target
+			for( i*=m_OutChannels; i<numsamples; i++)
+				pData[i] = 0;
+			m_OutQLevel = 0;
+			m_Startup = true;
+			m_Mutex.unlock();
 			qDebug()<<"Snd Out Underflow";
+			return;
 		}
 	}
 
@@ -329,7 +680,7 @@ int i;
 	m_AveOutQLevel = (1.0-FILTERQLEVEL_ALPHA)*m_AveOutQLevel + FILTERQLEVEL_ALPHA*m_OutQLevel;
 
 	// See if time to update rate error calculation routine
-	m_RateUpdateCount += numsamples;
+	m_RateUpdateCount += numframes;
 	if(m_RateUpdateCount >= SOUNDCARD_OUTRATE)	//every second
 	{
 		CalcError();
@@ -341,65 +692,28 @@ int i;
 ////////////////////////////////////////////////////////////////
 // Called from the Get routine to update the
 // error correction process
+// PI controller on the queue level error sets the resampler ratio.
 ////////////////////////////////////////////////////////////////
 void CSoundOut::CalcError()
 {
 double error;
-	error = (double)(m_AveOutQLevel - OUTQSIZE/2 );	//neg==level is too low  pos == level is to high
-	error = error * P_GAIN;
-	m_PpmError = (int)( error*1e6 );
+double ppm;
+double maxintegral = (MAX_PPM_CORRECTION*1e-6)/I_GAIN;
+	//queue error in seconds, neg==level is too low  pos == level is to high
+	error = (m_AveOutQLevel - (double)m_TargetQLevel)/(double)SOUNDCARD_OUTRATE;
+	m_PpmIntegral += error;
+	if(m_PpmIntegral > maxintegral)		//keep integrator from winding up
+		m_PpmIntegral = maxintegral;
+	if(m_PpmIntegral < -maxintegral)
+		m_PpmIntegral = -maxintegral;
+	ppm = (P_GAIN*error + I_GAIN*m_PpmIntegral)*1e6;
+	if(ppm > MAX_PPM_CORRECTION)
+		ppm = MAX_PPM_CORRECTION;
+	if(ppm < -MAX_PPM_CORRECTION)
+		ppm = -MAX_PPM_CORRECTION;
+	m_PpmError = (int)ppm;
+	//level too high so make fewer output samples to drain it
+	m_OutRatio = 1.0 - ppm*1e-6;
+	m_ResampleStep = 1.0/m_OutRatio;
 //qDebug()<<"SoundOut "<<m_PpmError << m_AveOutQLevel;
 }
-
-////////////////////////////////////////////////////////////////
-// Called Interpolate x6 from 8Ksps to 48 Ksps sample rate
-// 'n' samples in the pIn buffer are output to the pOut buffer.
-// Returns the number of output samples.
-//  Note: make sure the pOut Buffer is greater than 6 times the input
-// buffer size.
-////////////////////////////////////////////////////////////////
-int CSoundOut::InterpolateX6(qint16* pIn, qint16* pOut, int n)
-{
-int j;
-float acc;
-const float* Kptr;
-float* Firptr;
-int ip = 0;
-int numout = 0;
-	while(ip < n )
-	{
-		if( m_Indx%(INTP2_VALUE*INTP3_VALUE) == 0 )	//every 6 outsamples
-		{
-			m_pQue2[m_FirState2/INTP2_VALUE] = (float)pIn[ip++]; //get new input sample
-		}
-		if( m_Indx%(INTP3_VALUE) == 0 )
-		{
-			acc = 0.0;
-			Firptr = m_pQue2;
-			Kptr = X2IntrpFIRCoef+INTP2_FIR_SIZE-m_FirState2;
-			for(j=0; j<INTP2_QUE_SIZE; j++)
-			{
-				acc += ( (*(Firptr++))*(*Kptr) );
-				Kptr += INTP2_VALUE;
-			}
-			if( --m_FirState2 < 0)
-				m_FirState2 = INTP2_FIR_SIZE-1;
-
-			m_pQue3[m_FirState3/INTP3_VALUE] = acc;
-		}
-		acc = 0.0;
-		Firptr = m_pQue3;
-		Kptr = X3IntrpFIRCoef+INTP3_FIR_SIZE-m_FirState3;
-		for(j=0; j<INTP3_QUE_SIZE; j++)
-		{
-			acc += ( (*(Firptr++))*(*Kptr) );
-			Kptr += INTP3_VALUE;
-		}
-		if( --m_FirState3 < 0)
-			m_FirState3 = INTP3_FIR_SIZE-1;
-		pOut[numout++] = (qint16)acc;
-		if( ++m_Indx >= (INTP2_VALUE*INTP3_VALUE) )
-			m_Indx = 0;
-	}
-	return numout;
-}
@@ -9,53 +9,32 @@
 
 #include <QList>
 #include <QIODevice>
+#include <QMutex>
 #include "threadwrapper.h"
 #include <QAudioOutput>
+#include "dsp/interpolatex6.h"
 
 #define OUTQSIZE 24000	//max samples in Queue
 #define SOUND_WRITEBUFSIZE (OUTQSIZE/2)
+#define OUTQ_TARGET_LEVEL (OUTQSIZE/2)	//default queue level rate correction aims for
+#define OUT_CHANNELS 2			//output queue is always stereo interleaved L,R
 
-#define INTP2_FIR_SIZE 38
-#define INTP2_VALUE 2
-#define INTP2_QUE_SIZE (INTP2_FIR_SIZE/INTP2_VALUE)
+#define MAX_MIX_STREAMS 8		//number of 8Ksps input streams the mixer can sum
+#define MIX_FIFO_SIZE 8000		//max samples held per input stream
+#define MIX_STALL_LEVEL 2400	//300mSec, mix without a stream that has stopped sending
 
-const float X2IntrpFIRCoef[INTP2_FIR_SIZE*2] = {
-	0.004595199062f,	 0.003263078569f,	-0.012307513857f,	-0.023605770514f,	-0.004776493194f,
-	 0.020455597889f,	 0.003416955875f,	-0.032096849071f,	-0.010936520267f,	 0.043997619201f,
-	 0.021109718259f,	-0.061591694157f,	-0.038850736238f,	 0.088428267617f,	 0.071893731289f,
-	-0.140300185169f,	-0.155068799286f,	 0.316698335862f,	 0.879226589556f,	 0.879226589556f,
-	 0.316698335862f,	-0.155068799286f,	-0.140300185169f,	 0.071893731289f,	 0.088428267617f,
-	-0.038850736238f,	-0.061591694157f,	 0.021109718259f,	 0.043997619201f,	-0.010936520267f,
-	-0.032096849071f,	 0.003416955875f,	 0.020455597889f,	-0.004776493194f,	-0.023605770514f,
-	-0.012307513857f,	 0.003263078569f,	 0.004595199062f,
-//
-	0.004595199062f,	 0.003263078569f,	-0.012307513857f,	-0.023605770514f,	-0.004776493194f,
-	 0.020455597889f,	 0.003416955875f,	-0.032096849071f,	-0.010936520267f,	 0.043997619201f,
-	 0.021109718259f,	-0.061591694157f,	-0.038850736238f,	 0.088428267617f,	 0.071893731289f,
-	-0.140300185169f,	-0.155068799286f,	 0.316698335862f,	 0.879226589556f,	 0.879226589556f,
-	 0.316698335862f,	-0.155068799286f,	-0.140300185169f,	 0.071893731289f,	 0.088428267617f,
-	-0.038850736238f,	-0.061591694157f,	 0.021109718259f,	 0.043997619201f,	-0.010936520267f,
-	-0.032096849071f,	 0.003416955875f,	 0.020455597889f,	-0.004776493194f,	-0.023605770514f,
-	-0.012307513857f,	 0.003263078569f,	 0.004595199062f
-};
-
-#define INTP3_FIR_SIZE 24
-#define INTP3_VALUE 3
-#define INTP3_QUE_SIZE (INTP3_FIR_SIZE/INTP3_VALUE)
-const float X3IntrpFIRCoef[INTP3_FIR_SIZE*2] = {
-	0.011573982735f,	0.014334218226f,	0.006363947118f,   -0.021096865220f,   -0.062826223097f,
-   -0.096581775049f,   -0.088551387570f,   -0.009298026286f,	0.146903362727f,	0.350809254265f,
-	0.544080700435f,	0.661916011265f,	0.661916011265f,	0.544080700435f,	0.350809254265f,
-	0.146903362727f,   -0.009298026286f,   -0.088551387570f,   -0.096581775049f,   -0.062826223097f,
-   -0.021096865220f,	0.006363947118f,	0.014334218226f,	0.011573982735f,
-//
-	0.011573982735f,	0.014334218226f,	0.006363947118f,   -0.021096865220f,   -0.062826223097f,
-   -0.096581775049f,   -0.088551387570f,   -0.009298026286f,	0.146903362727f,	0.350809254265f,
-	0.544080700435f,	0.661916011265f,	0.661916011265f,	0.544080700435f,	0.350809254265f,
-	0.146903362727f,   -0.009298026286f,   -0.088551387570f,   -0.096581775049f,   -0.062826223097f,
-   -0.021096865220f,	0.006363947118f,	0.014334218226f,	0.011573982735f,
-};
 
+//one mixer input stream
+typedef struct
+{
+	bool Active;	//stream is sending so mixer waits for its samples
+	int Rd;			//index of oldest sample in Fifo
+	int Level;		//number of samples waiting in Fifo
+	float Gain;
+	float PanL;		//left and right pan gains, both 1.0 when centered
+	float PanR;
+	qint16 Fifo[MIX_FIFO_SIZE];
+}tMixStream;
 
 class CSoundOut : public CThreadWrapper
 {
@@ -68,9 +47,16 @@ public:
 	void Start(int OutDevIndx){	emit StartSig(OutDevIndx);	}//starts soundcard output
 	void Stop(){emit StopSig();}	//stops soundcard output
 	void Reset();
-	void PutOutQueue(int numsamples, qint16* pData );
-
-	void SetVolume(qint32 vol);
+	void PutOutQueue(int numsamples, qint16* pData, int Stream = 0);
+	void RemoveStream(int Stream);
+
+	void SetVolume(qint32 vol);		//master volume applied to the mixed output
+	void SetStreamVolume(int Stream, qint32 vol);
+	void SetStreamPan(int Stream, int Pan);		//-100 == left, 0 == center, 100 == right
+	void SetTargetLevel(int samples);
+	void SetTargetDelay(int mSec);
+	int GetOutputDelay();
+	int GetCardBufDelay();
 	int GetRateError(){return (int)m_PpmError;}
 	bool IsRunning(){ if(m_pAudioOutput) return (QAudio::ActiveState == m_pAudioOutput->state()); else return false;}
 
@@ -88,8 +74,11 @@ private slots:
 protected:
 
 private:
-	void GetOutQueue(int numsamples, qint16* pData );
-	int InterpolateX6(qint16* pIn, qint16* pOut, int n);
+	void GetOutQueue(int numframes, qint16* pData );
+	void MixStreams();
+	void ResampleToQueue(int n, bool Stereo);
+	void ResetRateCorrection();
+	void ResetMixer();
 
 	void CalcError();
 
@@ -100,22 +89,30 @@ private:
 	QIODevice* m_pIODevice;	// ptr to internal soundout IODevice
 
 	bool m_Startup;
-	char m_pData[SOUND_WRITEBUFSIZE];
-	qint16 m_OutQueueMono[OUTQSIZE];
-	qint16 m_InterpolatedOutput[OUTQSIZE*6];
+	char m_pData[SOUND_WRITEBUFSIZE*OUT_CHANNELS];
+	qint16 m_OutQueue[OUTQSIZE*OUT_CHANNELS];	//interleaved stereo frames
+	int m_OutChannels;		//channels the soundcard was opened with
 	int m_OutQHead;
 	int m_OutQTail;
 	int m_RateUpdateCount;
 	int m_OutQLevel;
 	int m_PpmError;
 	int m_periodSize;
+	int m_TargetQLevel;
+	int m_CardBufLevel;		//samples waiting in soundcard buffer
+	int m_CardBufSize;		//soundcard buffer size in samples, 0 if not open
+	int m_TargetDelayMsec;	//output delay of queue plus soundcard buffer to aim for
 	double m_Gain;
-	double m_OutRatio;
+	double m_OutRatio;		//output/input ratio of rate correction resampler
+	double m_ResampleStep;	//1/m_OutRatio
+	double m_ResampleMu;	//fractional position between m_ResampleHist[1] and [2]
+	double m_PpmIntegral;
 	double m_AveOutQLevel;
-	int m_Indx;
-	int m_FirState2;
-	int m_FirState3;
-	float m_pQue2[INTP2_QUE_SIZE];
-	float m_pQue3[INTP3_QUE_SIZE];
+	float m_ResampleHist[OUT_CHANNELS][4];
+	CInterpolateX6 m_Interpolator[OUT_CHANNELS];
+	float m_MixBuf[OUT_CHANNELS][INTP6_BLOCK];
+	float m_InterpolatedOutput[OUT_CHANNELS][INTP6_BLOCK*INTP6_VALUE];
+	tMixStream m_MixStream[MAX_MIX_STREAMS];
+	QMutex m_MixMutex;		//protects mixer streams and interpolator, m_Mutex protects output queue
 };
 #endif // SOUNDOUT_H
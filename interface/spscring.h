@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////
+// spscring.h: interface/implementation for the CSpscRing class.
+//
+// Lock free single producer/single consumer byte ring buffer.
+// One thread may call Put() and one other thread may call Get().
+// Put() is all or nothing so the ring only ever holds whole msgs
+// and a false return tells the producer the consumer is falling behind.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef SPSCRING_H
+#define SPSCRING_H
+#include <QtGlobal>
+#include <QAtomicInt>
+#include <string.h>
+
+class CSpscRing
+{
+public:
+	CSpscRing(int Size)	//Size must be a power of 2
+	{
+		m_Size = Size;
+		m_Mask = Size-1;
+		m_pBuf = new char[Size];
+		m_Head.store(0);
+		m_Tail.store(0);
+	}
+	~CSpscRing(){delete [] m_pBuf;}
+
+	// Producer thread only.  Copies all Length bytes or none.
+	bool Put(const char* pBuf, int Length)
+	{
+	quint32 head = (quint32)m_Head.load();		//only producer changes head
+	quint32 tail = (quint32)m_Tail.loadAcquire();
+	int pos;
+	int n;
+		if( Length > (m_Size - (int)(head-tail)) )
+			return false;	//not enough room
+		pos = head & m_Mask;
+		n = m_Size - pos;
+		if(n > Length)
+			n = Length;
+		memcpy(&m_pBuf[pos], pBuf, n);
+		memcpy(m_pBuf, &pBuf[n], Length-n);
+		m_Head.storeRelease( (int)(head+Length) );	//publish new bytes to consumer
+		return true;
+	}
+
+	// Consumer thread only.  Copies up to MaxLength bytes and returns number copied.
+	int Get(char* pBuf, int MaxLength)
+	{
+	quint32 tail = (quint32)m_Tail.load();		//only consumer changes tail
+	quint32 head = (quint32)m_Head.loadAcquire();
+	int length = (int)(head-tail);
+	int pos;
+	int n;
+		if(length > MaxLength)
+			length = MaxLength;
+		if(length <= 0)
+			return 0;
+		pos = tail & m_Mask;
+		n = m_Size - pos;
+		if(n > length)
+			n = length;
+		memcpy(pBuf, &m_pBuf[pos], n);
+		memcpy(&pBuf[n], m_pBuf, length-n);
+		m_Tail.storeRelease( (int)(tail+length) );	//give space back to producer
+		return length;
+	}
+
+	// Number of bytes waiting, may be called from either thread
+	int Available(){return (int)((quint32)m_Head.loadAcquire() - (quint32)m_Tail.loadAcquire());}
+
+private:
+	CSpscRing(const CSpscRing&);
+	CSpscRing& operator=(const CSpscRing&);
+	int m_Size;
+	quint32 m_Mask;
+	char* m_pBuf;
+	QAtomicInt m_Head;	//total bytes put, written by producer
+	QAtomicInt m_Tail;	//total bytes got, written by consumer
+};
+
+#endif // SPSCRING_H
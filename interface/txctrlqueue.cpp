@@ -0,0 +1,168 @@
+//////////////////////////////////////////////////////////////////////
+// txctrlqueue.cpp: implementation of the CTxCtrlQueue class.
+//
+// Control msgs and settings share one CSpscRing so the producer never
+// takes a lock and the order is kept.  All collapsing is done by the
+// consumer while gathering, using a pending buffer and a table of the
+// last value sent of each setting that only the consumer touches.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "txctrlqueue.h"
+#include "ascpmsg.h"
+
+#define TXENTRY_MSG 0		//tag byte put ahead of each msg in the ring
+#define TXENTRY_SETTING 1
+
+/////////////////////////////////////////////////////////////////////
+// Constructor
+/////////////////////////////////////////////////////////////////////
+CTxCtrlQueue::CTxCtrlQueue() : m_Ring(TXQ_SIZE)
+{
+	m_PendLength = 0;
+	m_NumTxSettings = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Producer thread, queues a control msg.
+/////////////////////////////////////////////////////////////////////
+bool CTxCtrlQueue::PutMsg(const char* pBuf, int Length)
+{
+	return Put(TXENTRY_MSG, pBuf, Length);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Producer thread, queues a setting msg.  Msgs with no channel byte
+// or too long to remember are queued as control msgs.
+/////////////////////////////////////////////////////////////////////
+bool CTxCtrlQueue::PutSetting(const char* pBuf, int Length)
+{
+	if( (Length < 5) || (Length > TXSETTING_MAXLEN) )
+		return Put(TXENTRY_MSG, pBuf, Length);
+	return Put(TXENTRY_SETTING, pBuf, Length);
+}
+
+bool CTxCtrlQueue::Put(char Tag, const char* pBuf, int Length)
+{
+char buf[MAX_ASCPMSG_LENGTH+1];
+	if( (Length < 2) || (Length > MAX_ASCPMSG_LENGTH) )
+		return false;
+	buf[0] = Tag;
+	memcpy(&buf[1], pBuf, Length);
+	return m_Ring.Put(buf, Length+1);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Consumer thread, throws away everything queued.  The last sent
+// values are forgotten since a new connection may not have them.
+/////////////////////////////////////////////////////////////////////
+void CTxCtrlQueue::Reset()
+{
+	while( m_Ring.Get(m_Pend, TXQ_SIZE) > 0 )
+		;
+	m_PendLength = 0;
+	m_NumTxSettings = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Length of the msg after the tag byte at m_Pend[Pos]
+/////////////////////////////////////////////////////////////////////
+int CTxCtrlQueue::GetMsgLength(int Pos)
+{
+int length = ( (int)(quint8)m_Pend[Pos+1] | ((int)(quint8)m_Pend[Pos+2]<<8) ) & LENGTH_MASK;
+	if(0 == length)
+		length = 8192+2;
+	return length;
+}
+
+static quint32 SettingKey(const char* pMsg)
+{
+	return ((quint32)(quint8)pMsg[3]<<16) | ((quint32)(quint8)pMsg[2]<<8) | (quint8)pMsg[4];
+}
+
+/////////////////////////////////////////////////////////////////////
+// True if the setting at m_Pend[Pos] has a newer value pending
+// before the next control msg.
+/////////////////////////////////////////////////////////////////////
+bool CTxCtrlQueue::IsReplaced(int Pos)
+{
+quint32 key = SettingKey(&m_Pend[Pos+1]);
+	for(Pos += 1 + GetMsgLength(Pos); Pos < m_PendLength; Pos += 1 + GetMsgLength(Pos))
+	{
+		if(TXENTRY_SETTING != m_Pend[Pos])
+			return false;
+		if(SettingKey(&m_Pend[Pos+1]) == key)
+			return true;
+	}
+	return false;
+}
+
+tTxSetting* CTxCtrlQueue::FindSetting(quint32 Key)
+{
+	for(int i=0; i<m_NumTxSettings; i++)
+	{
+		if(m_TxSettings[i].Key == Key)
+			return &m_TxSettings[i];
+	}
+	if(TXSETTING_MAX == m_NumTxSettings)
+		return NULL;	//table full so this setting is always sent
+	m_TxSettings[m_NumTxSettings].Key = Key;
+	m_TxSettings[m_NumTxSettings].SentLength = 0;
+	return &m_TxSettings[m_NumTxSettings++];
+}
+
+/////////////////////////////////////////////////////////////////////
+// Consumer thread, gathers queued msgs in order into pBuf.
+// A control msg that sets server state may change what the server does
+// with settings so the last sent values are forgotten after it and the
+// next setting msgs always go out.
+/////////////////////////////////////////////////////////////////////
+int CTxCtrlQueue::Gather(char* pBuf, bool HoldSettings, int& Msgs, int& Collapsed)
+{
+int length = 0;
+int pos = 0;
+int len;
+char* pMsg;
+tTxSetting* pSetting;
+	Msgs = 0;
+	Collapsed = 0;
+	if(m_PendLength <= TXQ_SIZE)	//room for everything the ring can hold
+		m_PendLength += m_Ring.Get(&m_Pend[m_PendLength], TXQ_SIZE);
+	while(pos < m_PendLength)
+	{
+		len = GetMsgLength(pos);
+		pMsg = &m_Pend[pos+1];
+		if(TXENTRY_SETTING == m_Pend[pos])
+		{
+			pSetting = FindSetting(SettingKey(pMsg));
+			if( IsReplaced(pos) ||
+				(pSetting && (len == pSetting->SentLength) && (0 == memcmp(pMsg, pSetting->SentMsg, len))) )
+			{	//newer value follows or server already has this value
+				Collapsed++;
+				pos += 1 + len;
+				continue;
+			}
+			if(HoldSettings)
+				break;	//keep it and everything after it pending
+			if(pSetting)
+			{
+				memcpy(pSetting->SentMsg, pMsg, len);
+				pSetting->SentLength = len;
+			}
+		}
+		else if( TYPE_HOST_SET_CITEM == ((quint8)pMsg[1] & TYPE_MASK) )
+		{
+			for(int i=0; i<m_NumTxSettings; i++)
+				m_TxSettings[i].SentLength = 0;
+		}
+		memcpy(&pBuf[length], pMsg, len);
+		length += len;
+		Msgs++;
+		pos += 1 + len;
+	}
+	m_PendLength -= pos;
+	if(m_PendLength && pos)
+		memmove(m_Pend, &m_Pend[pos], m_PendLength);
+	return length;
+}
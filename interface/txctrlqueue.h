@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////
+// txctrlqueue.h: interface for the CTxCtrlQueue class.
+//
+// Lock free queue of control and setting msgs going to the server.
+// One producer thread puts msgs and the TCP worker thread gathers
+// them for a socket write.  Settings are msgs where only the latest
+// value matters (frequency, filter, gain etc.).  Everything leaves in
+// the order it was put.  When gathering, a setting is dropped if a
+// newer value of the same CItem and channel was put after it with no
+// control msg in between, or if the server was already sent the same
+// value.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef TXCTRLQUEUE_H
+#define TXCTRLQUEUE_H
+
+#include "spscring.h"
+
+#define TXQ_SIZE 16384		//control msg queue size (must be power of 2)
+#define TXSETTING_MAX 48		//max number of different settings remembered, several per rx channel
+#define TXSETTING_MAXLEN 16		//max length of a setting msg
+#define TXCTRL_GATHER_SIZE (2*TXQ_SIZE)	//max bytes Gather() can return
+
+typedef struct
+{
+	quint32 Key;			//CItem<<8 | channel
+	int SentLength;			//length of last msg sent, 0 if none
+	char SentMsg[TXSETTING_MAXLEN];
+}tTxSetting;
+
+class CTxCtrlQueue
+{
+public:
+	CTxCtrlQueue();
+
+	//producer thread only, return false if the queue is full and the msg was dropped
+	bool PutMsg(const char* pBuf, int Length);
+	bool PutSetting(const char* pBuf, int Length);
+
+	//consumer thread only
+	//Copies msgs to pBuf which must hold TXCTRL_GATHER_SIZE bytes and
+	//returns the number of bytes.  If HoldSettings is true gathering stops
+	//at the first setting that would be sent so it can still be replaced.
+	//Msgs is set to the number of msgs copied and Collapsed to the number
+	//of settings dropped.
+	int Gather(char* pBuf, bool HoldSettings, int& Msgs, int& Collapsed);
+	//throws away everything queued and forgets the last sent setting values
+	void Reset();
+
+private:
+	bool Put(char Tag, const char* pBuf, int Length);
+	int GetMsgLength(int Pos);
+	bool IsReplaced(int Pos);
+	tTxSetting* FindSetting(quint32 Key);
+	CSpscRing m_Ring;		//tag byte followed by the msg
+	char m_Pend[TXCTRL_GATHER_SIZE];	//msgs taken from m_Ring but not sent yet
+	int m_PendLength;
+	tTxSetting m_TxSettings[TXSETTING_MAX];	//last value sent of each setting
+	int m_NumTxSettings;
+};
+
+#endif // TXCTRLQUEUE_H
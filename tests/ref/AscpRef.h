@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////
+// AscpRef.h: byte at a time ASCP msg assembler.
+//
+//  Unchanged copy of the CNetio::AssembleAscpMsg() state machine from
+// before msgs were parsed in place, kept in namespace ascpref as the
+// reference and baseline the current framing is tested against.  Every
+// byte is copied into the msg buffer as it is examined.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef ASCPREF_H
+#define ASCPREF_H
+
+#include "interface/ascpmsg.h"
+
+namespace ascpref {
+
+class CAscpAssembler
+{
+public:
+	CAscpAssembler(){m_MsgState = MSGSTATE_HDR1; m_RxMsgLength = 0; m_RxMsgIndex = 0;}
+	virtual ~CAscpAssembler(){}
+	virtual void ParseAscpMsg(CAscpRxMsg* pMsg) = 0;
+
+	void AssembleAscpMsg(quint8* Buf, int Len)
+	{
+		for(int i=0; i<Len; i++)
+		{	//process everything in Buf
+			switch(m_MsgState)	//Simple state machine to get generic ASCP msg
+			{
+				case MSGSTATE_HDR1:		//get first header byte of ASCP msg
+					m_RxAscpMsg.Buf8[0] = Buf[i];
+					m_MsgState = MSGSTATE_HDR2;	//go to get second header byte state
+					break;
+				case MSGSTATE_HDR2:	//here for second byte of header
+					m_RxAscpMsg.Buf8[1] = Buf[i];
+					m_RxMsgLength = m_RxAscpMsg.GetLength();
+					m_RxMsgIndex = 2;
+					if(2 == m_RxMsgLength)	//if msg has no parameters then we are done
+					{
+						m_MsgState = MSGSTATE_HDR1;	//go back to first state
+						ParseAscpMsg( &m_RxAscpMsg );
+					}
+					else	//there are data bytes to fetch
+					{
+						if( 0 == m_RxMsgLength)
+							m_RxMsgLength = 8192+2;	//handle special case of 8192 byte data message
+						m_MsgState = MSGSTATE_DATA;	//go to data byte reading state
+					}
+					break;
+				case MSGSTATE_DATA:	//try to read the rest of the message
+					m_RxAscpMsg.Buf8[m_RxMsgIndex++] = Buf[i];
+					if( m_RxMsgIndex >= m_RxMsgLength )
+					{
+						m_MsgState = MSGSTATE_HDR1;	//go back to first stage
+						m_RxMsgIndex = 0;
+						ParseAscpMsg( &m_RxAscpMsg );	//got complete msg so call virtual parser.
+					}
+					break;
+			} //end switch statement
+		}
+	}
+
+private:
+	CAscpRxMsg m_RxAscpMsg;
+	int m_MsgState;
+	int m_RxMsgLength;
+	int m_RxMsgIndex;
+};
+
+}	// namespace ascpref
+
+#endif // ASCPREF_H
@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////
+// FirRef.h: FIR filter with scalar MAC loops.
+//
+//  Unchanged copies of the CFir::ProcessFilter() loops from before
+// they called the vector ops, kept in namespace firref as the baseline
+// the current CFir is checked and timed against.  Coefficients are
+// set from an impulse response instead of being designed here.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef FIRREF_H
+#define FIRREF_H
+
+#include "dsp/fir.h"
+
+namespace firref {
+
+class CFir
+{
+public:
+	CFir(){m_NumTaps = 1; m_State = 0;}
+
+	//h[0] is applied to the newest sample
+	void SetCoef(const TYPEREAL* h, int NumTaps)
+	{
+		m_NumTaps = NumTaps;
+		m_State = 0;
+		for(int i=0; i<NumTaps; i++)
+		{
+			m_Coef[i] = h[i];
+			m_Coef[NumTaps+i] = h[i];
+			m_rZBuf[i] = 0.0;
+		}
+	}
+
+	void ProcessFilter(int InLength, TYPEREAL* InBuf, TYPEREAL* OutBuf)
+	{
+	TYPEREAL acc;
+	TYPEREAL* Zptr;
+	const TYPEREAL* Hptr;
+		for(int i=0; i<InLength; i++)
+		{
+			m_rZBuf[m_State] = InBuf[i];
+			Hptr = &m_Coef[m_NumTaps - m_State];
+			Zptr = m_rZBuf;
+			acc = 0.0;
+			for(int j=0; j<m_NumTaps; j++)
+				acc += (*Hptr++ * *Zptr++);	//do the MACs
+			if(--m_State < 0)
+				m_State += m_NumTaps;
+			OutBuf[i] = acc;
+		}
+	}
+
+	void ProcessFilter(int InLength, qint16* InBuf, qint16* OutBuf)
+	{
+	TYPEREAL acc;
+	TYPEREAL* Zptr;
+	const TYPEREAL* Hptr;
+		for(int i=0; i<InLength; i++)
+		{
+			m_rZBuf[m_State] = (TYPEREAL)InBuf[i];
+			Hptr = &m_Coef[m_NumTaps - m_State];
+			Zptr = m_rZBuf;
+			acc = 0.0;
+			for(int j=0; j<m_NumTaps; j++)
+				acc += (*Hptr++ * *Zptr++);	//do the MACs
+			if(--m_State < 0)
+				m_State += m_NumTaps;
+			OutBuf[i] = (qint16)acc;
+		}
+	}
+
+private:
+	int m_NumTaps;
+	int m_State;
+	TYPEREAL m_Coef[MAX_NUMCOEF*2];
+	TYPEREAL m_rZBuf[MAX_NUMCOEF];
+};
+
+}	// namespace firref
+
+#endif // FIRREF_H
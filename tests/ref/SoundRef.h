@@ -0,0 +1,243 @@
+//////////////////////////////////////////////////////////////////////
+// SoundRef.h: sound card rate conversion filters before block
+// processing.
+//
+//  Unchanged copies of the CSoundOut and CSoundIn cascaded
+// filters from before they were replaced, kept in namespace soundref
+// as the baseline the current dsp classes are timed and checked
+// against.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef SOUNDREF_H
+#define SOUNDREF_H
+
+#include <QtGlobal>
+#include "dsp/interpolatex6.h"
+#include "dsp/decimateby6.h"
+
+namespace soundref {
+
+//the old filters read coefficients through a sliding pointer so each
+//array holds the taps twice
+const double DEC3_H[DEC3TAP_LENGTH*2] =
+{
+	-0.000122089672, 0.000756870819, 0.002723170921, 0.005253908351, 0.006498627630,
+	 0.004642639462,-0.000127922266,-0.004816317633,-0.005459270973,-0.000749873754,
+	 0.005791180122, 0.007947782646, 0.002401758772,-0.007062842708,-0.011594604118,
+	 -0.005173923318, 0.008331932993, 0.016607547268, 0.009560094412,-0.009513394530,
+	-0.023769125601,-0.016708360339, 0.010511004278, 0.035111757024, 0.029654555288,
+	-0.011273660216,-0.057805247862,-0.060635313789, 0.011753658267, 0.142509501597,
+	 0.269092683398, 0.321418881518, 0.269092683398, 0.142509501597, 0.011753658267,
+	 -0.060635313789,-0.057805247862,-0.011273660216, 0.029654555288, 0.035111757024,
+	 0.010511004278,-0.016708360339,-0.023769125601,-0.009513394530, 0.009560094412,
+	  0.016607547268, 0.008331932993,-0.005173923318,-0.011594604118,-0.007062842708,
+	 0.002401758772, 0.007947782646, 0.005791180122,-0.000749873754,-0.005459270973,
+	 -0.004816317633,-0.000127922266, 0.004642639462, 0.006498627630, 0.005253908351,
+	 0.002723170921, 0.000756870819,-0.000122089672,
+	//
+	-0.000122089672, 0.000756870819, 0.002723170921, 0.005253908351, 0.006498627630,
+	 0.004642639462,-0.000127922266,-0.004816317633,-0.005459270973,-0.000749873754,
+	 0.005791180122, 0.007947782646, 0.002401758772,-0.007062842708,-0.011594604118,
+	 -0.005173923318, 0.008331932993, 0.016607547268, 0.009560094412,-0.009513394530,
+	-0.023769125601,-0.016708360339, 0.010511004278, 0.035111757024, 0.029654555288,
+	-0.011273660216,-0.057805247862,-0.060635313789, 0.011753658267, 0.142509501597,
+	 0.269092683398, 0.321418881518, 0.269092683398, 0.142509501597, 0.011753658267,
+	 -0.060635313789,-0.057805247862,-0.011273660216, 0.029654555288, 0.035111757024,
+	 0.010511004278,-0.016708360339,-0.023769125601,-0.009513394530, 0.009560094412,
+	  0.016607547268, 0.008331932993,-0.005173923318,-0.011594604118,-0.007062842708,
+	 0.002401758772, 0.007947782646, 0.005791180122,-0.000749873754,-0.005459270973,
+	 -0.004816317633,-0.000127922266, 0.004642639462, 0.006498627630, 0.005253908351,
+	 0.002723170921, 0.000756870819,-0.000122089672
+};
+
+const float X2IntrpFIRCoef[INTP2_FIR_SIZE*2] = {
+	0.004595199062f,	 0.003263078569f,	-0.012307513857f,	-0.023605770514f,	-0.004776493194f,
+	 0.020455597889f,	 0.003416955875f,	-0.032096849071f,	-0.010936520267f,	 0.043997619201f,
+	 0.021109718259f,	-0.061591694157f,	-0.038850736238f,	 0.088428267617f,	 0.071893731289f,
+	-0.140300185169f,	-0.155068799286f,	 0.316698335862f,	 0.879226589556f,	 0.879226589556f,
+	 0.316698335862f,	-0.155068799286f,	-0.140300185169f,	 0.071893731289f,	 0.088428267617f,
+	-0.038850736238f,	-0.061591694157f,	 0.021109718259f,	 0.043997619201f,	-0.010936520267f,
+	-0.032096849071f,	 0.003416955875f,	 0.020455597889f,	-0.004776493194f,	-0.023605770514f,
+	-0.012307513857f,	 0.003263078569f,	 0.004595199062f,
+//
+	0.004595199062f,	 0.003263078569f,	-0.012307513857f,	-0.023605770514f,	-0.004776493194f,
+	 0.020455597889f,	 0.003416955875f,	-0.032096849071f,	-0.010936520267f,	 0.043997619201f,
+	 0.021109718259f,	-0.061591694157f,	-0.038850736238f,	 0.088428267617f,	 0.071893731289f,
+	-0.140300185169f,	-0.155068799286f,	 0.316698335862f,	 0.879226589556f,	 0.879226589556f,
+	 0.316698335862f,	-0.155068799286f,	-0.140300185169f,	 0.071893731289f,	 0.088428267617f,
+	-0.038850736238f,	-0.061591694157f,	 0.021109718259f,	 0.043997619201f,	-0.010936520267f,
+	-0.032096849071f,	 0.003416955875f,	 0.020455597889f,	-0.004776493194f,	-0.023605770514f,
+	-0.012307513857f,	 0.003263078569f,	 0.004595199062f
+};
+
+const float X3IntrpFIRCoef[INTP3_FIR_SIZE*2] = {
+	0.011573982735f,	0.014334218226f,	0.006363947118f,   -0.021096865220f,   -0.062826223097f,
+   -0.096581775049f,   -0.088551387570f,   -0.009298026286f,	0.146903362727f,	0.350809254265f,
+	0.544080700435f,	0.661916011265f,	0.661916011265f,	0.544080700435f,	0.350809254265f,
+	0.146903362727f,   -0.009298026286f,   -0.088551387570f,   -0.096581775049f,   -0.062826223097f,
+   -0.021096865220f,	0.006363947118f,	0.014334218226f,	0.011573982735f,
+//
+	0.011573982735f,	0.014334218226f,	0.006363947118f,   -0.021096865220f,   -0.062826223097f,
+   -0.096581775049f,   -0.088551387570f,   -0.009298026286f,	0.146903362727f,	0.350809254265f,
+	0.544080700435f,	0.661916011265f,	0.661916011265f,	0.544080700435f,	0.350809254265f,
+	0.146903362727f,   -0.009298026286f,   -0.088551387570f,   -0.096581775049f,   -0.062826223097f,
+   -0.021096865220f,	0.006363947118f,	0.014334218226f,	0.011573982735f,
+};
+
+//CSoundOut::InterpolateX6() with the x2 and x3 filters in cascade
+class CInterpolateX6
+{
+public:
+	CInterpolateX6()
+	{
+		m_FirState2 = INTP2_QUE_SIZE-1;
+		m_FirState3 = INTP3_QUE_SIZE-1;
+		m_Indx = 0;
+		for(int i=0; i<INTP2_QUE_SIZE; i++)
+			m_pQue2[i] = 0.0;
+		for( int i=0; i<INTP3_QUE_SIZE; i++)
+			m_pQue3[i] = 0.0;
+	}
+
+	int InterpolateX6(qint16* pIn, qint16* pOut, int n)
+	{
+	int j;
+	float acc;
+	const float* Kptr;
+	float* Firptr;
+	int ip = 0;
+	int numout = 0;
+		while(ip < n )
+		{
+			if( m_Indx%(INTP2_VALUE*INTP3_VALUE) == 0 )	//every 6 outsamples
+			{
+				m_pQue2[m_FirState2/INTP2_VALUE] = (float)pIn[ip++]; //get new input sample
+			}
+			if( m_Indx%(INTP3_VALUE) == 0 )
+			{
+				acc = 0.0;
+				Firptr = m_pQue2;
+				Kptr = X2IntrpFIRCoef+INTP2_FIR_SIZE-m_FirState2;
+				for(j=0; j<INTP2_QUE_SIZE; j++)
+				{
+					acc += ( (*(Firptr++))*(*Kptr) );
+					Kptr += INTP2_VALUE;
+				}
+				if( --m_FirState2 < 0)
+					m_FirState2 = INTP2_FIR_SIZE-1;
+
+				m_pQue3[m_FirState3/INTP3_VALUE] = acc;
+			}
+			acc = 0.0;
+			Firptr = m_pQue3;
+			Kptr = X3IntrpFIRCoef+INTP3_FIR_SIZE-m_FirState3;
+			for(j=0; j<INTP3_QUE_SIZE; j++)
+			{
+				acc += ( (*(Firptr++))*(*Kptr) );
+				Kptr += INTP3_VALUE;
+			}
+			if( --m_FirState3 < 0)
+				m_FirState3 = INTP3_FIR_SIZE-1;
+			pOut[numout++] = (qint16)acc;
+			if( ++m_Indx >= (INTP2_VALUE*INTP3_VALUE) )
+				m_Indx = 0;
+		}
+		return numout;
+	}
+
+private:
+	int m_FirState2;
+	int m_FirState3;
+	int m_Indx;
+	float m_pQue2[INTP2_QUE_SIZE];
+	float m_pQue3[INTP3_QUE_SIZE];
+};
+
+#define DECREF_MAX_INLENGTH 8000	//SOUND_READBUFSIZE when these were in CSoundIn
+
+//CSoundIn::DecBy2() and DecBy3() run in cascade.  InLength must be even
+//and no smaller than DEC2TAP_LENGTH.
+class CDecimateBy6
+{
+public:
+	CDecimateBy6()
+	{
+		m_SampCnt = 0;
+		m_Dec3State = DEC3TAP_LENGTH-1;
+		for(int i=0; i<DECREF_MAX_INLENGTH+DEC2TAP_LENGTH; i++)
+			m_Dec2FirBuf[i] = 0.0;
+		for(int i=0; i<DECREF_MAX_INLENGTH; i++)
+			m_Dec3FirBuf[i] = 0.0;
+	}
+
+	int DecBy6(int InLength, qint16* pInData, qint16* pOutData)
+	{
+		int n = DecBy2(InLength, pInData, m_TmpDecBuf);
+		return DecBy3(n, m_TmpDecBuf, pOutData);
+	}
+
+private:
+	int DecBy2(int InLength, qint16* pInData, double* pOutData)
+	{
+	int i;
+	int j;
+	int numoutsamples = 0;
+		//copy input samples into buffer starting at position m_FirLength-1
+		for(i=0,j = DEC2TAP_LENGTH - 1; i<InLength; i++)
+			m_Dec2FirBuf[j++] = (double)pInData[i];
+		//perform decimation FIR filter on even samples
+		for(i=0; i<InLength; i+=2)
+		{
+			double acc;
+			acc = ( m_Dec2FirBuf[i] * DEC2_H[0] );
+			for(j=2; j<DEC2TAP_LENGTH; j+=2)	//only use even coefficients since odd are zero(except center point)
+				acc += ( m_Dec2FirBuf[i+j] * DEC2_H[j] );
+			//now multiply the center coefficient
+			acc += ( m_Dec2FirBuf[i+(DEC2TAP_LENGTH-1)/2] * DEC2_H[(DEC2TAP_LENGTH-1)/2] );
+			pOutData[numoutsamples++] = acc;	//put in  output buffer
+		}
+		//need to copy last m_FirLength - 1 input samples in buffer to beginning of buffer
+		// for FIR wrap around management
+		for(i=0,j = InLength-DEC2TAP_LENGTH+1; i<DEC2TAP_LENGTH - 1; i++)
+			m_Dec2FirBuf[i] = (double)pInData[j++];
+		return numoutsamples;
+	}
+
+	int DecBy3(int InLength, double* pInData, qint16* pOutData)
+	{
+	int i,j,n;
+	const double* Kptr;
+	double acc;
+	double* Firptr;
+		n = 0;
+		for( i = 0; i<InLength; i++ )	// put new samples into Queue
+		{
+			m_Dec3FirBuf[m_Dec3State] = pInData[i];	//place in circular Queue
+			if(--m_SampCnt <=0 )	//calc first decimation filter every 2 samples
+			{
+				m_SampCnt = 3;
+				acc = 0.0;
+				Firptr = m_Dec3FirBuf;
+				Kptr = DEC3_H + DEC3TAP_LENGTH - m_Dec3State;
+				for(j=0; j<	DEC3TAP_LENGTH; j++)	//do the MAC's
+					acc += ( (*(Firptr++)) * (*Kptr++) );
+				pOutData[n++] = (qint16)acc;
+			}
+			if( --m_Dec3State < 0)	//deal with FIR pointer wraparound
+				m_Dec3State = DEC3TAP_LENGTH-1;
+		}
+		return n;
+	}
+
+	int m_SampCnt;
+	int m_Dec3State;
+	double m_Dec2FirBuf[DECREF_MAX_INLENGTH+DEC2TAP_LENGTH];
+	double m_Dec3FirBuf[DECREF_MAX_INLENGTH];
+	double m_TmpDecBuf[DECREF_MAX_INLENGTH];
+};
+
+}	// namespace soundref
+
+#endif // SOUNDREF_H
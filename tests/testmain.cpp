@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////
+// testmain.cpp: runs the unit tests and benchmarks.
+//
+//  remotesdrtests           runs all tests
+//  remotesdrtests -b        runs all tests and benchmarks
+//  remotesdrtests name ...  runs only the named tests or benchmarks
+// Returns 0 if every test that ran passed.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include <string.h>
+
+bool TestG711();
+bool BenchG711();
+bool TestIqDemod();
+bool TestIqDemodModes();
+bool TestChannelizer();
+bool TestFft();
+bool BenchFft();
+bool TestSpscRing();
+bool BenchSpscRing();
+bool BenchChannelizer();
+bool BenchIqDemod();
+bool TestAscp();
+bool BenchAscp();
+bool TestInterpolateX6();
+bool BenchInterpolateX6();
+bool TestDecimateBy6();
+bool BenchDecimateBy6();
+bool TestVectorOps();
+bool TestFir();
+bool BenchVecDot();
+bool BenchFir();
+bool TestTxCtrlQueue();
+bool BenchWaterfall();
+
+static const ttestentry TestTable[] =
+{
+	{"g711", TestG711, false},
+	{"iqdemod", TestIqDemod, false},
+	{"iqdemod_modes", TestIqDemodModes, false},
+	{"channelizer", TestChannelizer, false},
+	{"fft", TestFft, false},
+	{"spscring", TestSpscRing, false},
+	{"ascp", TestAscp, false},
+	{"interpolatex6", TestInterpolateX6, false},
+	{"decimateby6", TestDecimateBy6, false},
+	{"vectorops", TestVectorOps, false},
+	{"fir", TestFir, false},
+	{"txctrlqueue", TestTxCtrlQueue, false},
+	{"bench_g711", BenchG711, true},
+	{"bench_channelizer", BenchChannelizer, true},
+	{"bench_iqdemod", BenchIqDemod, true},
+	{"bench_fft", BenchFft, true},
+	{"bench_spscring", BenchSpscRing, true},
+	{"bench_ascp", BenchAscp, true},
+	{"bench_interpolatex6", BenchInterpolateX6, true},
+	{"bench_decimateby6", BenchDecimateBy6, true},
+	{"bench_vecdot", BenchVecDot, true},
+	{"bench_fir", BenchFir, true},
+	{"bench_waterfall", BenchWaterfall, true},
+};
+
+int main(int argc, char* argv[])
+{
+int i;
+int j;
+int run = 0;
+int failed = 0;
+bool bench = false;
+bool named = false;
+bool selected;
+	for(j=1; j<argc; j++)
+	{
+		if(0 == strcmp(argv[j], "-b"))
+			bench = true;
+		else
+			named = true;
+	}
+	for(i=0; i<(int)(sizeof(TestTable)/sizeof(TestTable[0])); i++)
+	{
+		selected = !named && (bench || !TestTable[i].Bench);
+		for(j=1; j<argc; j++)
+		{
+			if(0 == strcmp(argv[j], TestTable[i].Name))
+				selected = true;
+		}
+		if(!selected)
+			continue;
+		printf("%s\n", TestTable[i].Name);
+		run++;
+		if(!TestTable[i].pFunc())
+			failed++;
+	}
+	printf("%d run, %d failed\n", run, failed);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+# Unit tests and benchmarks, build from this directory with
+#   qmake && make && ./remotesdrtests -b
+QT = core gui widgets	# dsp/datatypes.h includes <QApplication>
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+TARGET = remotesdrtests
+TEMPLATE = app
+
+INCLUDEPATH += .. ../interface
+
+SOURCES += \
+    testmain.cpp \
+    tst_g711.cpp \
+    tst_iqdemod.cpp \
+    tst_fft.cpp \
+    tst_spscring.cpp \
+    tst_ascp.cpp \
+    tst_resample.cpp \
+    tst_vectorops.cpp \
+    tst_txctrlqueue.cpp \
+    tst_waterfall.cpp \
+    ../interface/ascpframer.cpp \
+    ../interface/txctrlqueue.cpp \
+    ../dsp/G711.cpp \
+    ../dsp/iqdemod.cpp \
+    ../dsp/channelizer.cpp \
+    ../dsp/fft.cpp \
+    ../dsp/fir.cpp \
+    ../dsp/vectorops.cpp \
+    ../dsp/interpolatex6.cpp \
+    ../dsp/decimateby6.cpp
+
+HEADERS += \
+    testutil.h \
+    ref/AscpRef.h \
+    ref/SoundRef.h \
+    ref/FirRef.h
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////
+// testutil.h: helpers shared by the unit tests and benchmarks.
+//
+//  A test is a function returning true if it passed.  TEST_CHECK
+// prints the failing condition and returns false from the test.
+// Benchmarks print their results and return true.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#ifndef TESTUTIL_H
+#define TESTUTIL_H
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <stdio.h>
+
+#define TEST_CHECK(cond) \
+	do{ if(!(cond)){ printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); return false; } }while(0)
+
+typedef bool (*TestFunc)();
+
+typedef struct
+{
+	const char* Name;
+	TestFunc pFunc;
+	bool Bench;		//only run when benchmarks are asked for
+} ttestentry;
+
+/////////////////////////////////////////////////////////////////////
+// Simple repeatable pseudo random numbers so tests do not depend on
+// the C library rand()
+/////////////////////////////////////////////////////////////////////
+class CTestRand
+{
+public:
+	CTestRand(quint32 seed = 1){m_State = seed;}
+	quint32 Next(){m_State = m_State*1664525 + 1013904223; return m_State;}
+	int Range(int min, int max){return min + (int)((Next()>>8) % (quint32)(max - min + 1));}
+private:
+	quint32 m_State;
+};
+
+/////////////////////////////////////////////////////////////////////
+// Times a block of code and prints the time per unit of work.
+// Usage:
+//	CBenchTimer timer;
+//	for(...) {work}
+//	timer.Print("name", units, "sample");
+// For noisy machines the work can be timed several times with EndRun()
+// after each run, Print() then uses the fastest run and units per run.
+/////////////////////////////////////////////////////////////////////
+class CBenchTimer
+{
+public:
+	CBenchTimer(){Restart();}
+	void Restart(){m_Best = 0.0; m_Timer.start();}
+	double GetNsec(){return (double)m_Timer.nsecsElapsed();}
+	void EndRun()
+	{
+		double ns = GetNsec();
+		if( (0.0 == m_Best) || (ns < m_Best) )
+			m_Best = ns;
+		m_Timer.start();
+	}
+	void Print(const char* Name, double Units, const char* UnitName)
+	{
+		double ns = (0.0 == m_Best) ? GetNsec() : m_Best;
+		printf("  %-36s %10.2f nSec/%s\n", Name, ns/Units, UnitName);
+	}
+private:
+	QElapsedTimer m_Timer;
+	double m_Best;		//fastest run in nSec, 0 if EndRun() not used
+};
+
+#endif // TESTUTIL_H
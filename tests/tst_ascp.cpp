@@ -0,0 +1,246 @@
+//////////////////////////////////////////////////////////////////////
+// tst_ascp.cpp: ASCP receive framing test and benchmark.
+//
+//  CAscpFramer, the receive framing CNetio uses, is fed the stream the
+// way CTcp::ReadTcpDataSlot() feeds it socket reads.  It is checked
+// against and timed with the old byte at a time assembler in
+// ref/AscpRef.h.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "interface/ascpmsg.h"
+#include "interface/ascpframer.h"
+#include "ref/AscpRef.h"
+#include <string.h>
+
+#define ASCP_STREAM_SIZE (4*1024*1024)	//bytes of msgs in the test stream
+#define ASCP_BENCH_PASSES 20
+
+/////////////////////////////////////////////////////////////////////
+// Current receive path, one Read() call per socket read.  The memcpy
+// stands for QTcpSocket::read() into the framer's free space, a read
+// bigger than that space is split the way the socket would return it.
+/////////////////////////////////////////////////////////////////////
+class CInPlaceFramer : public CAscpFramer
+{
+public:
+	CInPlaceFramer(){m_BadLengths = 0;}
+	virtual void ParseAscpMsg(CAscpRxMsg* pMsg) = 0;
+
+	void Read(const quint8* pData, int Len)
+	{
+	int n;
+		while(Len > 0)
+		{
+			n = GetRxFreeLength();
+			if(n > Len)
+				n = Len;
+			memcpy(GetRxFreePtr(), pData, n);
+			pData += n;
+			Len -= n;
+			PutRxData(n);
+		}
+	}
+
+protected:
+	void OnAscpMsg(CAscpRxMsg* pMsg, int Length)
+	{
+	int len = pMsg->GetLength();
+		if( Length != (len ? len : 8192+2) )
+			m_BadLengths++;
+		ParseAscpMsg(pMsg);
+	}
+public:
+	int m_BadLengths;	//msgs passed on with a length not from their header
+};
+
+/////////////////////////////////////////////////////////////////////
+// Old receive path, the socket read went to a stack buffer first
+/////////////////////////////////////////////////////////////////////
+class CByteFramer : public ascpref::CAscpAssembler
+{
+public:
+	void Read(const quint8* pData, int Len)
+	{
+		memcpy(m_ReadBuf, pData, Len);
+		AssembleAscpMsg(m_ReadBuf, Len);
+	}
+private:
+	quint8 m_ReadBuf[50000];
+};
+
+/////////////////////////////////////////////////////////////////////
+// Parser that hashes what it reads.  Full reads every msg byte like
+// the audio and video decoders do, otherwise only the header and the
+// first parameter bytes are read which is the framing cost alone.
+/////////////////////////////////////////////////////////////////////
+template <class Framer>
+class CHashParser : public Framer
+{
+public:
+	CHashParser(bool Full){m_Full = Full; m_Hash = 2166136261u; m_Msgs = 0;}
+	void ParseAscpMsg(CAscpRxMsg* pMsg)
+	{
+	int len;
+		pMsg->InitRxMsg();
+		len = pMsg->GetLength();
+		if(0 == len)
+			len = 8192+2;
+		if(!m_Full && (len > 5))
+			len = 5;
+		for(int i=0; i<len; i++)
+			m_Hash = (m_Hash ^ pMsg->Buf8[i])*16777619u;
+		m_Msgs++;
+	}
+	quint32 m_Hash;
+	int m_Msgs;
+private:
+	bool m_Full;
+};
+
+/////////////////////////////////////////////////////////////////////
+// Fills pBuf with a mix like a receiving server sends: mostly audio
+// data items, spectrum data items, control item responses, NAKs and
+// now and then an 8192 byte data item whose length field is 0.
+// Returns the number of bytes used.
+/////////////////////////////////////////////////////////////////////
+static int MakeAscpStream(quint8* pBuf, int Size)
+{
+CTestRand rand(21);
+int pos = 0;
+int len;
+int type;
+int r;
+	while(1)
+	{
+		r = rand.Range(0, 99);
+		if(r < 60)
+		{	//G726 audio packet
+			type = TYPE_TARG_DATA_ITEM0;
+			len = rand.Range(130, 520);
+		}
+		else if(r < 80)
+		{	//compressed spectrum frame
+			type = TYPE_TARG_DATA_ITEM1;
+			len = rand.Range(600, 2050);
+		}
+		else if(r < 97)
+		{
+			type = TYPE_TARG_RESP_CITEM;
+			len = rand.Range(5, 40);
+		}
+		else if(r < 99)
+		{
+			type = TYPE_TARG_RESP_CITEM;
+			len = 2;
+		}
+		else
+		{
+			type = TYPE_TARG_DATA_ITEM2;
+			len = 8192+2;
+		}
+		if(pos + len > Size)
+			break;
+		pBuf[pos] = len & 0xFF;
+		pBuf[pos+1] = ((len >> 8) & (LENGTH_MASK >> 8)) | type;
+		for(int i=2; i<len; i++)
+			pBuf[pos+i] = (quint8)rand.Next();
+		pos += len;
+	}
+	return pos;
+}
+
+template <class Parser>
+static void FeedStream(Parser& parser, const quint8* pBuf, int Length, int MinRead, int MaxRead, quint32 Seed)
+{
+CTestRand rand(Seed);
+int n;
+	for(int i=0; i<Length; i+=n)
+	{
+		n = rand.Range(MinRead, MaxRead);
+		if(n > Length - i)
+			n = Length - i;
+		parser.Read(&pBuf[i], n);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Both framers must hand the parser the same msgs with the same bytes
+// whatever size pieces the stream arrives in, down to 1 byte reads.
+/////////////////////////////////////////////////////////////////////
+bool TestAscp()
+{
+static quint8 stream[ASCP_STREAM_SIZE];
+static const int Reads[][2] = { {1, 1}, {1, 7}, {1, 1460}, {1460, 1460}, {1, 50000} };
+int len = MakeAscpStream(stream, ASCP_STREAM_SIZE);
+	for(int r=0; r<(int)(sizeof(Reads)/sizeof(Reads[0])); r++)
+	{
+		CHashParser<CByteFramer> old(true);
+		CHashParser<CInPlaceFramer> cur(true);
+		FeedStream(old, stream, len, Reads[r][0], Reads[r][1], r+1);
+		FeedStream(cur, stream, len, Reads[r][0], Reads[r][1], r+1);
+		TEST_CHECK(old.m_Msgs > 0);
+		TEST_CHECK(cur.m_Msgs == old.m_Msgs);
+		TEST_CHECK(cur.m_Hash == old.m_Hash);
+		TEST_CHECK(0 == cur.m_BadLengths);
+	}
+	//a partial msg from a dropped connection must not be joined to the next
+	CHashParser<CInPlaceFramer> fresh(true);
+	CHashParser<CInPlaceFramer> reused(true);
+	reused.Read(stream, 1000);
+	reused.Read(&stream[len/2], 7);
+	reused.ResetRx();
+	reused.m_Hash = fresh.m_Hash;
+	reused.m_Msgs = 0;
+	FeedStream(fresh, stream, len, 1, 1460, 9);
+	FeedStream(reused, stream, len, 1, 1460, 9);
+	TEST_CHECK(reused.m_Msgs == fresh.m_Msgs);
+	TEST_CHECK(reused.m_Hash == fresh.m_Hash);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Receive cost per stream byte for typical socket read
+// sizes, with the parser reading only headers and reading every byte.
+/////////////////////////////////////////////////////////////////////
+bool BenchAscp()
+{
+static quint8 stream[ASCP_STREAM_SIZE];
+static const int Reads[] = { 1460, 16384 };
+static const char* Names[2][2][2] =
+{
+	{ {"ascp old 1460B reads, headers", "ascp new 1460B reads, headers"},
+	  {"ascp old 1460B reads, all bytes", "ascp new 1460B reads, all bytes"} },
+	{ {"ascp old 16K reads, headers", "ascp new 16K reads, headers"},
+	  {"ascp old 16K reads, all bytes", "ascp new 16K reads, all bytes"} }
+};
+int len = MakeAscpStream(stream, ASCP_STREAM_SIZE);
+quint32 check = 0;
+int msgs = 0;
+CBenchTimer timer;
+	for(int r=0; r<2; r++)
+	{
+		for(int full=0; full<2; full++)
+		{
+			CHashParser<CByteFramer> old(full != 0);
+			timer.Restart();
+			for(int p=0; p<ASCP_BENCH_PASSES; p++)
+				FeedStream(old, stream, len, Reads[r], Reads[r], 1);
+			timer.Print(Names[r][full][0], (double)len*ASCP_BENCH_PASSES, "byte");
+			check += old.m_Hash;
+			msgs = old.m_Msgs;
+
+			CHashParser<CInPlaceFramer> cur(full != 0);
+			timer.Restart();
+			for(int p=0; p<ASCP_BENCH_PASSES; p++)
+				FeedStream(cur, stream, len, Reads[r], Reads[r], 1);
+			timer.Print(Names[r][full][1], (double)len*ASCP_BENCH_PASSES, "byte");
+			check += cur.m_Hash;
+		}
+	}
+	printf("  %d msgs, %.0f bytes/msg average (check %08x)\n", msgs/ASCP_BENCH_PASSES,
+			(double)len*ASCP_BENCH_PASSES/msgs, check);
+	return true;
+}
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////
+// tst_fft.cpp: CFft against a direct DFT and FFT benchmark.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "dsp/fft.h"
+#include <math.h>
+#include <string.h>
+
+#define FFT_TEST_MAX 4096		//largest size checked against the DFT
+
+/////////////////////////////////////////////////////////////////////
+// Every power of 2 size up to FFT_TEST_MAX must match a double
+// precision DFT of random input to float accuracy, and sizes that are
+// not a power of 2 must be refused.
+/////////////////////////////////////////////////////////////////////
+bool TestFft()
+{
+static TYPECPX in[FFT_TEST_MAX];
+static TYPECPX buf[FFT_TEST_MAX];
+static CFft fft;
+CTestRand rand(5);
+double re;
+double im;
+double a;
+double err;
+double maxerr = 0.0;
+int N;
+int i;
+int k;
+	TEST_CHECK(!fft.SetSize(0));
+	TEST_CHECK(!fft.SetSize(1000));
+	TEST_CHECK(!fft.SetSize(2*MAX_FFT_SIZE));
+	for(N=2; N<=FFT_TEST_MAX; N*=2)
+	{
+		TEST_CHECK(fft.SetSize(N));
+		for(i=0; i<N; i++)
+		{
+			in[i].re = buf[i].re = rand.Range(-128, 127);
+			in[i].im = buf[i].im = rand.Range(-128, 127);
+		}
+		fft.Forward(buf);
+		for(k=0; k<N; k++)
+		{
+			re = 0.0;
+			im = 0.0;
+			for(i=0; i<N; i++)
+			{
+				a = -K_2PI*(double)((long)i*k % N)/N;
+				re += in[i].re*cos(a) - in[i].im*sin(a);
+				im += in[i].re*sin(a) + in[i].im*cos(a);
+			}
+			//error relative to the full scale output of N*128
+			err = sqrt((buf[k].re - re)*(buf[k].re - re) + (buf[k].im - im)*(buf[k].im - im))/(N*128.0);
+			if(err > maxerr)
+				maxerr = err;
+		}
+	}
+	printf("  sizes 2 to %d, largest error %.2e of full scale\n", FFT_TEST_MAX, maxerr);
+	TEST_CHECK(maxerr < 1e-5);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Time per FFT for the sizes the local spectrum can use, including
+// copying in the input as CIqSpectrum does
+/////////////////////////////////////////////////////////////////////
+bool BenchFft()
+{
+static TYPECPX in[MAX_FFT_SIZE];
+static TYPECPX buf[MAX_FFT_SIZE];
+static CFft fft;
+char name[64];
+float sum = 0.0;
+int loops;
+	for(int N=256; N<=MAX_FFT_SIZE; N*=2)
+	{
+		fft.SetSize(N);
+		for(int i=0; i<N; i++)
+		{
+			in[i].re = (TYPEREAL)(i & 127);
+			in[i].im = 0.0;
+		}
+		loops = 4*1024*1024/N;
+		CBenchTimer timer;
+		for(int i=0; i<loops; i++)
+		{
+			memcpy(buf, in, N*sizeof(TYPECPX));
+			fft.Forward(buf);
+			sum += buf[i & (N-1)].re;
+		}
+		sprintf(name, "%d point FFT", N);
+		timer.Print(name, (double)loops, "FFT");
+	}
+	printf("  (checksum %g)\n", sum);
+	return true;
+}
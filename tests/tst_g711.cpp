@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////
+// tst_g711.cpp: G711 buffer functions against the single value
+// reference functions.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "dsp/G711.h"
+
+#define G711_BENCH_SIZE 8000		//one second of audio per call
+#define G711_BENCH_LOOPS 500
+
+/////////////////////////////////////////////////////////////////////
+// Every 16 bit input is encoded with both laws in one buffer and every
+// 8 bit code is decoded, and all must match the reference exactly.
+/////////////////////////////////////////////////////////////////////
+bool TestG711()
+{
+static int16_t pcm[65536];
+static uint8_t alaw[65536];
+static uint8_t ulaw[65536];
+int16_t out[256];
+uint8_t codes[256];
+G711 g711;
+int i;
+	for(i=0; i<65536; i++)
+		pcm[i] = (int16_t)(i - 32768);
+	TEST_CHECK(g711.ALawEncode(alaw, pcm, sizeof(pcm)) == 65536);
+	TEST_CHECK(g711.ULawEncode(ulaw, pcm, sizeof(pcm)) == 65536);
+	for(i=0; i<65536; i++)
+	{
+		TEST_CHECK(alaw[i] == G711::ALawEncode(pcm[i]));
+		TEST_CHECK(ulaw[i] == G711::ULawEncode(pcm[i]));
+	}
+	for(i=0; i<256; i++)
+		codes[i] = (uint8_t)i;
+	TEST_CHECK(g711.ALawDecode(out, codes, 256) == 512);
+	for(i=0; i<256; i++)
+		TEST_CHECK(out[i] == G711::ALawDecode(codes[i]));
+	TEST_CHECK(g711.ULawDecode(out, codes, 256) == 512);
+	for(i=0; i<256; i++)
+		TEST_CHECK(out[i] == G711::ULawDecode(codes[i]));
+	printf("  65536 encode and 256 decode inputs match for A-Law and u-Law\n");
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Buffer functions compared with a loop over the reference functions
+/////////////////////////////////////////////////////////////////////
+bool BenchG711()
+{
+static int16_t pcm[G711_BENCH_SIZE];
+static uint8_t codes[G711_BENCH_SIZE];
+G711 g711;
+CTestRand rand;
+double units = (double)G711_BENCH_SIZE*G711_BENCH_LOOPS;
+int i;
+int j;
+unsigned int sum = 0;
+	for(i=0; i<G711_BENCH_SIZE; i++)
+		pcm[i] = (int16_t)rand.Range(-32768, 32767);
+	CBenchTimer timer;
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		for(i=0; i<G711_BENCH_SIZE; i++)
+			codes[i] = G711::ULawEncode(pcm[i]);
+		sum += codes[j];
+	}
+	timer.Print("u-Law encode, reference", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		g711.ULawEncode(codes, pcm, sizeof(pcm));
+		sum += codes[j];
+	}
+	timer.Print("u-Law encode, table", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		for(i=0; i<G711_BENCH_SIZE; i++)
+			pcm[i] = (int16_t)G711::ULawDecode(codes[i]);
+		sum += pcm[j];
+	}
+	timer.Print("u-Law decode, reference", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		g711.ULawDecode(pcm, codes, sizeof(codes));
+		sum += pcm[j];
+	}
+	timer.Print("u-Law decode, table", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		for(i=0; i<G711_BENCH_SIZE; i++)
+			codes[i] = G711::ALawEncode(pcm[i]);
+		sum += codes[j];
+	}
+	timer.Print("A-Law encode, reference", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		g711.ALawEncode(codes, pcm, sizeof(pcm));
+		sum += codes[j];
+	}
+	timer.Print("A-Law encode, table", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		for(i=0; i<G711_BENCH_SIZE; i++)
+			pcm[i] = (int16_t)G711::ALawDecode(codes[i]);
+		sum += pcm[j];
+	}
+	timer.Print("A-Law decode, reference", units, "sample");
+	timer.Restart();
+	for(j=0; j<G711_BENCH_LOOPS; j++)
+	{
+		g711.ALawDecode(pcm, codes, sizeof(codes));
+		sum += pcm[j];
+	}
+	timer.Print("A-Law decode, table", units, "sample");
+	printf("  (checksum %u)\n", sum);
+	return true;
+}
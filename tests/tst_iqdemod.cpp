@@ -0,0 +1,378 @@
+//////////////////////////////////////////////////////////////////////
+// tst_iqdemod.cpp: local raw I/Q demod and channelizer tests and
+// benchmarks.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "dsp/iqdemod.h"
+#include "dsp/channelizer.h"
+#include "interface/sdrprotocol.h"
+#include <math.h>
+#include <string.h>
+
+#define SOUND_BUF_SIZE 3000		//MAX_DATAPKT_LENGTH, size of CSdrInterface::m_SoundOutBuf
+#define IQ_PKT_SIZE 3000		//largest raw I/Q packet in bytes
+
+static const int RawRates[] = {500, 1000, 2000, 4000, 8000, 16000};
+#define NUM_RATES (int)(sizeof(RawRates)/sizeof(RawRates[0]))
+
+#define CHAN_FRAMES 400			//channelizer frames measured per tone
+#define CHAN_SETTLE 2*CHANNELIZER_TAPS	//frames before the branch filters are full
+#define CHAN_MAX_LEAK -70.0		//highest allowed neighbour channel level in dB
+#define MODE_RATE 8000			//raw rate for the mode tests, no decimation or interpolation
+#define MODE_SETTLE 2000		//samples skipped while filters and AGC settle
+#define MODE_LENGTH 8000		//samples analyzed, 1 Hz DFT resolution
+
+static void MakeIq(qint8* pBuf, int Length)
+{
+CTestRand rand(11);
+	for(int i=0; i<Length; i++)
+		pBuf[i] = (qint8)rand.Range(-127, 127);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Demodulates MODE_SETTLE + MODE_LENGTH samples of pIq at MODE_RATE
+// and returns the output after the settling time in pOut[].
+/////////////////////////////////////////////////////////////////////
+static bool DemodSignal(int Mode, int LowCut, int HighCut, int Offset, const TYPECPX* pIq, qint16* pOut)
+{
+static qint16 out[MODE_SETTLE + MODE_LENGTH];
+CIqDemod demod;
+	demod.SetSampleRate(MODE_RATE);
+	demod.SetDemodMode(Mode);
+	demod.SetDemodFilter(LowCut, HighCut, Offset);
+	demod.SetAgc(0, 0, 500);	//knee at full scale so the AGC gain is fixed
+	if( (MODE_SETTLE + MODE_LENGTH) != demod.ProcessData(pIq, MODE_SETTLE + MODE_LENGTH, out) )
+		return false;
+	memcpy(pOut, &out[MODE_SETTLE], MODE_LENGTH*sizeof(qint16));
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Returns the amplitude of the Freq Hz component of pBuf[]
+/////////////////////////////////////////////////////////////////////
+static double ToneLevel(const qint16* pBuf, int Freq)
+{
+double re = 0.0;
+double im = 0.0;
+double x;
+	for(int i=0; i<MODE_LENGTH; i++)
+	{
+		x = K_2PI*Freq*i/MODE_RATE;
+		re += pBuf[i]*cos(x);
+		im -= pBuf[i]*sin(x);
+	}
+	return 2.0*sqrt(re*re + im*im)/MODE_LENGTH;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Returns the fraction of the AC power of pBuf[] that is in the
+// Freq Hz tone.
+/////////////////////////////////////////////////////////////////////
+static double TonePurity(const qint16* pBuf, int Freq)
+{
+double mean = 0.0;
+double pwr = 0.0;
+double a = ToneLevel(pBuf, Freq);
+int i;
+	for(i=0; i<MODE_LENGTH; i++)
+		mean += pBuf[i];
+	mean /= MODE_LENGTH;
+	for(i=0; i<MODE_LENGTH; i++)
+		pwr += (pBuf[i] - mean)*(pBuf[i] - mean);
+	pwr /= MODE_LENGTH;
+	if(pwr <= 0.0)
+		return 0.0;
+	return 0.5*a*a/pwr;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Fills pIq[] with a complex tone at Freq Hz and raw byte Amplitude
+/////////////////////////////////////////////////////////////////////
+static void MakeTone(TYPECPX* pIq, int Freq, double Amplitude)
+{
+	for(int i=0; i<MODE_SETTLE + MODE_LENGTH; i++)
+	{
+		pIq[i].re = Amplitude*cos(K_2PI*Freq*i/MODE_RATE);
+		pIq[i].im = Amplitude*sin(K_2PI*Freq*i/MODE_RATE);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Demodulating in pieces of GetMaxInputLength() must never make more
+// samples than the sound buffer holds.  This is how CSdrInterface
+// feeds both whole raw packets and monitored channelizer sub-channels,
+// where a 500sps sub-channel is interpolated 16 times.
+/////////////////////////////////////////////////////////////////////
+bool TestIqDemod()
+{
+static qint8 iq[IQ_PKT_SIZE];
+static qint16 out[SOUND_BUF_SIZE + IQDEMOD_MAX_INTP];	//room to detect an overrun
+static TYPECPX frames[IQ_PKT_SIZE/2 + MAX_CHANNELIZER_SIZE];
+static CChannelizer chan;
+CIqDemod demod;
+int r;
+int N;
+int i;
+int n;
+int len;
+int total;
+int numframes;
+	MakeIq(iq, IQ_PKT_SIZE);
+	for(r=0; r<NUM_RATES; r++)
+	{
+		//whole raw packets
+		demod.SetSampleRate(RawRates[r]);
+		demod.SetDemodMode(DEMOD_MODE_AM);
+		total = 0;
+		for(i=0; i<IQ_PKT_SIZE; i+=len)
+		{
+			len = demod.GetMaxInputLength(SOUND_BUF_SIZE);
+			TEST_CHECK(len > 0);
+			if(len > (IQ_PKT_SIZE - i))
+				len = IQ_PKT_SIZE - i;
+			n = demod.ProcessData(&iq[i], len, out);
+			TEST_CHECK(n <= SOUND_BUF_SIZE);
+			total += n;
+		}
+		TEST_CHECK(total == (IQ_PKT_SIZE/2)*IQDEMOD_OUTRATE/RawRates[r]);
+		//every sub-channel size that can be monitored at this rate
+		for(N=2; (N<=MAX_CHANNELIZER_SIZE) && (RawRates[r]/N >= IQDEMOD_OUTRATE/IQDEMOD_MAX_INTP); N*=2)
+		{
+			TEST_CHECK(chan.Setup(N, RawRates[r]));
+			numframes = chan.ProcessData(iq, IQ_PKT_SIZE, frames);
+			for(i=0; i<numframes; i++)
+				frames[i] = frames[i*N + N/2];
+			demod.SetSampleRate(chan.GetChannelRate());
+			total = 0;
+			for(i=0; i<numframes; i+=len)
+			{
+				len = demod.GetMaxInputLength(SOUND_BUF_SIZE)/2;
+				TEST_CHECK(len > 0);
+				if(len > (numframes - i))
+					len = numframes - i;
+				n = demod.ProcessData(&frames[i], len, out);
+				TEST_CHECK(n <= SOUND_BUF_SIZE);
+				total += n;
+			}
+			TEST_CHECK(total == numframes*IQDEMOD_OUTRATE/chan.GetChannelRate());
+		}
+	}
+	printf("  output fits %d samples at all raw and sub-channel rates\n", SOUND_BUF_SIZE);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// A tone at the center of sub-channel k must come out in channel k,
+// with the neighbouring channels at least CHAN_MAX_LEAK dB below it.
+// Checked for several channel counts and channels at 16Ksps.
+/////////////////////////////////////////////////////////////////////
+bool TestChannelizer()
+{
+static const int Sizes[] = {4, 16, 64, 256};
+static qint8 iq[IQ_PKT_SIZE];
+static TYPECPX frames[IQ_PKT_SIZE/2 + MAX_CHANNELIZER_SIZE];
+static double pwr[MAX_CHANNELIZER_SIZE];
+static CChannelizer chan;
+int s;
+int N;
+int k;
+int c;
+int i;
+int j;
+int n;
+int f;
+int pos;
+int len;
+int frame;
+int peak;
+double x;
+double leak;
+double worst = -1000.0;
+	for(s=0; s<(int)(sizeof(Sizes)/sizeof(Sizes[0])); s++)
+	{
+		N = Sizes[s];
+		for(c=0; c<4; c++)
+		{
+			k = 1 + c*(N-2)/3;		//first to last channel away from the band edge
+			TEST_CHECK(chan.Setup(N, 16000));
+			f = chan.GetChannelOffset(k);
+			for(j=0; j<N; j++)
+				pwr[j] = 0.0;
+			frame = 0;
+			pos = 0;
+			while(frame < CHAN_SETTLE + CHAN_FRAMES)
+			{
+				len = IQ_PKT_SIZE/2;
+				for(i=0; i<len; i++, pos++)
+				{
+					x = K_2PI*(double)f*pos/16000.0;
+					iq[2*i] = (qint8)lrint(100.0*cos(x));
+					iq[2*i+1] = (qint8)lrint(100.0*sin(x));
+				}
+				n = chan.ProcessData(iq, 2*len, frames);
+				for(i=0; (i<n) && (frame < CHAN_SETTLE + CHAN_FRAMES); i++, frame++)
+				{
+					if(frame < CHAN_SETTLE)
+						continue;
+					for(j=0; j<N; j++)
+						pwr[j] += frames[i*N + j].re*frames[i*N + j].re + frames[i*N + j].im*frames[i*N + j].im;
+				}
+			}
+			peak = 0;
+			for(j=1; j<N; j++)
+			{
+				if(pwr[j] > pwr[peak])
+					peak = j;
+			}
+			TEST_CHECK(peak == k);
+			for(j=k-1; j<=k+1; j+=2)
+			{
+				leak = 10.0*log10(pwr[j]/pwr[k] + 1e-20);
+				TEST_CHECK(leak < CHAN_MAX_LEAK);
+				if(leak > worst)
+					worst = leak;
+			}
+		}
+	}
+	printf("  tones land in their channel, worst neighbour %.1f dB\n", worst);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Each detector must recover its signal:
+//  AM and FM recover a 400 Hz modulating tone,
+//  USB and LSB pass a tone in their sideband and reject the same tone
+//	in the opposite one,
+//  CWU turns a carrier 100 Hz above the tuned frequency into a tone at
+//	the 700 Hz offset plus 100 Hz.
+/////////////////////////////////////////////////////////////////////
+bool TestIqDemodModes()
+{
+static TYPECPX iq[MODE_SETTLE + MODE_LENGTH];
+static qint16 out[MODE_LENGTH];
+double pass;
+double stop;
+double x;
+int i;
+	//AM, 50% modulated carrier at the tuned frequency
+	for(i=0; i<MODE_SETTLE + MODE_LENGTH; i++)
+	{
+		iq[i].re = 60.0*(1.0 + 0.5*cos(K_2PI*400*i/MODE_RATE));
+		iq[i].im = 0.0;
+	}
+	TEST_CHECK(DemodSignal(DEMOD_MODE_AM, -3000, 3000, 0, iq, out));
+	TEST_CHECK(ToneLevel(out, 400) > 1000.0);
+	TEST_CHECK(TonePurity(out, 400) > 0.99);
+	printf("  AM 400 Hz tone %.4f of output power\n", TonePurity(out, 400));
+
+	//FM, 1500 Hz deviation
+	for(i=0; i<MODE_SETTLE + MODE_LENGTH; i++)
+	{
+		x = (1500.0/400.0)*sin(K_2PI*400*i/MODE_RATE);
+		iq[i].re = 100.0*cos(x);
+		iq[i].im = 100.0*sin(x);
+	}
+	TEST_CHECK(DemodSignal(DEMOD_MODE_FM, -3000, 3000, 0, iq, out));
+	TEST_CHECK(ToneLevel(out, 400) > 1000.0);
+	TEST_CHECK(TonePurity(out, 400) > 0.99);
+	printf("  FM 400 Hz tone %.4f of output power\n", TonePurity(out, 400));
+
+	//sidebands, the AGC gain is fixed so output levels compare directly
+	MakeTone(iq, 1000, 50.0);
+	TEST_CHECK(DemodSignal(DEMOD_MODE_USB, 100, 3000, 0, iq, out));
+	pass = ToneLevel(out, 1000);
+	TEST_CHECK(TonePurity(out, 1000) > 0.99);
+	TEST_CHECK(DemodSignal(DEMOD_MODE_LSB, -3000, -100, 0, iq, out));
+	stop = ToneLevel(out, 1000);
+	TEST_CHECK(pass > 1000.0);
+	TEST_CHECK(20.0*log10(pass/(stop + 1e-3)) > 60.0);
+	printf("  USB tone level %.0f in USB, %.2f in LSB\n", pass, stop);
+	MakeTone(iq, -1000, 50.0);
+	TEST_CHECK(DemodSignal(DEMOD_MODE_LSB, -3000, -100, 0, iq, out));
+	pass = ToneLevel(out, 1000);
+	TEST_CHECK(TonePurity(out, 1000) > 0.99);
+	TEST_CHECK(DemodSignal(DEMOD_MODE_USB, 100, 3000, 0, iq, out));
+	stop = ToneLevel(out, 1000);
+	TEST_CHECK(pass > 1000.0);
+	TEST_CHECK(20.0*log10(pass/(stop + 1e-3)) > 60.0);
+	printf("  LSB tone level %.0f in LSB, %.2f in USB\n", pass, stop);
+
+	//CW carrier 100 Hz above the tuned frequency
+	MakeTone(iq, 100, 50.0);
+	TEST_CHECK(DemodSignal(DEMOD_MODE_CWU, -250, 250, 700, iq, out));
+	TEST_CHECK(ToneLevel(out, 800) > 1000.0);
+	TEST_CHECK(TonePurity(out, 800) > 0.99);
+	printf("  CWU 700 Hz offset, carrier +100 Hz gives 800 Hz tone %.4f of output power\n",
+			TonePurity(out, 800));
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Channelizer time per raw I/Q sample for each number of channels at
+// the highest raw rate.
+/////////////////////////////////////////////////////////////////////
+bool BenchChannelizer()
+{
+static qint8 iq[IQ_PKT_SIZE];
+static TYPECPX frames[IQ_PKT_SIZE/2 + MAX_CHANNELIZER_SIZE];
+static CChannelizer chan;
+int loops = 2000;
+char name[64];
+float sum = 0.0;
+	MakeIq(iq, IQ_PKT_SIZE);
+	for(int N=2; N<=MAX_CHANNELIZER_SIZE; N*=2)
+	{
+		chan.Setup(N, 16000);
+		CBenchTimer timer;
+		for(int i=0; i<loops; i++)
+			sum += frames[chan.ProcessData(iq, IQ_PKT_SIZE, frames) - 1].re;
+		sprintf(name, "%d channels", N);
+		timer.Print(name, (double)loops*IQ_PKT_SIZE/2, "sample");
+	}
+	printf("  (checksum %g)\n", sum);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Local demod time per raw I/Q sample for each detector at the
+// highest and lowest raw rates, also shown as percent of one core.
+/////////////////////////////////////////////////////////////////////
+bool BenchIqDemod()
+{
+static const int Modes[] = {DEMOD_MODE_USB, DEMOD_MODE_CWU, DEMOD_MODE_AM, DEMOD_MODE_SAM, DEMOD_MODE_FM};
+static const char* ModeNames[] = {"USB", "CWU", "AM", "SAM", "FM"};
+static const int Rates[] = {16000, 500};
+static qint8 iq[IQ_PKT_SIZE];
+static qint16 out[SOUND_BUF_SIZE];
+CIqDemod demod;
+int loops;
+int len;
+int sum = 0;
+char name[64];
+double nsec;
+	MakeIq(iq, IQ_PKT_SIZE);
+	for(int r=0; r<2; r++)
+	{
+		loops = Rates[r]/10;	//about 100 seconds of I/Q
+		for(int m=0; m<5; m++)
+		{
+			demod.SetSampleRate(Rates[r]);
+			demod.SetDemodMode(Modes[m]);
+			demod.SetDemodFilter(-2500, 2500, 700);
+			len = demod.GetMaxInputLength(SOUND_BUF_SIZE);
+			if(len > IQ_PKT_SIZE)
+				len = IQ_PKT_SIZE;
+			CBenchTimer timer;
+			for(int i=0; i<loops*IQ_PKT_SIZE/len; i++)
+				sum += out[demod.ProcessData(iq, len, out) - 1];
+			nsec = timer.GetNsec()/((double)(loops*IQ_PKT_SIZE/len)*len/2);
+			sprintf(name, "%s at %d sps (%.3f%% CPU)", ModeNames[m], Rates[r], nsec*Rates[r]*1e-7);
+			printf("  %-36s %10.2f nSec/sample\n", name, nsec);
+		}
+	}
+	printf("  (checksum %d)\n", sum);
+	return true;
+}
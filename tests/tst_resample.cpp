@@ -0,0 +1,227 @@
+//////////////////////////////////////////////////////////////////////
+// tst_resample.cpp: sound card rate conversion tests and benchmarks.
+//
+//  The 8K to 48K interpolator is checked against a direct double
+// precision convolution of the zero stuffed input with the cascaded
+// x2 and x3 filters.  The 48K to 8K decimator is checked against the
+// old half band and decimate by 3 cascade.  Both are timed against
+// the old filters in ref/SoundRef.h.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "dsp/interpolatex6.h"
+#include "dsp/decimateby6.h"
+#include "ref/SoundRef.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define RESAMP_TEST_LENGTH 4000		//input samples, 0.5 seconds at 8K
+#define RESAMP_BENCH_BLOCK 160		//20 mSec of 8K audio, one G726 packet
+#define RESAMP_BENCH_PASSES 2000		//per timed run
+#define DEC_TEST_LENGTH 48000		//input samples, 1 second at 48K
+#define DEC_BENCH_BLOCK 960			//20 mSec of 48K soundcard input
+#define DEC_BENCH_PASSES 500
+#define RESAMP_BENCH_RUNS 10		//fastest of this many runs is reported
+
+/////////////////////////////////////////////////////////////////////
+// Output y[m] of the zero stuffed by 6 input filtered with the x2
+// filter upsampled by 3 convolved with the x3 filter.
+/////////////////////////////////////////////////////////////////////
+static void RefInterpolateX6(const float* pIn, double* pOut, int n)
+{
+double h[INTP6_FIR_SIZE];
+int j;
+	for(j=0; j<INTP6_FIR_SIZE; j++)
+		h[j] = 0.0;
+	for(int i=0; i<INTP2_FIR_SIZE; i++)
+		for(j=0; j<INTP3_FIR_SIZE; j++)
+			h[i*INTP3_VALUE + j] += (double)X2IntrpFIRCoef[i]*(double)X3IntrpFIRCoef[j];
+	for(int m=0; m<n*INTP6_VALUE; m++)
+	{
+		pOut[m] = 0.0;
+		for(j=m%INTP6_VALUE; (j<INTP6_FIR_SIZE) && (j<=m); j+=INTP6_VALUE)
+			pOut[m] += pIn[(m-j)/INTP6_VALUE]*h[j];
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Output must match the direct convolution whatever size pieces the
+// input arrives in, including pieces longer than one internal block.
+/////////////////////////////////////////////////////////////////////
+bool TestInterpolateX6()
+{
+static float in[RESAMP_TEST_LENGTH];
+static float out[RESAMP_TEST_LENGTH*INTP6_VALUE];
+static double ref[RESAMP_TEST_LENGTH*INTP6_VALUE];
+static const int Pieces[][2] = { {1, 1}, {1, 13}, {160, 160}, {1, 700} };
+CTestRand rand(5);
+CInterpolateX6 intp;
+CInterpolateX6 copy;
+double err;
+int pos;
+int n;
+	for(int i=0; i<RESAMP_TEST_LENGTH; i++)
+		in[i] = (float)rand.Range(-20000, 20000);
+	RefInterpolateX6(in, ref, RESAMP_TEST_LENGTH);
+	for(int r=0; r<(int)(sizeof(Pieces)/sizeof(Pieces[0])); r++)
+	{
+		intp.Reset();
+		pos = 0;
+		for(int i=0; i<RESAMP_TEST_LENGTH; i+=n)
+		{
+			n = rand.Range(Pieces[r][0], Pieces[r][1]);
+			if(n > RESAMP_TEST_LENGTH - i)
+				n = RESAMP_TEST_LENGTH - i;
+			TEST_CHECK(intp.ProcessData(&in[i], &out[pos], n) == n*INTP6_VALUE);
+			pos += n*INTP6_VALUE;
+		}
+		TEST_CHECK(pos == RESAMP_TEST_LENGTH*INTP6_VALUE);
+		err = 0.0;
+		for(int m=0; m<pos; m++)
+			err = fmax(err, fabs(out[m] - ref[m]));
+		TEST_CHECK(err < 0.05);
+	}
+	//a copy of the history continues exactly where the source left off
+	intp.Reset();
+	intp.ProcessData(in, out, 100);
+	copy.CopyHistory(intp);
+	copy.ProcessData(&in[100], &out[100*INTP6_VALUE], 100);
+	for(int m=0; m<200*INTP6_VALUE; m++)
+		TEST_CHECK(fabs(out[m] - ref[m]) < 0.05);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Cost per 8K input sample in 160 sample packets, old cascade with
+// qint16 samples and the combined polyphase filter with floats.
+/////////////////////////////////////////////////////////////////////
+bool BenchInterpolateX6()
+{
+static qint16 in16[RESAMP_BENCH_BLOCK];
+static qint16 out16[RESAMP_BENCH_BLOCK*INTP6_VALUE];
+static float in[RESAMP_BENCH_BLOCK];
+static float out[RESAMP_BENCH_BLOCK*INTP6_VALUE];
+CTestRand rand(9);
+soundref::CInterpolateX6 old;
+CInterpolateX6 cur;
+CBenchTimer timer;
+double check = 0.0;
+	for(int i=0; i<RESAMP_BENCH_BLOCK; i++)
+	{
+		in16[i] = (qint16)rand.Range(-20000, 20000);
+		in[i] = in16[i];
+	}
+	timer.Restart();
+	for(int r=0; r<RESAMP_BENCH_RUNS; r++)
+	{
+		for(int p=0; p<RESAMP_BENCH_PASSES; p++)
+		{
+			old.InterpolateX6(in16, out16, RESAMP_BENCH_BLOCK);
+			check += out16[p%RESAMP_BENCH_BLOCK];
+		}
+		timer.EndRun();
+	}
+	timer.Print("interpolate x6 old", (double)RESAMP_BENCH_BLOCK*RESAMP_BENCH_PASSES, "input sample");
+	timer.Restart();
+	for(int r=0; r<RESAMP_BENCH_RUNS; r++)
+	{
+		for(int p=0; p<RESAMP_BENCH_PASSES; p++)
+		{
+			cur.ProcessData(in, out, RESAMP_BENCH_BLOCK);
+			check += out[p%RESAMP_BENCH_BLOCK];
+		}
+		timer.EndRun();
+	}
+	timer.Print("interpolate x6 new", (double)RESAMP_BENCH_BLOCK*RESAMP_BENCH_PASSES, "input sample");
+	printf("  (check %.0f)\n", check);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Output must be within 1 LSB of the old cascade, which needs even
+// reads of at least DEC2TAP_LENGTH samples, and must not depend on
+// read size for reads of any length.
+/////////////////////////////////////////////////////////////////////
+bool TestDecimateBy6()
+{
+static qint16 in[DEC_TEST_LENGTH];
+static qint16 ref[DEC_TEST_LENGTH/DEC6_VALUE];
+static qint16 out[DEC_TEST_LENGTH/DEC6_VALUE];
+static qint16 out2[DEC_TEST_LENGTH/DEC6_VALUE];
+CTestRand rand(7);
+soundref::CDecimateBy6 old;
+CDecimateBy6 cur;
+int nref = 0;
+int nout = 0;
+int n;
+double ph = 0.0;
+	//tones in and out of the passband plus noise, within 16 bits after filtering
+	for(int i=0; i<DEC_TEST_LENGTH; i++)
+	{
+		in[i] = (qint16)(8000.0*sin(ph) + 6000.0*sin(ph*7.3) + rand.Range(-4000, 4000));
+		ph += 6.283185307*1000.0/48000.0;
+	}
+	for(int i=0; i<DEC_TEST_LENGTH; i+=n)
+	{
+		n = 2*rand.Range(DEC2TAP_LENGTH/2+1, 2000);
+		if(n > DEC_TEST_LENGTH - i)
+			n = DEC_TEST_LENGTH - i;
+		nref += old.DecBy6(n, &in[i], &ref[nref]);
+		nout += cur.ProcessData(n, &in[i], &out[nout]);
+	}
+	TEST_CHECK(nref == DEC_TEST_LENGTH/DEC6_VALUE);
+	TEST_CHECK(nout == nref);
+	for(int i=0; i<nout; i++)
+		TEST_CHECK(abs(out[i] - ref[i]) <= 1);
+	//odd and single sample reads and reads longer than one block
+	cur.Reset();
+	nout = 0;
+	for(int i=0; i<DEC_TEST_LENGTH; i+=n)
+	{
+		n = (i < DEC_TEST_LENGTH/2) ? rand.Range(1, 11) : rand.Range(1, 3*DEC6_BLOCK);
+		if(n > DEC_TEST_LENGTH - i)
+			n = DEC_TEST_LENGTH - i;
+		nout += cur.ProcessData(n, &in[i], &out2[nout]);
+	}
+	TEST_CHECK(nout == nref);
+	for(int i=0; i<nout; i++)
+		TEST_CHECK(out2[i] == out[i]);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Cost per 48K input sample in 20 mSec reads, old two stage cascade
+// and the combined filter that only calculates kept outputs.
+/////////////////////////////////////////////////////////////////////
+bool BenchDecimateBy6()
+{
+static qint16 in[DEC_BENCH_BLOCK];
+static qint16 out[DEC_BENCH_BLOCK];
+CTestRand rand(11);
+soundref::CDecimateBy6 old;
+CDecimateBy6 cur;
+CBenchTimer timer;
+int check = 0;
+	for(int i=0; i<DEC_BENCH_BLOCK; i++)
+		in[i] = (qint16)rand.Range(-10000, 10000);
+	timer.Restart();
+	for(int r=0; r<RESAMP_BENCH_RUNS; r++)
+	{
+		for(int p=0; p<DEC_BENCH_PASSES; p++)
+			check += old.DecBy6(DEC_BENCH_BLOCK, in, out) + out[p%(DEC_BENCH_BLOCK/DEC6_VALUE)];
+		timer.EndRun();
+	}
+	timer.Print("decimate by 6 old", (double)DEC_BENCH_BLOCK*DEC_BENCH_PASSES, "input sample");
+	timer.Restart();
+	for(int r=0; r<RESAMP_BENCH_RUNS; r++)
+	{
+		for(int p=0; p<DEC_BENCH_PASSES; p++)
+			check += cur.ProcessData(DEC_BENCH_BLOCK, in, out) + out[p%(DEC_BENCH_BLOCK/DEC6_VALUE)];
+		timer.EndRun();
+	}
+	timer.Print("decimate by 6 new", (double)DEC_BENCH_BLOCK*DEC_BENCH_PASSES, "input sample");
+	printf("  (check %d)\n", check);
+	return true;
+}
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////
+// tst_spscring.cpp: CSpscRing test with a real producer and consumer
+// thread and Put/Get cost as seen by the network thread.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "spscring.h"
+#include <thread>
+
+#define RING_TEST_SIZE 4096
+#define RING_TEST_BYTES (16*1024*1024)
+
+/////////////////////////////////////////////////////////////////////
+// Producer puts messages of random length holding a running byte
+// count while the consumer gets random length pieces.  The consumer
+// must see every byte once and in order, and a failed Put() must not
+// have put anything.
+/////////////////////////////////////////////////////////////////////
+bool TestSpscRing()
+{
+CSpscRing ring(RING_TEST_SIZE);
+int errors = 0;
+int full = 0;
+	std::thread consumer([&ring, &errors]()
+	{
+		char buf[700];
+		quint32 count = 0;
+		CTestRand rand(9);
+		int n;
+		while(count < RING_TEST_BYTES)
+		{
+			n = ring.Get(buf, rand.Range(1, sizeof(buf)));
+			if(0 == n)
+				std::this_thread::yield();
+			for(int i=0; i<n; i++, count++)
+			{
+				if(buf[i] != (char)(count*7))
+					errors++;
+			}
+		}
+	});
+	char msg[1100];
+	quint32 count = 0;
+	int len;
+	CTestRand rand(4);
+	while(count < RING_TEST_BYTES)
+	{
+		len = rand.Range(1, sizeof(msg));
+		if(len > (int)(RING_TEST_BYTES - count))
+			len = RING_TEST_BYTES - count;
+		for(int i=0; i<len; i++)
+			msg[i] = (char)((count + i)*7);
+		if(ring.Put(msg, len))
+			count += len;
+		else
+		{
+			full++;
+			std::this_thread::yield();
+		}
+	}
+	consumer.join();
+	printf("  %d MBytes through a %d byte ring, %d full Put() retries\n",
+			RING_TEST_BYTES/(1024*1024), RING_TEST_SIZE, full);
+	TEST_CHECK(0 == errors);
+	TEST_CHECK(0 == ring.Available());
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Time to Put() one 1000 byte raw I/Q packet and one 8Ksps audio
+// packet, the work the recorders add to the network thread, with the
+// writer Get()ing in large blocks as the recorder threads do.
+/////////////////////////////////////////////////////////////////////
+bool BenchSpscRing()
+{
+static char block[256*1024];
+static const int PktSizes[] = {1000, 8 + 2*256};
+static const char* PktNames[] = {"Put 1000 byte I/Q packet", "Put 256 sample audio packet"};
+CSpscRing ring(4*1024*1024);
+char pkt[1000];
+int loops = 200000;
+int sum = 0;
+	memset(pkt, 1, sizeof(pkt));
+	for(int p=0; p<2; p++)
+	{
+		CBenchTimer timer;
+		for(int i=0; i<loops; i++)
+		{
+			ring.Put(pkt, PktSizes[p]);
+			if(ring.Available() >= (int)sizeof(block))
+				sum += ring.Get(block, sizeof(block));
+		}
+		timer.Print(PktNames[p], loops, "packet");
+	}
+	printf("  (checksum %d)\n", sum);
+	return true;
+}
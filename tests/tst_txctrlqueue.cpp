@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////
+// tst_txctrlqueue.cpp: CTxCtrlQueue ordering and setting collapse test.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "interface/ascpmsg.h"
+#include "txctrlqueue.h"
+#include <string.h>
+
+#define CI_TEST_FREQ 0x0020
+#define CI_TEST_GAIN 0x0038
+#define CI_TEST_STATE 0x0018
+
+/////////////////////////////////////////////////////////////////////
+// Builds an ASCP msg with a channel byte and one data byte that tags
+// it so the gathered order can be checked.
+/////////////////////////////////////////////////////////////////////
+static int MakeMsg(char* pBuf, quint8 Type, quint16 CItem, quint8 Chan, quint8 Tag)
+{
+	pBuf[0] = 6;
+	pBuf[1] = Type;
+	pBuf[2] = CItem&0xFF;
+	pBuf[3] = CItem>>8;
+	pBuf[4] = Chan;
+	pBuf[5] = Tag;
+	return 6;
+}
+
+static bool PutSetting(CTxCtrlQueue& q, quint16 CItem, quint8 Chan, quint8 Tag)
+{
+char msg[8];
+	return q.PutSetting(msg, MakeMsg(msg, TYPE_HOST_SET_CITEM, CItem, Chan, Tag));
+}
+
+static bool PutMsg(CTxCtrlQueue& q, quint8 Type, quint16 CItem, quint8 Tag)
+{
+char msg[8];
+	return q.PutMsg(msg, MakeMsg(msg, Type, CItem, 0, Tag));
+}
+
+/////////////////////////////////////////////////////////////////////
+// Gathers and returns the tag bytes of the msgs in order
+/////////////////////////////////////////////////////////////////////
+static int GatherTags(CTxCtrlQueue& q, bool Hold, char* pTags, int& Msgs, int& Collapsed)
+{
+static char buf[TXCTRL_GATHER_SIZE];
+int length = q.Gather(buf, Hold, Msgs, Collapsed);
+int n = 0;
+	for(int i=0; i<length; i+=6)
+		pTags[n++] = buf[i+5];
+	pTags[n] = 0;
+	return n;
+}
+
+bool TestTxCtrlQueue()
+{
+CTxCtrlQueue q;
+char tags[TXCTRL_GATHER_SIZE];
+int msgs;
+int collapsed;
+int n;
+	//settings and control msgs go out in the order they were put and a
+	//setting is only replaced by a newer value put before the next control msg
+	PutSetting(q, CI_TEST_FREQ, 0, 'a');
+	PutSetting(q, CI_TEST_GAIN, 0, 'b');
+	PutSetting(q, CI_TEST_FREQ, 0, 'c');
+	PutSetting(q, CI_TEST_FREQ, 1, 'd');
+	PutMsg(q, TYPE_HOST_REQ_CITEM, CI_TEST_STATE, 'e');
+	PutSetting(q, CI_TEST_FREQ, 0, 'f');
+	PutSetting(q, CI_TEST_FREQ, 0, 'g');
+	GatherTags(q, false, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "bcdeg"));
+	TEST_CHECK(5 == msgs);
+	TEST_CHECK(2 == collapsed);
+
+	//values the server already has are not sent again
+	PutSetting(q, CI_TEST_GAIN, 0, 'b');
+	PutSetting(q, CI_TEST_FREQ, 0, 'g');
+	PutSetting(q, CI_TEST_FREQ, 1, 'h');
+	n = GatherTags(q, false, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "h"));
+	TEST_CHECK(1 == msgs);
+	TEST_CHECK(2 == collapsed);
+	TEST_CHECK(1 == n);
+
+	//a control msg that sets server state makes the next settings go out
+	PutMsg(q, TYPE_HOST_SET_CITEM, CI_TEST_STATE, 'i');
+	PutSetting(q, CI_TEST_GAIN, 0, 'b');
+	GatherTags(q, false, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "ib"));
+	TEST_CHECK(0 == collapsed);
+
+	//held settings stay pending with everything put after them and keep collapsing
+	PutMsg(q, TYPE_HOST_REQ_CITEM, CI_TEST_STATE, 'j');
+	PutSetting(q, CI_TEST_FREQ, 0, 'k');
+	PutMsg(q, TYPE_HOST_REQ_CITEM, CI_TEST_STATE, 'l');
+	GatherTags(q, true, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "j"));
+	TEST_CHECK(1 == msgs);
+	PutSetting(q, CI_TEST_GAIN, 0, 'm');
+	PutSetting(q, CI_TEST_GAIN, 0, 'n');
+	GatherTags(q, true, tags, msgs, collapsed);
+	TEST_CHECK(0 == tags[0]);
+	GatherTags(q, false, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "kln"));
+	TEST_CHECK(3 == msgs);
+	TEST_CHECK(1 == collapsed);
+
+	//a full queue drops the msg, gathering makes room again
+	for(n=0; PutSetting(q, CI_TEST_FREQ, 0, 'o'); n++)
+		;
+	TEST_CHECK(n == TXQ_SIZE/7);
+	TEST_CHECK(!PutMsg(q, TYPE_HOST_REQ_CITEM, CI_TEST_STATE, 'p'));
+	GatherTags(q, false, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "o"));
+	TEST_CHECK(n-1 == collapsed);
+	TEST_CHECK(PutMsg(q, TYPE_HOST_REQ_CITEM, CI_TEST_STATE, 'p'));
+
+	//reset throws away what is queued and forgets what was sent
+	PutSetting(q, CI_TEST_GAIN, 0, 'q');
+	q.Reset();
+	PutSetting(q, CI_TEST_FREQ, 0, 'o');
+	GatherTags(q, false, tags, msgs, collapsed);
+	TEST_CHECK(0 == strcmp(tags, "o"));
+	return true;
+}
@@ -0,0 +1,290 @@
+//////////////////////////////////////////////////////////////////////
+// tst_vectorops.cpp: vector ops and CFir tests and benchmarks.
+//
+//  Every vector op set the CPU supports is checked against the plain
+// C set, and CFir is checked with each set against the scalar loops
+// in ref/FirRef.h.  The benchmarks time VecDot() per set and the
+// old and current CFir::ProcessFilter().
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include "dsp/vectorops.h"
+#include "dsp/fir.h"
+#include "ref/FirRef.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define VEC_MAX_SETS 4
+#define VEC_TEST_LENGTH 300
+#define FIR_TEST_LENGTH 4000
+#define FIR_BENCH_BLOCK 160		//one 20 mSec G726 packet of 8K audio
+#define FIR_BENCH_PASSES 500		//per timed run
+#define FIR_BENCH_RUNS 10			//fastest of this many runs is reported
+#define DOT_BENCH_CALLS 1000000
+
+/////////////////////////////////////////////////////////////////////
+// Designs the post filter CRxChannel uses for a 3kHz demod filter, or
+// one forced to NumTaps, and copies its taps into the reference filter
+// from its impulse response.
+/////////////////////////////////////////////////////////////////////
+static int MakeFirPair(CFir& fir, firref::CFir& ref, int NumTaps = 0)
+{
+TYPEREAL imp[MAX_NUMCOEF];
+TYPEREAL h[MAX_NUMCOEF];
+int taps = fir.CreateLPFilter(NumTaps, 1.0, 50.0, 2800.0, 3000.0, 0.0, 8000.0);
+	for(int i=0; i<MAX_NUMCOEF; i++)
+		imp[i] = (0 == i) ? 1.0 : 0.0;
+	fir.ProcessFilter(MAX_NUMCOEF, imp, h);
+	ref.SetCoef(h, taps);
+	fir.CreateLPFilter(NumTaps, 1.0, 50.0, 2800.0, 3000.0, 0.0, 8000.0);	//clear history
+	return taps;
+}
+
+//values exactly halfway between integers and the 16 bit result
+//rounding to even gives, followed by out of range values
+static const float HalfwayIn[] = { 0.5, 1.5, 2.5, -0.5, -1.5, -2.5, 32766.5, -32767.5,
+							32767.5, -32768.5, 40000.0, -40000.0, 1e9, -1e9 };
+static const qint16 HalfwayOut[] = { 0, 2, 2, 0, -2, -2, 32766, -32768,
+							32767, -32768, 32767, -32768, 32767, -32768 };
+#define NUM_HALFWAY ((int)(sizeof(HalfwayIn)/sizeof(HalfwayIn[0])))
+
+/////////////////////////////////////////////////////////////////////
+// Dot products of every length up to a few SIMD widths past the
+// unrolled loop must match a double sum.  Conversions must match the
+// C set exactly, and halfway values must round to even in both the
+// SIMD loop and the tail of every set.
+/////////////////////////////////////////////////////////////////////
+bool TestVectorOps()
+{
+static float a[VEC_TEST_LENGTH];
+static float b[VEC_TEST_LENGTH];
+static float f[VEC_TEST_LENGTH];
+static float fc[VEC_TEST_LENGTH];
+static qint16 s[VEC_TEST_LENGTH];
+static qint16 sc[VEC_TEST_LENGTH];
+static qint8 s8[VEC_TEST_LENGTH];
+const tVectorOps* sets[VEC_MAX_SETS];
+int nsets = GetVectorOpsSets(sets, VEC_MAX_SETS);
+CTestRand rand(3);
+double ref;
+double mag;
+int r;
+	TEST_CHECK(nsets >= 1);
+	TEST_CHECK(sets[nsets-1] == g_pVectorOps);
+	for(int i=0; i<VEC_TEST_LENGTH; i++)
+	{
+		a[i] = (float)rand.Range(-100000, 100000)/1000.0;
+		b[i] = (float)rand.Range(-100000, 100000)/1000.0;
+		s[i] = (qint16)rand.Range(-32768, 32767);
+		s8[i] = (qint8)rand.Range(-128, 127);
+	}
+	for(int k=0; k<nsets; k++)
+	{
+		printf("  %s\n", sets[k]->Name);
+		for(int len=0; len<=70; len++)
+		{
+			ref = 0.0;
+			mag = 0.0;
+			for(int i=0; i<len; i++)
+			{
+				ref += (double)a[i]*b[i];
+				mag += fabs((double)a[i]*b[i]);
+			}
+			TEST_CHECK(fabs(sets[k]->Dot(a, b, len) - ref) <= 1e-5*mag + 1e-6);
+		}
+		sets[0]->S16ToFloat(s, fc, VEC_TEST_LENGTH);
+		sets[k]->S16ToFloat(s, f, VEC_TEST_LENGTH-3);
+		for(int i=0; i<VEC_TEST_LENGTH-3; i++)
+			TEST_CHECK(f[i] == fc[i]);
+		sets[0]->S8ToFloat(s8, fc, VEC_TEST_LENGTH);
+		sets[k]->S8ToFloat(s8, f, VEC_TEST_LENGTH-5);
+		for(int i=0; i<VEC_TEST_LENGTH-5; i++)
+			TEST_CHECK(f[i] == fc[i]);
+		for(int i=0; i<VEC_TEST_LENGTH; i++)
+		{	//includes out of range values and fractions of .5
+			r = rand.Range(0, 3);
+			f[i] = (float)rand.Range(-40000, 40000) + (float)r*0.25;
+		}
+		sets[0]->FloatToS16(f, sc, VEC_TEST_LENGTH);
+		sets[k]->FloatToS16(f, s, VEC_TEST_LENGTH-7);
+		for(int i=0; i<VEC_TEST_LENGTH-7; i++)
+			TEST_CHECK(s[i] == sc[i]);
+		for(int len=NUM_HALFWAY; len<NUM_HALFWAY+8; len++)
+		{	//halfway values at every position of the SIMD loop and the tail
+			for(int i=0; i<len; i++)
+				f[i] = HalfwayIn[(i + len) % NUM_HALFWAY];
+			sets[k]->FloatToS16(f, s, len);
+			for(int i=0; i<len; i++)
+				TEST_CHECK(s[i] == HalfwayOut[(i + len) % NUM_HALFWAY]);
+		}
+	}
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// With every vector op set, for the post filter and a filter short
+// enough to skip VecDot(), the float filter must match the scalar
+// loop and the 16 bit filter must be within 1 LSB of it, the scalar
+// loop truncates and CFir rounds.  The input is fed in uneven pieces
+// so the block conversion in the 16 bit version is crossed.
+/////////////////////////////////////////////////////////////////////
+bool TestFir()
+{
+static TYPEREAL in[FIR_TEST_LENGTH];
+static TYPEREAL out[FIR_TEST_LENGTH];
+static TYPEREAL refout[FIR_TEST_LENGTH];
+static qint16 in16[FIR_TEST_LENGTH];
+static qint16 out16[FIR_TEST_LENGTH];
+static qint16 refout16[FIR_TEST_LENGTH];
+const tVectorOps* sets[VEC_MAX_SETS];
+int nsets = GetVectorOpsSets(sets, VEC_MAX_SETS);
+const tVectorOps* selected = g_pVectorOps;
+static const int TestTaps[] = { 0, 16 };	//demod post filter, short filter done inline
+CTestRand rand(17);
+int n;
+	for(int i=0; i<FIR_TEST_LENGTH; i++)
+	{
+		in16[i] = (qint16)rand.Range(-20000, 20000);
+		in[i] = in16[i];
+	}
+	for(int t=0; t<(int)(sizeof(TestTaps)/sizeof(TestTaps[0])); t++)
+	{
+		for(int k=0; k<nsets; k++)
+		{
+			g_pVectorOps = sets[k];
+			CFir fir;
+			firref::CFir ref;
+			TEST_CHECK(MakeFirPair(fir, ref, TestTaps[t]) >= (TestTaps[t] ? TestTaps[t] : 100));
+			for(int i=0; i<FIR_TEST_LENGTH; i+=n)
+			{
+				n = rand.Range(1, 700);
+				if(n > FIR_TEST_LENGTH - i)
+					n = FIR_TEST_LENGTH - i;
+				fir.ProcessFilter(n, &in[i], &out[i]);
+				ref.ProcessFilter(n, &in[i], &refout[i]);
+			}
+			for(int i=0; i<FIR_TEST_LENGTH; i++)
+				TEST_CHECK(fabs(out[i] - refout[i]) < 0.02);
+
+			MakeFirPair(fir, ref, TestTaps[t]);
+			for(int i=0; i<FIR_TEST_LENGTH; i+=n)
+			{
+				n = rand.Range(1, 700);
+				if(n > FIR_TEST_LENGTH - i)
+					n = FIR_TEST_LENGTH - i;
+				fir.ProcessFilter(n, &in16[i], &out16[i]);
+				ref.ProcessFilter(n, &in16[i], &refout16[i]);
+			}
+			for(int i=0; i<FIR_TEST_LENGTH; i++)
+				TEST_CHECK(abs(out16[i] - refout16[i]) <= 1);
+		}
+	}
+	g_pVectorOps = selected;
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Cost of one dot product per set over the range of CFir lengths,
+// up to MAX_NUMCOEF.  125 also times the tail loops.
+/////////////////////////////////////////////////////////////////////
+bool BenchVecDot()
+{
+static float a[MAX_NUMCOEF];
+static float b[MAX_NUMCOEF+3];		//calls start up to 3 floats in to vary alignment
+static const int Lengths[] = { 8, 16, 32, 64, MAX_NUMCOEF };
+const tVectorOps* sets[VEC_MAX_SETS];
+int nsets = GetVectorOpsSets(sets, VEC_MAX_SETS);
+CTestRand rand(23);
+CBenchTimer timer;
+char name[64];
+float check = 0.0;
+	for(int i=0; i<MAX_NUMCOEF+3; i++)
+	{
+		a[i%MAX_NUMCOEF] = (float)rand.Range(-1000, 1000)/1000.0;
+		b[i] = (float)rand.Range(-1000, 1000)/1000.0;
+	}
+	for(int l=0; l<(int)(sizeof(Lengths)/sizeof(Lengths[0])); l++)
+	{
+		for(int k=0; k<nsets; k++)
+		{
+			timer.Restart();
+			for(int c=0; c<DOT_BENCH_CALLS; c++)
+				check += sets[k]->Dot(a, &b[c&3], Lengths[l]);
+			sprintf(name, "dot %d taps %s", Lengths[l], sets[k]->Name);
+			timer.Print(name, (double)DOT_BENCH_CALLS, "call");
+		}
+	}
+	printf("  (check %g)\n", check);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Cost per 8K sample of the post filter with the scalar loops and
+// with CFir run through each vector op set, for a sweep of tap counts.
+/////////////////////////////////////////////////////////////////////
+bool BenchFir()
+{
+static TYPEREAL in[FIR_BENCH_BLOCK];
+static TYPEREAL out[FIR_BENCH_BLOCK];
+static qint16 in16[FIR_BENCH_BLOCK];
+static qint16 out16[FIR_BENCH_BLOCK];
+static const int Taps[] = { 8, 16, 32, 64, MAX_NUMCOEF };
+const tVectorOps* sets[VEC_MAX_SETS];
+int nsets = GetVectorOpsSets(sets, VEC_MAX_SETS);
+const tVectorOps* selected = g_pVectorOps;
+CTestRand rand(29);
+CBenchTimer timer;
+char name[64];
+double check = 0.0;
+	for(int i=0; i<FIR_BENCH_BLOCK; i++)
+	{
+		in16[i] = (qint16)rand.Range(-20000, 20000);
+		in[i] = in16[i];
+	}
+	for(int t=0; t<(int)(sizeof(Taps)/sizeof(Taps[0])); t++)
+	{
+		CFir fir;
+		firref::CFir ref;
+		MakeFirPair(fir, ref, Taps[t]);
+		for(int k=-1; k<nsets; k++)
+		{	//k of -1 is the old scalar loops
+			if(k >= 0)
+				g_pVectorOps = sets[k];
+			timer.Restart();
+			for(int r=0; r<FIR_BENCH_RUNS; r++)
+			{
+				for(int p=0; p<FIR_BENCH_PASSES; p++)
+				{
+					if(k < 0)
+						ref.ProcessFilter(FIR_BENCH_BLOCK, in, out);
+					else
+						fir.ProcessFilter(FIR_BENCH_BLOCK, in, out);
+					check += out[p%FIR_BENCH_BLOCK];
+				}
+				timer.EndRun();
+			}
+			sprintf(name, "fir %d taps float %s", Taps[t], (k < 0) ? "old" : sets[k]->Name);
+			timer.Print(name, (double)FIR_BENCH_BLOCK*FIR_BENCH_PASSES, "sample");
+			timer.Restart();
+			for(int r=0; r<FIR_BENCH_RUNS; r++)
+			{
+				for(int p=0; p<FIR_BENCH_PASSES; p++)
+				{
+					if(k < 0)
+						ref.ProcessFilter(FIR_BENCH_BLOCK, in16, out16);
+					else
+						fir.ProcessFilter(FIR_BENCH_BLOCK, in16, out16);
+					check += out16[p%FIR_BENCH_BLOCK];
+				}
+				timer.EndRun();
+			}
+			sprintf(name, "fir %d taps int16 %s", Taps[t], (k < 0) ? "old" : sets[k]->Name);
+			timer.Print(name, (double)FIR_BENCH_BLOCK*FIR_BENCH_PASSES, "sample");
+		}
+	}
+	g_pVectorOps = selected;
+	printf("  (check %.0f)\n", check);
+	return true;
+}
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////
+// tst_waterfall.cpp: frame time of the CPlotter waterfall update and
+// paint, the old scrolled per pixel drawPoint() waterfall against the
+// QImage scanline ring.
+//
+//  Both are drawn into QImages so no window system is needed.  On the
+// raster paint engine a QPixmap is a QImage and QPixmap::scroll() moves
+// the lines with a memmove each, which the old path does the same way.
+//
+// History:
+//	2026-10-17  Initial creation
+/////////////////////////////////////////////////////////////////////
+#include "testutil.h"
+#include <QImage>
+#include <QPainter>
+#include <QColor>
+#include <string.h>
+
+#define WF_WIDTH 1920			//wide screen plot
+#define WF_HEIGHT 540			//waterfall half of a 1080 line plot
+#define WF_BENCH_FRAMES 50
+#define WF_BENCH_RUNS 5
+
+/////////////////////////////////////////////////////////////////////
+// Each frame adds one random FFT line to the waterfall and paints the
+// waterfall into the screen image the way paintEvent() does.
+/////////////////////////////////////////////////////////////////////
+bool BenchWaterfall()
+{
+static quint32 fftbuf[WF_WIDTH];
+QColor colortbl[256];
+QRgb rgbtbl[256];
+QImage screen(WF_WIDTH, 2*WF_HEIGHT, QImage::Format_RGB32);
+QImage wf(WF_WIDTH, WF_HEIGHT, QImage::Format_RGB32);
+CTestRand rand;
+QRgb* pLine;
+int top;
+int i;
+int j;
+int r;
+	for(i=0; i<256; i++)
+	{
+		colortbl[i].setRgb(i, 255-i, i/2);
+		rgbtbl[i] = qRgb(i, 255-i, i/2);
+	}
+	for(i=0; i<WF_WIDTH; i++)
+		fftbuf[i] = (quint32)rand.Range(0, 255);
+	screen.fill(Qt::black);
+	wf.fill(Qt::black);
+	CBenchTimer timer;
+	for(r=0; r<WF_BENCH_RUNS; r++)
+	{
+		for(j=0; j<WF_BENCH_FRAMES; j++)
+		{
+			//scroll down one line as QPixmap::scroll() does
+			for(i=WF_HEIGHT-1; i>0; i--)
+				memmove(wf.scanLine(i), wf.constScanLine(i-1), wf.bytesPerLine());
+			QPainter painter1(&wf);
+			for(i=0; i<WF_WIDTH; i++)
+			{
+				painter1.setPen(colortbl[fftbuf[(i+j)%WF_WIDTH]]);
+				painter1.drawPoint(i, 0);
+			}
+			painter1.end();
+			QPainter painter(&screen);
+			painter.drawImage(QPoint(0, WF_HEIGHT), wf);
+		}
+		timer.EndRun();
+	}
+	timer.Print("scroll and drawPoint", WF_BENCH_FRAMES, "frame");
+	wf.fill(Qt::black);
+	top = 0;
+	timer.Restart();
+	for(r=0; r<WF_BENCH_RUNS; r++)
+	{
+		for(j=0; j<WF_BENCH_FRAMES; j++)
+		{
+			if(--top < 0)
+				top = WF_HEIGHT - 1;
+			pLine = (QRgb*)wf.scanLine(top);
+			for(i=0; i<WF_WIDTH; i++)
+				pLine[i] = rgbtbl[fftbuf[(i+j)%WF_WIDTH] & 0xFF];
+			QPainter painter(&screen);
+			painter.drawImage(QPoint(0, WF_HEIGHT), wf,
+							  QRect(0, top, WF_WIDTH, WF_HEIGHT - top));
+			if(top > 0)
+				painter.drawImage(QPoint(0, 2*WF_HEIGHT - top), wf,
+								  QRect(0, 0, WF_WIDTH, top));
+		}
+		timer.EndRun();
+	}
+	timer.Print("scanline ring", WF_BENCH_FRAMES, "frame");
+	printf("  %dx%d waterfall\n", WF_WIDTH, WF_HEIGHT);
+	return true;
+}